@@ -80,6 +80,14 @@ OPENSSL_PATH=$(brew --prefix openssl@3)
 export CPATH="$OPENSSL_PATH/include:$CPATH"
 export LIBRARY_PATH="$OPENSSL_PATH/lib"
 
+# Allocation counting hooks (replace global operator new/delete) are for benchmark builds only:
+# ALLOC_STATS=1 ./FULL_EXECUTE.sh
+ALLOC_HOOKS=""
+if [ "$ALLOC_STATS" = "1" ]; then
+    ALLOC_HOOKS="src/core/alloc_hooks.cpp"
+    echo "Allocation counting hooks enabled (benchmark build)." | tee -a $LOG_FILE
+fi
+
 # Compile the Flight Software
 g++ -g -O0 \
     -I src -I src/flight_dynamics \
@@ -91,13 +99,20 @@ g++ -g -O0 \
     -I src/ADCS \
     -I src/GNC \
     -I src/CDH \
+    -I src/simulation \
     -I "$JSONCPP_PATH/include" -I "$OPENSSL_PATH/include" \
     -L "$JSONCPP_PATH/lib" -ljsoncpp \
     -L "$OPENSSL_PATH/lib" -Wl,-rpath,"$OPENSSL_PATH/lib" -lssl -lcrypto \
     -o OpenSpaceFSW \
     src/core/main.cpp src/cdh/scheduler.cpp src/cdh/cdh.cpp src/flight_dynamics/flight_dynamics.cpp \
-    src/gnc/gnc.cpp src/adcs/adcs.cpp src/security/security.cpp src/telemetry/telemetry.cpp \
-    -std=c++17
+    src/gnc/gnc.cpp src/adcs/adcs.cpp src/security/security.cpp src/telemetry/telemetry.cpp src/telemetry/telemetry_schema.cpp \
+    src/CDH/command_uplink.cpp src/security/command_auth.cpp \
+    src/simulation/checkpoint.cpp src/simulation/branch_runner.cpp src/simulation/batch_runner.cpp src/simulation/sensor_suite.cpp \
+    src/simulation/sweep_aggregate.cpp src/simulation/sweep_coordinator.cpp src/simulation/ascent_optimizer.cpp \
+    src/GNC/orbital_mechanics.cpp src/GNC/landing_guidance.cpp src/flight_dynamics/wind_model.cpp src/flight_dynamics/reentry.cpp \
+    src/telemetry/downsampler.cpp src/telemetry/telemetry_server.cpp \
+    src/CDH/watchdog.cpp src/core/arena.cpp src/core/alloc_stats.cpp $ALLOC_HOOKS \
+    -std=c++17 -pthread
 
 
 # Handle compilation failure(s) - PLACEHOLDER, will build on this
@@ -0,0 +1,124 @@
+import argparse
+import fcntl
+import hashlib
+import hmac
+import os
+import socket
+import struct
+
+
+# Must match src/CDH/command.h
+OPCODES = {
+    "NOOP": 0,
+    "START_MISSION": 1,
+    "TERMINATE": 2,
+    "ABORT": 3,
+    "PHASE_OVERRIDE": 4,
+    "PARAMETER_UPDATE": 5,
+    "CHECKPOINT": 6,
+    "RESTORE": 7,
+}
+
+PARAMETERS = {
+    "thrust": 0,
+    "burn_rate": 1,
+    "isp": 2,
+    "drag_area": 3,
+}
+
+ARGS_SIZE = 40
+DEFAULT_SOCKET = "/tmp/openspace_uplink.sock"
+DEFAULT_COUNTER = os.path.expanduser("~/.openspace_uplink_sequence")
+SEQUENCE_MAX = 0xFFFFFFFF
+
+
+
+def build_packet(key: bytes, opcode: int, sequence: int, args: bytes = b""):
+    """
+    Build one 80-byte command packet: header + args + HMAC-SHA256 over the first 48 bytes.
+    """
+    if len(args) > ARGS_SIZE:
+        raise ValueError(f"Arguments exceed {ARGS_SIZE} bytes")
+
+    body = struct.pack("<HHI", opcode, len(args), sequence) + args.ljust(ARGS_SIZE, b"\0")
+    return body + hmac.new(key, body, hashlib.sha256).digest()
+
+
+
+def next_sequence(path: str, requested=None):
+    """
+    Reserve the next command sequence from the persisted counter at `path`.
+
+    The vehicle accepts only sequences above the last one it accepted, and keeps that window across
+    restarts, so the sender counts up from its own last sequence instead of deriving one from the clock
+    (a clock stepped back, or 32-bit milliseconds wrapping every ~49.7 days, would lock it out for good).
+    The new value is written through before the packet leaves, so a crash can skip a number but never
+    reuse one. `requested` (--sequence) resynchronizes: it must be above the vehicle's last accepted
+    sequence (the decimal number in its uplink_sequence.dat), and counting continues from it.
+    """
+    with open(path, "a+") as file:
+        fcntl.flock(file, fcntl.LOCK_EX)   # concurrent senders never reserve the same number
+        file.seek(0)
+        text = file.read().strip()
+        last = int(text) if text else 0
+
+        sequence = requested if requested is not None else last + 1
+        if not 0 < sequence <= SEQUENCE_MAX:
+            raise ValueError(f"Sequence {sequence} is outside 1..{SEQUENCE_MAX}; rotate the uplink key and "
+                             f"reset both this counter and the vehicle's uplink_sequence.dat")
+
+        file.seek(0)
+        file.truncate()
+        file.write(f"{max(sequence, last)}\n")
+        file.flush()
+        os.fsync(file.fileno())
+    return sequence
+
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Send an authenticated command to OpenSpaceFSW.")
+    parser.add_argument("command", choices=OPCODES.keys())
+    parser.add_argument("--phase", type=int, help="MissionPhase index for PHASE_OVERRIDE")
+    parser.add_argument("--param", choices=PARAMETERS.keys(), help="Parameter for PARAMETER_UPDATE")
+    parser.add_argument("--value", type=float, help="New value for PARAMETER_UPDATE")
+    parser.add_argument("--socket", default=DEFAULT_SOCKET, help="Uplink socket path")
+    parser.add_argument("--file", help="Append the packet to a file instead of sending it")
+    parser.add_argument("--sequence", type=int,
+                        help="Resynchronize: use this sequence (above the vehicle's last accepted) and count on from it")
+    parser.add_argument("--counter", default=os.environ.get("OPENSPACE_UPLINK_COUNTER", DEFAULT_COUNTER),
+                        help="Persisted sequence counter file (default $OPENSPACE_UPLINK_COUNTER or ~/.openspace_uplink_sequence)")
+    options = parser.parse_args()
+
+    key_hex = os.environ.get("OPENSPACE_UPLINK_KEY")
+    if not key_hex:
+        print("ERROR: OPENSPACE_UPLINK_KEY is not set.")
+        return 1
+
+    args = b""
+    if options.command == "PHASE_OVERRIDE":
+        args = struct.pack("<B", options.phase)
+    elif options.command == "PARAMETER_UPDATE":
+        args = struct.pack("<Hd", PARAMETERS[options.param], options.value)
+
+    try:
+        sequence = next_sequence(options.counter, options.sequence)
+    except ValueError as error:
+        print(f"ERROR: {error}")
+        return 1
+    packet = build_packet(bytes.fromhex(key_hex), OPCODES[options.command], sequence, args)
+
+    if options.file:
+        with open(options.file, "ab") as file:
+            file.write(packet)
+    else:
+        with socket.socket(socket.AF_UNIX, socket.SOCK_DGRAM) as sock:
+            sock.sendto(packet, options.socket)
+
+    print(f"Sent {options.command} (seq {sequence})")
+    return 0
+
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
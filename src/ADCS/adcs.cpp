@@ -24,8 +24,53 @@ void ADCS::initialize() {
     std::cout << "ADCS Initialized (Quaternion Mode)" << std::endl;
 }
 
-void ADCS::update() {
-    NULL; // Placeholder
+/**
+ * Strapdown propagation of the attitude from the gyro stream (small-angle, per sample).
+ * The truth vehicle does not rotate, so the attitude here is pure sensor drift - bias plus random walk.
+ */
+void ADCS::update(ImuStream& imu) {
+    ImuSample sample;
+    double sum[3] = {0.0, 0.0, 0.0};
+    uint64_t count = 0;
+
+    while (imu.pop(sample)) {
+        if (lastSampleTime >= 0.0) {
+            double dt = sample.time - lastSampleTime;
+            for (int a = 0; a < 3; ++a) attitude[a] += sample.gyro[a] * dt;
+        }
+        lastSampleTime = sample.time;
+
+        for (int a = 0; a < 3; ++a) sum[a] += sample.accel[a];
+        count++;
+    }
+
+    if (count) {
+        for (int a = 0; a < 3; ++a) specificForce[a] = sum[a] / count;
+    }
+    samplesConsumed += count;
+    lastBatch = count;
+}
+
+ADCS::Snapshot ADCS::snapshot() const {
+    Snapshot snapshot;
+    for (int a = 0; a < 3; ++a) {
+        snapshot.attitude[a] = attitude[a];
+        snapshot.specificForce[a] = specificForce[a];
+    }
+    snapshot.lastSampleTime = lastSampleTime;
+    snapshot.samplesConsumed = samplesConsumed;
+    snapshot.lastBatch = lastBatch;
+    return snapshot;
+}
+
+void ADCS::restore(const Snapshot& snapshot) {
+    for (int a = 0; a < 3; ++a) {
+        attitude[a] = snapshot.attitude[a];
+        specificForce[a] = snapshot.specificForce[a];
+    }
+    lastSampleTime = snapshot.lastSampleTime;
+    samplesConsumed = snapshot.samplesConsumed;
+    lastBatch = snapshot.lastBatch;
 }
 
 void ADCS::adjustOrientation(double roll, double pitch, double yaw) {
@@ -1,11 +1,41 @@
 #ifndef ADCS_H
 #define ADCS_H
 
+#include "sensor_data.h"
+#include <array>
+#include <cstdint>
+
 class ADCS {
+private:
+    double attitude[3] = {0.0, 0.0, 0.0};     // roll / pitch / yaw from integrated gyro rates (rad)
+    double specificForce[3] = {0.0, 0.0, 0.0}; // mean accelerometer reading over the last update (m/s²)
+    double lastSampleTime = -1.0;
+    uint64_t samplesConsumed = 0;
+    uint64_t lastBatch = 0;
+
 public:
+    // Everything update() carries between cycles (checkpoints)
+    struct Snapshot {
+        std::array<double, 3> attitude{};
+        std::array<double, 3> specificForce{};
+        double lastSampleTime = -1.0;
+        uint64_t samplesConsumed = 0;
+        uint64_t lastBatch = 0;
+    };
+
     void initialize();
-    void update();
+
+    // Drains every IMU sample published since the last call (1 kHz stream, called once per cycle)
+    void update(ImuStream& imu);
     void adjustOrientation(double roll, double pitch, double yaw);
+
+    Snapshot snapshot() const;
+    void restore(const Snapshot& snapshot);
+
+    const double* getAttitude() const { return attitude; }
+    const double* getSpecificForce() const { return specificForce; }
+    uint64_t getSamplesConsumed() const { return samplesConsumed; }
+    uint64_t getLastBatchSize() const { return lastBatch; }
 };
 
 #endif
@@ -2,6 +2,10 @@
 #include "scheduler.h"
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
 
 
 /**
@@ -20,21 +24,227 @@ CDH::CDH(Scheduler* sched) : scheduler(sched) {
 /**
 ==========================================
     Execute Mission Commands
-    ==========================================
-    */
-   void CDH::executeCommand(const std::string& command) {
-       
-       if (command == "START_MISSION") {
-           std::cout << "[CDH] Initializing Flight Software...\n";
-           scheduler->run();  
-           
-        } else if (command == "TERMINATE") {
-        std::cout << "[CDH] Terminating Mission...\n";
-        scheduler->stop();
-        
-    } else {
+==========================================
+
+String commands (console / main) are mapped onto the same opcodes the binary uplink uses,
+so both paths run through the dispatch table.
+*/
+void CDH::executeCommand(const std::string& command) {
+    static const std::unordered_map<std::string, CommandOpcode> names = {
+        {"START_MISSION", CommandOpcode::START_MISSION},
+        {"TERMINATE",     CommandOpcode::TERMINATE},
+        {"ABORT",         CommandOpcode::ABORT},
+    };
+
+    auto it = names.find(command);
+    if (it == names.end()) {
         std::cerr << "[CDH ERROR] Unknown command: " << command << "\n";
+        return;
     }
+
+    CommandPacket packet;
+    packet.opcode = static_cast<uint16_t>(it->second);
+    dispatch(packet);
+}
+
+
+
+/**
+==========================================
+    Run The Mission Loop
+==========================================
+
+Called by main after the boot commands. Blocks in Scheduler::run() until TERMINATE / SIGINT stops it.
+*/
+void CDH::runMission() {
+    if (!missionArmed) {
+        std::cerr << "[CDH WARNING] Mission not started - START_MISSION has not been accepted.\n";
+        return;
+    }
+
+    missionArmed = false;
+    missionRunning = true;
+    scheduler->run();
+    missionRunning = false;
+}
+
+
+
+/**
+==========================================
+    Command Dispatch Table (indexed by CommandOpcode)
+==========================================
+*/
+const std::array<CDH::CommandHandler, static_cast<std::size_t>(CommandOpcode::COUNT)> CDH::dispatchTable = {
+    &CDH::handleNoop,             // NOOP
+    &CDH::handleStartMission,     // START_MISSION
+    &CDH::handleTerminate,        // TERMINATE
+    &CDH::handleAbort,            // ABORT
+    &CDH::handlePhaseOverride,    // PHASE_OVERRIDE
+    &CDH::handleParameterUpdate,  // PARAMETER_UPDATE
+    &CDH::handleCheckpoint,       // CHECKPOINT
+    &CDH::handleRestore,          // RESTORE
+};
+
+
+bool CDH::dispatch(const CommandPacket& packet) {
+    if (packet.opcode >= dispatchTable.size()) {
+        std::cerr << "[CDH ERROR] Unknown opcode: " << packet.opcode << "\n";
+        return false;
+    }
+    return (this->*dispatchTable[packet.opcode])(packet);
+}
+
+
+
+/**
+==========================================
+    Drain Uplinked Commands (once per cycle)
+==========================================
+
+Called by the Scheduler after the mission phase update, so commands always act on a
+consistent state and never interrupt the physics step.
+*/
+void CDH::dispatchCommands() {
+    QueuedCommand command;
+
+    while (uplink.poll(command)) {
+        if (!dispatch(command.packet)) {
+            commandsRejected++;
+            continue;
+        }
+
+        int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        int64_t latencyNs = nowNs - command.receivedNs;
+
+        commandsExecuted++;
+        latencyTotalNs += latencyNs;
+        latencyMaxNs = std::max(latencyMaxNs, latencyNs);
+
+        std::cout << "[CDH] Command " << command.packet.opcode << " (seq " << command.packet.sequence
+                  << ") executed, latency " << latencyNs / 1000 << " us\n";
+    }
+}
+
+
+
+bool CDH::startUplink(CommandUplink::Source source, const std::string& location) {
+    return uplink.start(source, location);
+}
+
+
+
+void CDH::reportCommandStats() const {
+    double avgUs = commandsExecuted ? (latencyTotalNs / 1000.0) / commandsExecuted : 0.0;
+
+    std::cout << "[CDH] Commands executed: " << commandsExecuted
+              << " | Rejected: " << commandsRejected + uplink.getRejectedCount()
+              << " | Latency avg: " << avgUs << " us, max: " << latencyMaxNs / 1000.0 << " us\n";
+}
+
+
+
+// ==========================================
+// Command Handlers - return false to count the command as rejected
+// ==========================================
+bool CDH::handleNoop(const CommandPacket&) {
+    return true;
+}
+
+
+bool CDH::handleStartMission(const CommandPacket&) {
+    if (missionArmed || missionRunning) {
+        std::cerr << "[CDH WARNING] START_MISSION ignored, mission already running.\n";
+        return false;
+    }
+
+    // Only arms the mission: the loop is started by runMission(), outside the dispatch path, so
+    // commands drained inside the loop are never dispatched re-entrantly from this handler
+    std::cout << "[CDH] Initializing Flight Software...\n";
+    missionArmed = true;
+    return true;
+}
+
+
+bool CDH::handleTerminate(const CommandPacket&) {
+    std::cout << "[CDH] Terminating Mission...\n";
+    scheduler->stop();
+    return true;
+}
+
+
+bool CDH::handleAbort(const CommandPacket&) {
+    std::cout << "[CDH] ABORT received - cutting engines and safing the vehicle.\n";
+    scheduler->getDynamics().setThrust(0.0);
+    scheduler->getDynamics().setBurnRate(0.0);
+    scheduler->getFlight().cutEngine();   // the ascent schedule must not relight it next cycle
+    updatePhase(MissionPhase::RECOVERY);
+    return true;
+}
+
+
+bool CDH::handlePhaseOverride(const CommandPacket& packet) {
+    if (packet.argLength < 1 || packet.args[0] > static_cast<uint8_t>(MissionPhase::POST_FLIGHT)) {
+        std::cerr << "[CDH ERROR] PHASE_OVERRIDE with invalid phase.\n";
+        return false;
+    }
+
+    std::cout << "[CDH] Phase override commanded.\n";
+    updatePhase(static_cast<MissionPhase>(packet.args[0]));
+    return true;
+}
+
+
+bool CDH::handleParameterUpdate(const CommandPacket& packet) {
+    if (packet.argLength < 2 + sizeof(double)) {
+        std::cerr << "[CDH ERROR] PARAMETER_UPDATE missing arguments.\n";
+        return false;
+    }
+
+    uint16_t id;
+    double value;
+    std::memcpy(&id, packet.args, 2);
+    std::memcpy(&value, packet.args + 2, sizeof(double));
+
+    if (!std::isfinite(value) || value < 0.0) {
+        std::cerr << "[CDH ERROR] PARAMETER_UPDATE value out of range.\n";
+        return false;
+    }
+
+    FlightDynamics& dynamics = scheduler->getDynamics();
+    switch (static_cast<CommandParameter>(id)) {
+        case CommandParameter::THRUST:    dynamics.setThrust(value);   break;
+        case CommandParameter::BURN_RATE: dynamics.setBurnRate(value); break;
+        case CommandParameter::ISP:       dynamics.setIsp(value);      break;
+        case CommandParameter::DRAG_AREA: dynamics.setDragArea(value); break;
+        default:
+            std::cerr << "[CDH ERROR] PARAMETER_UPDATE unknown parameter " << id << "\n";
+            return false;
+    }
+
+    std::cout << "[CDH] Parameter " << id << " updated to " << value << "\n";
+    return true;
+}
+
+
+bool CDH::handleCheckpoint(const CommandPacket&) {
+    if (!scheduler->captureCheckpoint().saveToFile(CHECKPOINT_FILE)) {
+        return false;
+    }
+    std::cout << "[CDH] Checkpoint saved to " << CHECKPOINT_FILE << "\n";
+    return true;
+}
+
+
+bool CDH::handleRestore(const CommandPacket&) {
+    SimulationCheckpoint checkpoint;
+    if (!checkpoint.loadFromFile(CHECKPOINT_FILE)) {
+        return false;
+    }
+    scheduler->restoreCheckpoint(checkpoint);
+    std::cout << "[CDH] State restored from " << CHECKPOINT_FILE << "\n";
+    return true;
 }
 
 /**
@@ -50,7 +260,6 @@ void CDH::processTelemetry(TelemetryData& data) {
         exit(1);
     }
     else {
-        std::cout << "[CDH] Scheduler instance is valid, proceeding...";
         updateMissionPhase(data);
     }
 
@@ -72,60 +281,120 @@ void CDH::processTelemetry(TelemetryData& data) {
 ==========================================
 */
 void CDH::updateMissionPhase(TelemetryData& data) {
-    
-    switch (telemetry.getPhase()) {
+    MissionPhase current = telemetry.getPhase();
+
+    if (current == MissionPhase::POST_FLIGHT) {
+        shutdown();
+        return;
+    }
+
+    MissionPhase next = evaluatePhase(current, data);
+    if (next != current) {
+        updatePhase(next);
+    }
+}
+
+
+/**
+==========================================
+    Mission Phase Transition Rules
+==========================================
+
+Kept free of side effects so the same rules drive the flight loop and the
+headless branch / batch simulations.
+*/
+MissionPhase CDH::evaluatePhase(MissionPhase current, const TelemetryData& data) {
+
+    switch (current) {
         case MissionPhase::PRE_LAUNCH:
-            if (data.altitude > 0.1) updatePhase(MissionPhase::LIFTOFF);
+            if (data.altitude > LIFTOFF_ALTITUDE) return MissionPhase::LIFTOFF;
             break;
 
         case MissionPhase::LIFTOFF:
-            if (data.velocity > 400.0) updatePhase(MissionPhase::MAX_Q);
+            if (data.velocity > MAX_Q_VELOCITY) return MissionPhase::MAX_Q;
             break;
 
         case MissionPhase::MAX_Q:
-            if (data.fuel < 800.0) updatePhase(MissionPhase::STAGE_SEPARATION);
+            if (data.fuel < STAGE_SEPARATION_FUEL) return MissionPhase::STAGE_SEPARATION;
             break;
 
         case MissionPhase::STAGE_SEPARATION:
-            updatePhase(MissionPhase::UPPER_STAGE_BURN);
-            break;
+            return MissionPhase::UPPER_STAGE_BURN;
 
         case MissionPhase::UPPER_STAGE_BURN:
-            if (data.velocity >= 7800.0) updatePhase(MissionPhase::ORBIT_INSERTION);
+            if (data.velocity >= ORBIT_VELOCITY) return MissionPhase::ORBIT_INSERTION;
             break;
 
         case MissionPhase::ORBIT_INSERTION:
-            if (data.altitude >= 400.0 && data.velocity >= 7800.0) updatePhase(MissionPhase::MISSION_OPS);
+            if (data.altitude >= ORBIT_ALTITUDE && data.velocity >= ORBIT_VELOCITY) return MissionPhase::MISSION_OPS;
             break;
 
         case MissionPhase::MISSION_OPS:
-            if (data.fuel < 500.0) updatePhase(MissionPhase::ORBITAL_ADJUSTMENTS);
+            if (data.fuel < ORBITAL_ADJUSTMENT_FUEL) return MissionPhase::ORBITAL_ADJUSTMENTS;
             break;
 
         case MissionPhase::ORBITAL_ADJUSTMENTS:
-            if (data.fuel < 300.0) updatePhase(MissionPhase::DEORBIT);
+            if (data.fuel < DEORBIT_FUEL) return MissionPhase::DEORBIT;
             break;
 
         case MissionPhase::DEORBIT:
-            if (data.altitude < 100.0) updatePhase(MissionPhase::REENTRY);
+            if (data.altitude < REENTRY_ALTITUDE) return MissionPhase::REENTRY;
             break;
 
         case MissionPhase::REENTRY:
-            if (data.altitude <= 0.0) updatePhase(MissionPhase::RECOVERY);
+            if (data.altitude <= RECOVERY_ALTITUDE) return MissionPhase::RECOVERY;
             break;
 
         case MissionPhase::RECOVERY:
-            if (data.velocity < 1.0 && data.fuel < 50.0) updatePhase(MissionPhase::POST_FLIGHT);
+            if (data.velocity < POST_FLIGHT_VELOCITY && data.fuel < POST_FLIGHT_FUEL) return MissionPhase::POST_FLIGHT;
             break;
 
         case MissionPhase::POST_FLIGHT:
-            shutdown();
             break;
 
         default:
             std::cerr << "[CDH ERROR] Invalid mission phase detected!\n";
             break;
     }
+
+    return current;
+}
+
+
+/**
+==========================================
+    Phase Threshold Events
+==========================================
+
+Registers one event function per threshold used in evaluatePhase(), so the dynamics stepper
+lands on each threshold exactly instead of overshooting by up to a full cycle. Each is checked only
+in the phase(s) whose rule reads it (the loop passes its phase to FlightDynamics::setActivePhase).
+*/
+void CDH::registerPhaseEvents(FlightDynamics& dynamics) {
+    using S = FlightDynamics::State;
+    auto in = [](MissionPhase phase) { return 1u << static_cast<int>(phase); };
+
+    dynamics.addEvent("Liftoff Altitude",        [](const S& s) { return s.altitude - LIFTOFF_ALTITUDE; }, +1, false,
+                      in(MissionPhase::PRE_LAUNCH));
+    dynamics.addEvent("Max Q Velocity",          [](const S& s) { return s.velocity - MAX_Q_VELOCITY; }, +1, false,
+                      in(MissionPhase::LIFTOFF));
+    dynamics.addEvent("Stage Separation Fuel",   [](const S& s) { return s.fuel - STAGE_SEPARATION_FUEL; }, -1, false,
+                      in(MissionPhase::MAX_Q));
+    dynamics.addEvent("Orbit Velocity",          [](const S& s) { return s.velocity - ORBIT_VELOCITY; }, +1, false,
+                      in(MissionPhase::UPPER_STAGE_BURN) | in(MissionPhase::ORBIT_INSERTION));
+    dynamics.addEvent("Orbit Altitude",          [](const S& s) { return s.altitude - ORBIT_ALTITUDE; }, +1, false,
+                      in(MissionPhase::ORBIT_INSERTION));
+    dynamics.addEvent("Orbital Adjustment Fuel", [](const S& s) { return s.fuel - ORBITAL_ADJUSTMENT_FUEL; }, -1, false,
+                      in(MissionPhase::MISSION_OPS));
+    dynamics.addEvent("Deorbit Fuel",            [](const S& s) { return s.fuel - DEORBIT_FUEL; }, -1, false,
+                      in(MissionPhase::ORBITAL_ADJUSTMENTS));
+    dynamics.addEvent("Reentry Altitude",        [](const S& s) { return s.altitude - REENTRY_ALTITUDE; }, -1, false,
+                      in(MissionPhase::DEORBIT));
+    dynamics.addEvent("Post-Flight Velocity",    [](const S& s) { return s.velocity - POST_FLIGHT_VELOCITY; }, -1, false,
+                      in(MissionPhase::RECOVERY));
+    dynamics.addEvent("Post-Flight Fuel",        [](const S& s) { return s.fuel - POST_FLIGHT_FUEL; }, -1, false,
+                      in(MissionPhase::RECOVERY));
+    // RECOVERY_ALTITUDE (0 m) is the vehicle's Touchdown event, checked in every phase
 }
 
 
@@ -148,6 +417,7 @@ void CDH::updatePhase(MissionPhase newPhase) {
 */
 void CDH::shutdown() {
     std::cout << "[CDH] Shutting down system safely...\n";
+    uplink.stop();
     
     if (scheduler) {
         scheduler->stop();
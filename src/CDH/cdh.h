@@ -3,8 +3,13 @@
 
 #include <iostream>
 #include <unordered_map>
+#include <array>
+#include <cstdint>
 #include "telemetry/telemetry.h"
+#include "flight_dynamics.h"
 #include "mission_phase.h"
+#include "command.h"
+#include "command_uplink.h"
 
 
 
@@ -23,10 +28,48 @@ class Scheduler;
 - Handles mission phase transitions based on telemetry data.
 */
 class CDH {
+public:
+    // Phase transition thresholds - shared by evaluatePhase() and the dynamics event functions
+    static constexpr double LIFTOFF_ALTITUDE = 0.1;              // m
+    static constexpr double MAX_Q_VELOCITY = 400.0;              // m/s
+    static constexpr double STAGE_SEPARATION_FUEL = 800.0;       // kg
+    static constexpr double ORBIT_VELOCITY = 7800.0;             // m/s
+    static constexpr double ORBIT_ALTITUDE = 400.0;              // m
+    static constexpr double ORBITAL_ADJUSTMENT_FUEL = 500.0;     // kg
+    static constexpr double DEORBIT_FUEL = 300.0;                // kg
+    static constexpr double REENTRY_ALTITUDE = 100.0;            // m
+    static constexpr double RECOVERY_ALTITUDE = 0.0;             // m
+    static constexpr double POST_FLIGHT_VELOCITY = 1.0;          // m/s
+    static constexpr double POST_FLIGHT_FUEL = 50.0;             // kg
+
 private:
     Scheduler* scheduler;  // Pointer to Scheduler to prevent circular dependency
     Telemetry telemetry;
 
+    // Command handling - the opcode indexes straight into the dispatch table (no string compares)
+    using CommandHandler = bool (CDH::*)(const CommandPacket&);
+    static const std::array<CommandHandler, static_cast<std::size_t>(CommandOpcode::COUNT)> dispatchTable;
+
+    CommandUplink uplink;
+    bool missionArmed = false;     // START_MISSION accepted, runMission() has not started the loop yet
+    bool missionRunning = false;
+
+    // Command statistics (flight thread only)
+    uint64_t commandsExecuted = 0;
+    uint64_t commandsRejected = 0;   // rejected at dispatch; the uplink counts auth/queue rejections
+    int64_t latencyTotalNs = 0;
+    int64_t latencyMaxNs = 0;
+
+    bool dispatch(const CommandPacket& packet);
+    bool handleNoop(const CommandPacket& packet);
+    bool handleStartMission(const CommandPacket& packet);
+    bool handleTerminate(const CommandPacket& packet);
+    bool handleAbort(const CommandPacket& packet);
+    bool handlePhaseOverride(const CommandPacket& packet);
+    bool handleParameterUpdate(const CommandPacket& packet);
+    bool handleCheckpoint(const CommandPacket& packet);
+    bool handleRestore(const CommandPacket& packet);
+
 public:
     
     // for initialization
@@ -39,8 +82,14 @@ public:
 
     // Core mission execution functions
     void executeCommand(const std::string& command);
+    void runMission();           // Runs the Scheduler loop once START_MISSION has been accepted; returns when it stops
+    bool startUplink(CommandUplink::Source source, const std::string& location);
+    void dispatchCommands();     // Drains the uplink queue - called once per Scheduler cycle
+    void reportCommandStats() const;
     void processTelemetry(TelemetryData& data);
     void updateMissionPhase(TelemetryData& data);
+    static MissionPhase evaluatePhase(MissionPhase current, const TelemetryData& data);  // Pure transition rule, no side effects
+    static void registerPhaseEvents(FlightDynamics& dynamics);  // Lets the stepper stop exactly on each threshold
     void updatePhase(MissionPhase newPhase);
     void shutdown();
 
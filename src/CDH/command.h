@@ -0,0 +1,101 @@
+#ifndef COMMAND_H
+#define COMMAND_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+
+
+/**
+==========================================
+    Uplink Command Opcodes
+==========================================
+
+- The opcode value doubles as the index into CDH's dispatch table, so keep them dense.
+- COUNT must stay last.
+*/
+enum class CommandOpcode : uint16_t {
+    NOOP = 0,
+    START_MISSION,
+    TERMINATE,
+    ABORT,
+    PHASE_OVERRIDE,     // args: uint8 MissionPhase index
+    PARAMETER_UPDATE,   // args: uint16 CommandParameter id, double value
+    CHECKPOINT,         // saves the simulation state to CHECKPOINT_FILE
+    RESTORE,            // reloads the simulation state from CHECKPOINT_FILE
+    COUNT
+};
+
+
+// Snapshot location used by the CHECKPOINT / RESTORE commands
+constexpr const char* CHECKPOINT_FILE = "checkpoint.bin";
+
+// Last accepted uplink sequence number, kept across restarts for replay protection
+constexpr const char* UPLINK_SEQUENCE_FILE = "uplink_sequence.dat";
+
+
+// Flight parameters that PARAMETER_UPDATE is allowed to change
+enum class CommandParameter : uint16_t {
+    THRUST = 0,
+    BURN_RATE,
+    ISP,
+    DRAG_AREA,
+    COUNT
+};
+
+
+
+/**
+==========================================
+    Binary Command Packet (fixed 80 bytes on the wire)
+==========================================
+
+    offset  size  field
+    0       2     opcode      (little-endian)
+    2       2     argLength   (bytes of args actually used)
+    4       4     sequence    (must increase monotonically across restarts, replay protection)
+    8       40    args        (opcode specific, little-endian)
+    48      32    hmac        (HMAC-SHA256 over bytes [0, 48))
+*/
+constexpr std::size_t COMMAND_ARGS_SIZE = 40;
+constexpr std::size_t COMMAND_HMAC_SIZE = 32;
+constexpr std::size_t COMMAND_AUTH_SIZE = 8 + COMMAND_ARGS_SIZE;                // bytes covered by the HMAC
+constexpr std::size_t COMMAND_PACKET_SIZE = COMMAND_AUTH_SIZE + COMMAND_HMAC_SIZE;
+
+
+struct CommandPacket {
+    uint16_t opcode = 0;
+    uint16_t argLength = 0;
+    uint32_t sequence = 0;
+    uint8_t args[COMMAND_ARGS_SIZE] = {};
+    uint8_t hmac[COMMAND_HMAC_SIZE] = {};
+
+    // Wire (de)serialization - the flight targets are little-endian, so a straight copy is used per field
+    void serialize(uint8_t out[COMMAND_PACKET_SIZE]) const {
+        std::memcpy(out + 0, &opcode, 2);
+        std::memcpy(out + 2, &argLength, 2);
+        std::memcpy(out + 4, &sequence, 4);
+        std::memcpy(out + 8, args, COMMAND_ARGS_SIZE);
+        std::memcpy(out + COMMAND_AUTH_SIZE, hmac, COMMAND_HMAC_SIZE);
+    }
+
+    static CommandPacket deserialize(const uint8_t in[COMMAND_PACKET_SIZE]) {
+        CommandPacket packet;
+        std::memcpy(&packet.opcode, in + 0, 2);
+        std::memcpy(&packet.argLength, in + 2, 2);
+        std::memcpy(&packet.sequence, in + 4, 4);
+        std::memcpy(packet.args, in + 8, COMMAND_ARGS_SIZE);
+        std::memcpy(packet.hmac, in + COMMAND_AUTH_SIZE, COMMAND_HMAC_SIZE);
+        return packet;
+    }
+};
+
+
+// A packet that passed authentication, stamped with its arrival time for latency reporting
+struct QueuedCommand {
+    CommandPacket packet;
+    int64_t receivedNs = 0;  // steady_clock timestamp when the uplink accepted it
+};
+
+#endif
@@ -0,0 +1,161 @@
+#include "command_uplink.h"
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+
+
+CommandUplink::~CommandUplink() {
+    stop();
+}
+
+
+
+/**
+==========================================
+    Open The Uplink Source & Start The Reader Thread
+==========================================
+*/
+bool CommandUplink::start(Source src, const std::string& location) {
+    if (running) return true;
+
+    if (!authenticator.isReady() && !authenticator.initializeFromEnvironment()) {
+        return false;
+    }
+    if (!authenticator.persistSequence(UPLINK_SEQUENCE_FILE)) {
+        std::cerr << "[UPLINK ERROR] Replay window unavailable - uplink disabled.\n";
+        return false;
+    }
+
+    source = src;
+    path = location;
+
+    if (source == Source::SOCKET) {
+        fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+        if (fd < 0) {
+            std::cerr << "[UPLINK ERROR] Could not create socket.\n";
+            return false;
+        }
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(addr.sun_path)) {
+            std::cerr << "[UPLINK ERROR] Socket path too long: " << path << "\n";
+            close(fd);
+            fd = -1;
+            return false;
+        }
+        std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+        unlink(path.c_str());  // stale socket from a previous run
+
+        if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            std::cerr << "[UPLINK ERROR] Could not bind socket at " << path << "\n";
+            close(fd);
+            fd = -1;
+            return false;
+        }
+    } else {
+        fd = open(path.c_str(), O_RDONLY | O_NONBLOCK);
+        if (fd < 0) {
+            std::cerr << "[UPLINK ERROR] Could not open command file " << path << "\n";
+            return false;
+        }
+    }
+
+    running = true;
+    reader = std::thread(&CommandUplink::readerLoop, this);
+    std::cout << "[UPLINK] Listening for commands on " << path << "\n";
+    return true;
+}
+
+
+
+void CommandUplink::stop() {
+    if (!running.exchange(false)) return;
+
+    if (reader.joinable()) {
+        reader.join();
+    }
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+    if (source == Source::SOCKET) {
+        unlink(path.c_str());
+    }
+}
+
+
+
+/**
+==========================================
+    Reader Thread
+==========================================
+
+Uses poll() with a short timeout so stop() never waits longer than one timeout period.
+Files are read packet by packet; a datagram carries exactly one packet.
+*/
+void CommandUplink::readerLoop() {
+    uint8_t buffer[COMMAND_PACKET_SIZE * 4];
+    std::size_t buffered = 0;
+
+    while (running) {
+        pollfd pfd{fd, POLLIN, 0};
+        int ready = ::poll(&pfd, 1, 50);
+        if (ready <= 0) continue;
+
+        if (source == Source::SOCKET) {
+            ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+            if (n > 0) handlePacket(buffer, static_cast<std::size_t>(n));
+            continue;
+        }
+
+        ssize_t n = read(fd, buffer + buffered, sizeof(buffer) - buffered);
+        if (n <= 0) {
+            // End of a regular file: nothing more will arrive, avoid spinning on POLLIN
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            continue;
+        }
+        buffered += static_cast<std::size_t>(n);
+
+        std::size_t offset = 0;
+        while (buffered - offset >= COMMAND_PACKET_SIZE) {
+            handlePacket(buffer + offset, COMMAND_PACKET_SIZE);
+            offset += COMMAND_PACKET_SIZE;
+        }
+        std::memmove(buffer, buffer + offset, buffered - offset);
+        buffered -= offset;
+    }
+}
+
+
+
+void CommandUplink::handlePacket(const uint8_t* bytes, std::size_t length) {
+    received.fetch_add(1, std::memory_order_relaxed);
+
+    if (length != COMMAND_PACKET_SIZE) {
+        reject();
+        return;
+    }
+
+    QueuedCommand command;
+    command.packet = CommandPacket::deserialize(bytes);
+
+    if (command.packet.argLength > COMMAND_ARGS_SIZE ||
+        !authenticator.verify(bytes, COMMAND_AUTH_SIZE, command.packet.hmac, command.packet.sequence)) {
+        reject();
+        return;
+    }
+
+    command.receivedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    if (!queue.push(command)) {
+        reject();  // flight loop is not draining fast enough, drop rather than block
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef COMMAND_UPLINK_H
+#define COMMAND_UPLINK_H
+
+#include "command.h"
+#include "spsc_queue.h"
+#include "command_auth.h"
+#include <atomic>
+#include <string>
+#include <thread>
+
+
+/**
+==========================================
+    Command Uplink Receiver
+==========================================
+
+- Reads fixed-size binary command packets from a local Unix datagram socket or from a file (recorded uplink / FIFO).
+- Authenticates each packet on the reader thread and queues the accepted ones for CDH.
+- CDH drains the queue at a fixed point in every Scheduler cycle, so the flight thread never blocks on I/O.
+*/
+class CommandUplink {
+public:
+    static constexpr std::size_t QUEUE_CAPACITY = 64;
+    using Queue = SpscQueue<QueuedCommand, QUEUE_CAPACITY>;
+
+    enum class Source { SOCKET, FILE };
+
+private:
+    Queue queue;
+    CommandAuthenticator authenticator;
+    std::thread reader;
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> rejected{0};   // failed authentication, malformed or queue overflow
+    std::atomic<uint64_t> received{0};
+
+    Source source = Source::SOCKET;
+    std::string path;
+    int fd = -1;
+
+    void readerLoop();
+    void handlePacket(const uint8_t* bytes, std::size_t length);
+
+public:
+    CommandUplink() = default;
+    ~CommandUplink();
+    CommandUplink(const CommandUplink&) = delete;
+    CommandUplink& operator=(const CommandUplink&) = delete;
+
+    /**
+     * @brief Opens the source and starts the reader thread
+     * @param src SOCKET binds a datagram socket at `location`, FILE reads packets from `location`
+     * @param location Socket path or file path
+     * @return false if the key or the source is unavailable
+     */
+    bool start(Source src, const std::string& location);
+    void stop();
+
+    // Consumer side (flight thread)
+    bool poll(QueuedCommand& command) { return queue.pop(command); }
+
+    // Counted here and by CDH (e.g. invalid arguments at dispatch)
+    void reject() { rejected.fetch_add(1, std::memory_order_relaxed); }
+    uint64_t getRejectedCount() const { return rejected.load(std::memory_order_relaxed); }
+    uint64_t getReceivedCount() const { return received.load(std::memory_order_relaxed); }
+};
+
+#endif
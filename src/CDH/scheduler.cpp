@@ -3,19 +3,48 @@
 #include "flight_dynamics.h"
 #include "mission_phase.h"
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 #include <thread>
 #include <chrono>
 #include <csignal>
 #include <iomanip>
 #include <sstream>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+namespace {
+// Binds the calling thread to one CPU (no-op where affinity is not supported)
+void pinToCpu(unsigned cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        std::cerr << "[SCHEDULER WARNING] Could not pin thread to CPU " << cpu << "\n";
+    }
+#else
+    (void)cpu;
+#endif
+}
 
+// Console layout: telemetry channels per line
+constexpr uint32_t CONSOLE_LINE_1 = telemetryMask({TelemetryChannelId::time, TelemetryChannelId::phase});
+constexpr uint32_t CONSOLE_LINE_2 = telemetryMask({TelemetryChannelId::altitude, TelemetryChannelId::velocity, TelemetryChannelId::fuel});
+constexpr uint32_t CONSOLE_LINE_3 = telemetryMask({TelemetryChannelId::thrust, TelemetryChannelId::deltaV, TelemetryChannelId::dragForce});
+constexpr uint32_t CONSOLE_LINE_REENTRY = telemetryMask({TelemetryChannelId::heatFlux, TelemetryChannelId::heatLoad});
+}
 
 
 // ==========================================
 // Constructor: Initializes Dynamics and Subsystems
 // ==========================================
 Scheduler::Scheduler(CDH* cdhSystem) 
-: cdh(cdhSystem), telemetry(cdhSystem->getTelemetry()), dynamics(500000, 7600000, 100, 311, 5.0) {
+: cdh(cdhSystem), telemetry(cdhSystem->getTelemetry()), dynamics(500000, 7600000, 100, 311, 5.0),
+  sensors(static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count())) {
     
     std::cout << "========================================" << std::endl;
     std::cout << "     OpenSpaceFSW Scheduler Initialized    " << std::endl;
@@ -29,6 +58,39 @@ Scheduler::Scheduler(CDH* cdhSystem)
         exit(1);
     }     
     
+    // Wind: mean profile from the latest weather pull, turbulence field precomputed for this run
+    wind.loadWeather("scripts/api_data/weather_conditions.json");
+    windSeed = static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+    wind.generateTurbulence(windSeed);
+    dynamics.setWindModel(&wind);
+
+    // Flight events: the stepper stops exactly on these instead of sampling them once per cycle
+    dynamics.addVehicleEvents();
+    CDH::registerPhaseEvents(dynamics);
+
+    // Watchdog: criticality, budget per run (ms) and, for deferrable work, shedding order and decimation
+    // (all budgets together fit one CYCLE_DT, the landing guidance included)
+    dynamicsStage  = watchdog.registerSubsystem("FlightDynamics", Criticality::CRITICAL, 10.0);
+    sensorStage    = watchdog.registerSubsystem("Sensors", Criticality::ESSENTIAL, 5.0);
+    landingStage   = watchdog.registerSubsystem("GNC.Landing", Criticality::ESSENTIAL, LandingGuidance::CYCLE_BUDGET * 1000.0);
+    cdhStage       = watchdog.registerSubsystem("CDH", Criticality::CRITICAL, 10.0);
+    telemetryStage = watchdog.registerSubsystem("Telemetry", Criticality::ESSENTIAL, 5.0);
+    consoleStage   = watchdog.registerSubsystem("Console", Criticality::DEFERRABLE, 10.0, 1, 50);
+    securityStage  = watchdog.registerSubsystem("Security.Encrypt", Criticality::DEFERRABLE, 10.0, 2, 10);
+    loggingStage   = watchdog.registerSubsystem("Telemetry.Log", Criticality::DEFERRABLE, 10.0, 3, 10);
+
+    // Launch site, entry vehicle and the optimized ascent: liftoff mass, engines and propellant come from the
+    // profile, and so do the booster limits for the landing burn
+    flight.loadConfiguration("program_configuration.json", "ascent_profile.json");
+    if (flight.hasAscent()) {
+        const AscentProfile& ascent = flight.getAscent();
+        dynamics.setState(FlightDynamics::State{ascent.liftoffMass, ascent.thrust * ascent.throttleAt(0.0), ascent.burnRate * ascent.throttleAt(0.0),
+                                                ascent.isp, 0.0, 0.0, ascent.propellant, 0.0, 0.0, ascent.dragArea, dynamics.getState().gravity});
+        std::cout << "[INFO] Ascent profile loaded (" << ascent.rocketName << "): liftoff " << ascent.liftoffMass / 1000.0
+                  << " t | payload " << ascent.payload / 1000.0 << " t | MECO T+" << ascent.meco << "s\n";
+    }
+    gnc.configureLanding(flight.getBooster());
+
     // Register the signal handler
     std::signal(SIGINT, Scheduler::signalHandler);
 }
@@ -40,14 +102,10 @@ Scheduler::Scheduler(CDH* cdhSystem)
 Scheduler* Scheduler::instance = nullptr;
 volatile sig_atomic_t Scheduler::stopExecutionFlag = 0;  // Must be defined globally
 
-// Starts a safe shutdown
+// Starts a safe shutdown: only the flag is touched here (async-signal-safe); run() leaves its loop at the
+// next check and does the reports and the final log flush from the flight thread
 void Scheduler::signalHandler(int signum) {
-    
-    std::cout << "\n[WARNING] Received SIGINT (Ctrl + C) - Initiating Graceful Shutdown...\n" << std::endl;
-    
-    // Makes certain that the loop exits immediately
-    stopExecutionFlag = 1; 
-    if (instance) {instance->stop();}
+    stopExecutionFlag = 1;
 }
 
 
@@ -63,10 +121,18 @@ void Scheduler::run() {
     
 
     std::cout << "\n\n\n\n\n...FLIGHT SOFTWARE IS NOW RUNNING..." << std::endl;
-    telemetry.setPhase(MissionPhase::PRE_LAUNCH);
-    double elapsedTime = 0.0;
-    double prevAlt = 0.0, prevVel = 0.0, prevFuel = 0.0;
-    const double dt = 0.1;  // 100 m/s time steps
+    if (!restoredFromCheckpoint) {
+        telemetry.setPhase(MissionPhase::PRE_LAUNCH);
+        elapsedTime = 0.0;
+    }
+    TelemetryData previous = telemetry.getLatest();   // last cycle's sample, for intrusion monitoring
+    previous.altitude = dynamics.getAltitude();
+    previous.velocity = dynamics.getVelocity();
+    previous.fuel = dynamics.getFuel();
+    const double dt = CYCLE_DT;  // 100 ms time steps
+    stressEnd = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(stressSeconds));
+    if (stressMs > 0.0) startStressLoad();
 
 
     while (!stopExecutionFlag) {
@@ -77,86 +143,233 @@ void Scheduler::run() {
         // Because if a stop flag is received while in sleep, it won't be captured.
         // This ensures that it will be.
         if (stopExecutionFlag) {
-            std::cout << "\n[INFO] Stop flag received. Shutting down...\n";
             break;  // Immediately exit the loop
         }
 
+        // Critical work runs first; deferrable work runs after it and may be decimated by the watchdog
+        watchdog.beginCycle(cycle);
+        bool console = watchdog.shouldRun(consoleStage);
 
-        // Intrusion Detection - Uses previous loop telemetry data
-        std::ostringstream lastTelemetry;
-        lastTelemetry << "Altitude: " << std::fixed << std::setprecision(2) << prevAlt
-                      << " m | Velocity: " << prevVel << " m/s | Fuel: " << prevFuel << " kg";
-        security.monitor(lastTelemetry.str());
 
+        // Update Flight Dynamics every cycle - analytic propagation while coasting in orbit,
+        // numerical integration for powered / atmospheric flight
+        FlightDynamics::EventRecord event;
+        const FlightDynamics::State stepStart = dynamics.getState();
+        const double stepStartTime = elapsedTime;
+        const double stepStartCrossWind = dynamics.getCrossWindForce();
+        {
+            CycleWatchdog::Stage stage(watchdog, dynamicsStage);
 
-        // Update Flight Dynamics every cycle
-        dynamics.update(dt);
-        elapsedTime += dt;
+            // A registered event ends the step early, exactly on its threshold; the next cycle continues from there
+            elapsedTime += flight.step(dynamics, telemetry.getPhase(), elapsedTime, dt, &event);
+        }
+
+        for (const std::string& name : event.names) {
+            std::cout << std::fixed << std::setprecision(6)
+                      << "[EVENT] " << name << " at T+" << elapsedTime << "s"
+                      << " | Altitude: " << event.state.altitude << " m"
+                      << " | Velocity: " << event.state.velocity << " m/s"
+                      << " | Fuel: " << event.state.fuel << " kg\n" << std::defaultfloat;
+        }
+
+
+        // Sensors sample the truth across the step just taken; ADCS and GNC drain their streams
+        {
+            CycleWatchdog::Stage stage(watchdog, sensorStage);
+            sensors.generate(stepStartTime, elapsedTime, dynamics, stepStart, dynamics.getState(),
+                             stepStartCrossWind, dynamics.getCrossWindForce());
+            adcs.update(sensors.imu());
+            gnc.update(sensors.gps(), sensors.baro());
+        }
+
+
+        // Optimized ascent: stage-1 throttle schedule up to MECO, then stage separation
+        flight.flyAscent(dynamics, elapsedTime);
+
+
+        // Landing guidance flies the engine once it engages (solver work bounded by LandingGuidance::CYCLE_BUDGET
+        // per cycle; the ignition search spreads over the cycles before the burn)
+        {
+            CycleWatchdog::Stage stage(watchdog, landingStage);
+            flight.flyLanding(dynamics, gnc, elapsedTime, dt);
+        }
 
 
         // Create a telemetry data structure and populate it
         TelemetryData data;
+        data.time = elapsedTime;
         data.altitude = dynamics.getAltitude();
         data.velocity = dynamics.getVelocity();
         data.fuel = dynamics.getFuel();
         data.thrust = dynamics.getThrust();
         data.deltaV = dynamics.getDeltaV();
         data.dragForce = dynamics.getDragForce();
+        data.heatFlux = flight.isReentering() ? flight.getReentry().conditions().heatFlux : 0.0;
+        data.heatLoad = flight.getReentry().getState().heatLoad;
         
 
         // Instead of passing raw values
         // this is a data structure to pass structured telemetry data to CDH and pass of responsibility to CDH
-        std::cout << "[SCHEDULER] Confirming CDH is valid prior to telemetry processing...\n";
-        if (!cdh) {
-            std::cerr << "[SCHEDULER ERROR] CDH instance is NULL!!!\n";
-            exit(1);
-        }
-        else {
-            std::cout << "\n[SCHEDULER] CDH is valid, sending telemetry...\n";
-            cdh->processTelemetry(data);
+        // (console chatter stays outside the CRITICAL / ESSENTIAL stages so a slow stdout is never billed to them)
+        if (console) std::cout << "[SCHEDULER] Confirming CDH is valid prior to telemetry processing...\n";
+        {
+            CycleWatchdog::Stage stage(watchdog, cdhStage);
+
+            if (!cdh) {
+                std::cerr << "[SCHEDULER ERROR] CDH instance is NULL!!!\n";
+                exit(1);
+            }
+            else {
+                cdh->processTelemetry(data);
+            }
+
+            // Uplinked commands are applied here, after the phase update and before telemetry is logged
+            cdh->dispatchCommands();
         }
 
         // Updates the telemetry system
-        std::cout << "\n[SCHEDULER] Returned from CDH, continuing to update the telemetry subsystem..." << std::endl;
-        telemetry.update(data.altitude, data.velocity, data.fuel);
-        telemetry.logData();
+        if (console) std::cout << "\n[SCHEDULER] Returned from CDH, continuing to update the telemetry subsystem..." << std::endl;
+        {
+            CycleWatchdog::Stage stage(watchdog, telemetryStage);
+            telemetry.update(data);
+            data = telemetry.getLatest();   // with the phase CDH just settled
+            telemetry.publish(elapsedTime, data);
+        }
+
+        // Event stops and phase changes are always logged, as full frames (even while logging is shed)
+        bool keyFrame = !event.names.empty() || data.phase != previous.phase;
+        if (keyFrame || watchdog.shouldRun(loggingStage)) {
+            CycleWatchdog::Stage stage(watchdog, loggingStage);
+            telemetry.logData(keyFrame);
+        }
+
+
+        // Intrusion Detection - Uses previous loop telemetry data
+        if (watchdog.shouldRun(securityStage)) {
+            CycleWatchdog::Stage stage(watchdog, securityStage);
+            uint8_t frame[TelemetryFrame::MAX_BYTES];
+            std::size_t size = TelemetryFrame::encode(previous, TelemetryFrame::ALL_CHANNELS, frame);
+            security.monitor(std::string(reinterpret_cast<const char*>(frame), size));
+        }
 
 
         // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
         //       Console Output
         // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
-        std::ostringstream output;
-        output << "\nCycle: " << cycle << "\n"
-            << "Time: " << elapsedTime << "s | Phase: " << telemetry.phaseToString(telemetry.getPhase()) << "\n"
-            << "Altitude: " << data.altitude << " m | Velocity: " << data.velocity << " m/s | Fuel: " << data.fuel << " kg\n"
-            << "Thrust: " << data.thrust << " N | Delta-V: " << data.deltaV << " m/s | Drag: " << data.dragForce << " N\n"
-            << "ADCS: Stabilizing Attitude... | GNC: Processing Navigation Data...\n";
-        std::cout << output.str();
+        if (console) {
+            CycleWatchdog::Stage stage(watchdog, consoleStage);
+            std::ostringstream output;
+            output << "\nCycle: " << cycle << "\n"
+                << formatTelemetryText(data, CONSOLE_LINE_1) << "\n"
+                << formatTelemetryText(data, CONSOLE_LINE_2) << "\n"
+                << formatTelemetryText(data, CONSOLE_LINE_3) << "\n";
+            if (flight.isReentering()) output << formatTelemetryText(data, CONSOLE_LINE_REENTRY) << "\n";
+            output
+                << "ADCS: " << adcs.getLastBatchSize() << " IMU samples | Attitude drift (deg): "
+                << adcs.getAttitude()[0] * 180.0 / M_PI << ", " << adcs.getAttitude()[1] * 180.0 / M_PI << ", "
+                << adcs.getAttitude()[2] * 180.0 / M_PI << "\n"
+                << "GNC: Nav altitude: " << gnc.getAltitude() << " m | GPS velocity: " << gnc.getVelocity()
+                << " m/s | Fix age: " << gnc.getFixAge(elapsedTime) << " s\n";
+            std::cout << output.str();
+        }
 
 
         // Store telemetry for next cycle intrusion monitoring
-        prevAlt = data.altitude;
-        prevVel = data.velocity;
-        prevFuel = data.fuel;
+        previous = data;
 
 
+        // Degradation mode changes are flight events: console + telemetry log
+        if (watchdog.endCycle()) {
+            std::ostringstream mode;
+            mode << "Watchdog mode -> " << watchdog.describeMode() << " at T+" << elapsedTime << "s";
+            std::cout << "[EVENT] " << mode.str() << "\n";
+            telemetry.logEvent(mode.str());
+        }
 
-        // Sleep for loop timing (but check flag first)
-        for (int i = 0; i < 10; ++i) {  // Sleep in small chunks
-            if (stopExecutionFlag) break;
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        // Stress test verdict: once the load is gone, full service has to come back within the limit
+        if (stressMs > 0.0 && std::chrono::steady_clock::now() >= stressEnd) {
+            double since = std::chrono::duration<double>(std::chrono::steady_clock::now() - stressEnd).count();
+            if (watchdog.getLevel() == 0) {
+                stressRecovered = true;
+                std::cout << "[STRESS] Full service restored " << since << " s after the load was removed.\n";
+                stop();
+            } else if (since > STRESS_RECOVERY_LIMIT) {
+                std::cout << "[STRESS] Still " << watchdog.describeMode() << " " << since
+                          << " s after the load was removed.\n";
+                stop();
+            }
         }
 
 
+        // Sleep until the cycle deadline (in small chunks so the stop flag is still seen)
+        auto deadline = watchdog.nextDeadline();
+        while (!stopExecutionFlag) {
+            auto remaining = deadline - std::chrono::steady_clock::now();
+            if (remaining <= std::chrono::steady_clock::duration::zero()) break;
+            std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(remaining, std::chrono::milliseconds(10)));
+        }
 
-    }
 
 
-    std::cout << "\n[INFO] Flight Software Terminated Safely.\n" << std::endl;
+    }
 
+    finish();
+}
 
+/**
+ * Stress test load: a second thread on the flight loop's CPU (both are pinned to it), busy-spinning stressMs
+ * of every STRESS_PERIOD. At equal priority the kernel favours the loop waking from its sleep, so the load
+ * asks for real-time priority (SCHED_FIFO, needs CAP_SYS_NICE) and then preempts whatever stage is running,
+ * like an interrupt storm or a higher-priority task would; without the privilege it time-slices with the loop.
+ * The period is a little shorter than the cycle, so over the window the bursts precede and overlap every
+ * stage in turn. Bursts are capped at STRESS_MAX_DUTY of the period so the core is never taken outright.
+ * The verdict comes from the CRITICAL stages' measured deadline misses.
+ */
+void Scheduler::startStressLoad() {
+    unsigned cpu = 0;
+#ifdef __linux__
+    int current = sched_getcpu();
+    cpu = current < 0 ? 0u : static_cast<unsigned>(current);
+#endif
+    pinToCpu(cpu);
+
+    stressCancel = false;
+    std::atomic<int> realTime{-1};
+    stressThread = std::thread([this, cpu, &realTime]() {
+        pinToCpu(cpu);
+        bool fifo = false;
+#ifdef __linux__
+        sched_param param{};
+        param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+        fifo = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+#endif
+        realTime = fifo ? 1 : 0;
+
+        const auto burst = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(std::min(stressMs, STRESS_MAX_DUTY * STRESS_PERIOD * 1000.0)));
+        const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(STRESS_PERIOD));
+        volatile double sink = 0.0;
+
+        for (auto start = std::chrono::steady_clock::now(); start < stressEnd && !stressCancel; start += period) {
+            while (std::chrono::steady_clock::now() < std::min(start + burst, stressEnd) && !stressCancel) {
+                for (int i = 0; i < 1000; ++i) sink = sink + std::sqrt(static_cast<double>(i));
+            }
+            std::this_thread::sleep_until(std::min(start + period, stressEnd));
+        }
+    });
+    while (realTime < 0) std::this_thread::yield();
+    std::cout << "[STRESS] Competing load on CPU " << cpu << ": " << stressMs << " ms busy every "
+              << STRESS_PERIOD * 1000.0 << " ms for " << stressSeconds << " s"
+              << (realTime ? " (real-time priority)" : " (flight loop priority - no CAP_SYS_NICE for real-time)") << "\n";
 }
 
+void Scheduler::stopStressLoad() {
+    stressCancel = true;
+    if (stressThread.joinable()) stressThread.join();
+}
+
+
 // This makes sure that the shared telemetry phases is always up-to-date
 void Scheduler::updateSchedulerPhase(MissionPhase newPhase) {
     telemetry.setPhase(newPhase);
@@ -166,17 +379,76 @@ void Scheduler::updateSchedulerPhase(MissionPhase newPhase) {
 
 
 
-// Stop method for graceful shutdown
+/**
+==========================================
+    Checkpoint / Restore
+==========================================
+
+Captures the state every subsystem carries from one cycle to the next (see SimulationCheckpoint); a restored
+run continues from the same state, reproducible except for wall-clock-dependent effects. Restoring is a few
+struct copies plus a fresh turbulence field from the saved seed.
+*/
+SimulationCheckpoint Scheduler::captureCheckpoint() const {
+    SimulationCheckpoint checkpoint;
+    checkpoint.dynamics = dynamics.getState();
+    checkpoint.armedEvents = dynamics.getArmedEvents();
+    checkpoint.telemetry = telemetry.getState();
+    checkpoint.phase = telemetry.getPhase();
+    checkpoint.cycle = cycle;
+    checkpoint.elapsedTime = elapsedTime;
+    checkpoint.flight = flight.snapshot();
+    checkpoint.windSeed = windSeed;
+    checkpoint.sensors = sensors.snapshot();
+    checkpoint.adcs = adcs.snapshot();
+    checkpoint.gnc = gnc.snapshot();
+    checkpoint.watchdog = watchdog.snapshot();
+    return checkpoint;
+}
+
+void Scheduler::restoreCheckpoint(const SimulationCheckpoint& checkpoint) {
+    dynamics.setState(checkpoint.dynamics);
+    dynamics.setArmedEvents(checkpoint.armedEvents);
+    telemetry.setState(checkpoint.telemetry);
+    telemetry.setPhase(checkpoint.phase);
+    cycle = static_cast<int>(checkpoint.cycle);
+    elapsedTime = checkpoint.elapsedTime;
+    restoredFromCheckpoint = true;
+    flight.restore(checkpoint.flight);
+    if (checkpoint.windSeed != windSeed) {
+        windSeed = checkpoint.windSeed;
+        wind.generateTurbulence(windSeed);
+    }
+    sensors.restore(checkpoint.sensors);
+    adcs.restore(checkpoint.adcs);
+    gnc.restore(checkpoint.gnc);
+    watchdog.restore(checkpoint.watchdog);
+}
+
+
+
+
+// Stop method for graceful shutdown: the loop ends after the current cycle (TERMINATE, POST_FLIGHT, stress verdict)
 void Scheduler::stop() {
-    std::cout << "[INFO] Scheduler is shutting down...\n";    
     stopExecutionFlag = 1;  // Set the flag to stop the loop
+}
 
 
-    // Final cleanup steps
+// Final cleanup steps, on the flight thread once the loop has exited
+void Scheduler::finish() {
+    std::cout << "\n[INFO] Stop flag received. Scheduler is shutting down...\n";
     std::cout << "[INFO] Finalizing subsystems and cleaning up memory...\n";
     telemetry.logData(); // Makes sure that subsytem telemetry logging stops properly
+    if (cdh) cdh->reportCommandStats();
+    watchdog.report();
+    sensors.report();
+    gnc.reportLanding(CYCLE_DT * 1000.0);
+    telemetry.reportLog();
+
+    if (stressMs > 0.0) {
+        stopStressLoad();
+        std::cout << "[STRESS] Stress test " << (stressPassed() ? "PASSED" : "FAILED")
+                  << " | CRITICAL deadline misses: " << watchdog.criticalMisses()
+                  << " | Full service " << (stressRecovered ? "restored" : "not restored") << "\n";
+    }
     std::cout << "[INFO] Flight Software Terminated Safely.\n";
-
-
-    std::exit(0); // Exit cleanly
 }
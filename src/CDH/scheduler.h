@@ -6,7 +6,14 @@
 #include "telemetry/telemetry.h"
 #include "security.h"
 #include "flight_dynamics.h"
+#include "checkpoint.h"
+#include "watchdog.h"
+#include "sensor_suite.h"
+#include "flight_stepper.h"
 #include <atomic>
+#include <chrono>
+#include <csignal>
+#include <thread>
 
 // Forward declaration to prevent circular dependency
 class CDH;
@@ -17,12 +24,37 @@ private:
     GNC gnc;
     Security security;
     FlightDynamics dynamics;
+    WindModel wind;
+    SensorSuite sensors;  // IMU / GPS / baro generated from the dynamics truth every cycle
     static Scheduler* instance; // Static instance to allow access in signal handler
     static volatile sig_atomic_t stopExecutionFlag; // flag that stops execution
     
 
     // counter
     int cycle = 0;
+    double elapsedTime = 0.0;
+    bool restoredFromCheckpoint = false;  // skip the PRE_LAUNCH reset in run()
+
+    // Vehicle side of the cycle: integration / coast / reentry, ascent schedule, landing burn (shared with branches)
+    FlightStepper flight;
+    uint64_t windSeed = 0;
+
+    // Cycle deadlines and load shedding (ids returned by the watchdog at registration)
+    CycleWatchdog watchdog{CYCLE_DT};
+    int dynamicsStage, sensorStage, landingStage, cdhStage, telemetryStage, loggingStage, securityStage, consoleStage;
+
+    // Stress test: a competing thread pinned to the flight loop's CPU busy-spins stressMs of every
+    // STRESS_PERIOD until stressEnd, preempting and delaying every stage, CRITICAL ones included; the run
+    // ends once full service is back (or STRESS_RECOVERY_LIMIT has passed without it)
+    double stressMs = 0.0;
+    double stressSeconds = 0.0;
+    std::chrono::steady_clock::time_point stressEnd;
+    bool stressRecovered = false;
+    std::thread stressThread;
+    std::atomic<bool> stressCancel{false};
+    void startStressLoad();
+    void stopStressLoad();
+    void finish();   // reports and final log flush after the loop
     
 
     // Required for Scheduler Acception
@@ -31,10 +63,24 @@ private:
 
 
 public:
+    static constexpr double CYCLE_DT = 0.1;  // Simulation time step per cycle (s)
+    static constexpr double STRESS_RECOVERY_LIMIT = 10.0;   // NOMINAL must return this soon after the stress load ends (s)
+    static constexpr double STRESS_PERIOD = 0.097;          // Load burst period: drifts 3 ms per cycle across the stages (s)
+    static constexpr double STRESS_MAX_DUTY = 0.9;          // Longest burst, as a fraction of STRESS_PERIOD
+
     Scheduler(CDH* cdhSystem);
     void run();
     void updateSchedulerPhase(MissionPhase newPhase);
     void stop();
+    FlightDynamics& getDynamics() { return dynamics; }
+    FlightStepper& getFlight() { return flight; }
+    void setStress(double milliseconds, double seconds) { stressMs = milliseconds; stressSeconds = seconds; }
+    bool stressFailed() const { return stressMs > 0.0 && !stressPassed(); }
+    bool stressPassed() const { return stressRecovered && watchdog.criticalMisses() == 0; }
+
+    // Checkpoint / restore of the complete simulation state
+    SimulationCheckpoint captureCheckpoint() const;
+    void restoreCheckpoint(const SimulationCheckpoint& checkpoint);
     static void signalHandler(int signum); // Static method for signal handling
 };
 
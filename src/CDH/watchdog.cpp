@@ -0,0 +1,225 @@
+#include "watchdog.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+
+namespace {
+
+double millisecondsBetween(CycleWatchdog::Clock::time_point a, CycleWatchdog::Clock::time_point b) {
+    return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+const char* criticalityName(Criticality c) {
+    switch (c) {
+        case Criticality::CRITICAL:  return "CRITICAL";
+        case Criticality::ESSENTIAL: return "ESSENTIAL";
+        default:                     return "DEFERRABLE";
+    }
+}
+
+}  // namespace
+
+
+
+CycleWatchdog::CycleWatchdog(double periodSeconds)
+    : period(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(periodSeconds))) {}
+
+
+
+int CycleWatchdog::registerSubsystem(const std::string& name, Criticality criticality, double budgetMs,
+                                     int shedLevel, int decimation) {
+    Subsystem s;
+    s.name = name;
+    s.criticality = criticality;
+    s.budgetMs = budgetMs;
+    s.shedLevel = (criticality == Criticality::DEFERRABLE) ? std::max(shedLevel, 0) : 0;
+    s.decimation = std::max(decimation, 1);
+
+    maxLevel = std::max(maxLevel, s.shedLevel);
+    subsystems.push_back(s);
+    return static_cast<int>(subsystems.size()) - 1;
+}
+
+
+
+/**
+==========================================
+    Cycle Boundaries
+==========================================
+
+Deadlines advance by exactly one period so the loop does not drift; after an overrun the next
+deadline is re-anchored to now instead of trying to catch up with a burst of short cycles.
+A cycle that starts late (the loop was preempted past its release) is still due one period after it
+should have started, so time lost before the first stage counts against this cycle's work.
+*/
+void CycleWatchdog::beginCycle(int64_t cycleNumber) {
+    Clock::time_point now = Clock::now();
+
+    cycle = cycleNumber;
+    cycleStart = now;
+    dueBy = cycles == 0 ? now + period : deadline + period;
+    deadline = (cycles == 0 || now > deadline) ? now + period : deadline + period;
+    stageMs = 0.0;
+}
+
+
+bool CycleWatchdog::shouldRun(int id) {
+    Subsystem& s = subsystems[id];
+    if (!isShed(s, level) || cycle % s.decimation == 0) {
+        return true;
+    }
+    s.skipped++;
+    return false;
+}
+
+
+void CycleWatchdog::heartbeat(int id, Clock::time_point start, Clock::time_point end) {
+    Subsystem& s = subsystems[id];
+    double ms = millisecondsBetween(start, end);
+
+    // A run after skipped cycles is a probe of a shed subsystem; at 1/N runs an EWMA would take
+    // N / COST_SMOOTHING cycles to forget the overload, so the probe is taken as the estimate
+    bool probe = s.lastHeartbeat >= 0 && s.lastHeartbeat < cycle - 1 && isShed(s, level);
+    s.lastHeartbeat = cycle;
+    s.averageMs = (s.runs == 0 || probe) ? ms : s.averageMs + COST_SMOOTHING * (ms - s.averageMs);
+    s.worstMs = std::max(s.worstMs, ms);
+    s.runs++;
+    stageMs += ms;
+
+    if (ms > s.budgetMs || end > dueBy) {
+        s.deadlineMisses++;
+        if (s.criticality == Criticality::CRITICAL) {
+            std::cerr << std::fixed << std::setprecision(2) << "[WATCHDOG WARNING] " << s.name
+                      << " missed its deadline in cycle " << cycle << " (" << ms << " ms, budget "
+                      << s.budgetMs << " ms";
+            if (end > dueBy) std::cerr << ", " << millisecondsBetween(dueBy, end) << " ms past due";
+            std::cerr << ")\n" << std::defaultfloat;
+        }
+    }
+}
+
+
+bool CycleWatchdog::endCycle() {
+    Clock::time_point now = Clock::now();
+    double workMs = millisecondsBetween(cycleStart, now);
+    double periodMs = std::chrono::duration<double, std::milli>(period).count();
+    bool overrun = now > dueBy;
+
+    cycles++;
+    if (overrun) overruns++;
+    worstLoad = std::max(worstLoad, workMs / periodMs);
+    overheadMs += COST_SMOOTHING * (std::max(workMs - stageMs, 0.0) - overheadMs);
+
+    // Heartbeats: everything that may not be shed has to have run this cycle
+    for (Subsystem& s : subsystems) {
+        if (s.criticality != Criticality::DEFERRABLE && s.lastHeartbeat != cycle) {
+            s.missedHeartbeats++;
+            std::cerr << "[WATCHDOG WARNING] No heartbeat from " << s.name << " in cycle " << cycle << "\n";
+        }
+    }
+
+    // Shed more on sustained overrun
+    if (overrun) {
+        slackStreak = 0;
+        if (++overrunStreak >= ESCALATE_AFTER && level < maxLevel) {
+            level++;
+            overrunStreak = 0;
+            return true;
+        }
+        return false;
+    }
+    overrunStreak = 0;
+
+    // Restore one level once the predicted cost of full(er) service has fit for a while
+    if (level > 0) {
+        if (predictedCycleMs(level - 1) < RECOVERY_LOAD * periodMs) {
+            if (++slackStreak >= RECOVER_AFTER) {
+                level--;
+                slackStreak = 0;
+                return true;
+            }
+        } else {
+            slackStreak = 0;
+        }
+    }
+    return false;
+}
+
+
+
+// The level is clamped to what the registered subsystems can shed
+void CycleWatchdog::restore(const Snapshot& snapshot) {
+    level = std::clamp(snapshot.level, 0, maxLevel);
+    overrunStreak = std::max(snapshot.overrunStreak, 0);
+    slackStreak = std::max(snapshot.slackStreak, 0);
+}
+
+
+
+bool CycleWatchdog::isShed(const Subsystem& s, int atLevel) const {
+    return s.shedLevel > 0 && atLevel >= s.shedLevel;
+}
+
+
+// Expected cycle time at a degradation level, from the smoothed per-run cost of every subsystem
+double CycleWatchdog::predictedCycleMs(int atLevel) const {
+    double total = overheadMs;
+    for (const Subsystem& s : subsystems) {
+        total += isShed(s, atLevel) ? s.averageMs / s.decimation : s.averageMs;
+    }
+    return total;
+}
+
+
+
+std::string CycleWatchdog::describeMode() const {
+    if (level == 0) return "NOMINAL (full service)";
+
+    std::ostringstream mode;
+    mode << "DEGRADED level " << level << " - shedding:";
+    for (const Subsystem& s : subsystems) {
+        if (isShed(s, level)) mode << " " << s.name << " (1/" << s.decimation << ")";
+    }
+    return mode.str();
+}
+
+
+
+uint64_t CycleWatchdog::criticalMisses() const {
+    uint64_t misses = 0;
+    for (const Subsystem& s : subsystems) {
+        if (s.criticality == Criticality::CRITICAL) misses += s.deadlineMisses + s.missedHeartbeats;
+    }
+    return misses;
+}
+
+
+
+/**
+==========================================
+    Shutdown Report
+==========================================
+*/
+void CycleWatchdog::report() const {
+    std::cout << std::fixed << std::setprecision(2)
+              << "\n[WATCHDOG] Cycles: " << cycles << " | Overruns: " << overruns
+              << " | Worst load: " << worstLoad * 100.0 << "% | Final mode: " << describeMode() << "\n";
+
+    for (const Subsystem& s : subsystems) {
+        std::cout << "[WATCHDOG] " << std::left << std::setw(18) << s.name << std::right
+                  << std::setw(11) << criticalityName(s.criticality)
+                  << " | runs " << std::setw(6) << s.runs << " | skipped " << std::setw(6) << s.skipped
+                  << " | avg " << std::setw(7) << s.averageMs << " ms | worst " << std::setw(7) << s.worstMs
+                  << " ms | budget " << std::setw(6) << s.budgetMs << " ms | misses " << s.deadlineMisses
+                  << " | missed heartbeats " << s.missedHeartbeats << "\n";
+    }
+
+    if (criticalMisses() == 0) {
+        std::cout << "[WATCHDOG] All CRITICAL subsystems met their deadlines.\n";
+    } else {
+        std::cout << "[WATCHDOG] CRITICAL deadline misses: " << criticalMisses() << "\n";
+    }
+    std::cout << std::defaultfloat;
+}
@@ -0,0 +1,135 @@
+#ifndef WATCHDOG_H
+#define WATCHDOG_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+// How much a subsystem may be degraded when the cycle runs out of time
+enum class Criticality {
+    CRITICAL,     // Must run every cycle and meet its budget (flight dynamics, CDH)
+    ESSENTIAL,    // Must run every cycle, budget overruns are reported
+    DEFERRABLE    // May be decimated under load
+};
+
+
+
+/**
+==========================================
+    Cycle-Deadline Watchdog
+==========================================
+
+- Subsystems register once with a criticality and a per-cycle time budget; every run is timed by a
+  Stage guard, which also counts as that subsystem's heartbeat for the cycle.
+- endCycle() checks the cycle against its deadline and every non-deferrable subsystem for a heartbeat.
+- Sustained overrun steps the degradation level up one at a time. Each DEFERRABLE subsystem declares the
+  level at which it is shed and how far it is decimated once shed.
+- A level is only stepped back down when the predicted cycle cost with that work restored (measured
+  per-run costs + unaccounted overhead) still fits in the slack, so the watchdog does not flap between modes.
+- While shed, every decimated run is a probe: its timing replaces the cost estimate outright instead of being
+  smoothed in, so the estimate tracks the load the work would add now rather than the load that got it shed.
+*/
+class CycleWatchdog {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int ESCALATE_AFTER = 3;         // consecutive overrun cycles before shedding more
+    static constexpr int RECOVER_AFTER = 20;         // consecutive cycles with slack before restoring
+    static constexpr double RECOVERY_LOAD = 0.6;     // restored load must stay under this fraction of the period
+    static constexpr double COST_SMOOTHING = 0.2;    // EWMA weight of the newest stage timing
+
+    struct Subsystem {
+        std::string name;
+        Criticality criticality;
+        double budgetMs;
+        int shedLevel;          // degradation level at which a DEFERRABLE subsystem is shed (0 = never)
+        int decimation;         // run every Nth cycle once shed (probes its current cost)
+
+        int64_t lastHeartbeat = -1;
+        double averageMs = 0.0;     // EWMA of the cost of one run
+        double worstMs = 0.0;
+        uint64_t runs = 0;
+        uint64_t skipped = 0;
+        uint64_t deadlineMisses = 0;
+        uint64_t missedHeartbeats = 0;
+    };
+
+    // Degradation state carried across cycles (checkpoints); cost estimates are wall-clock and re-measured
+    struct Snapshot {
+        int level = 0;
+        int overrunStreak = 0;
+        int slackStreak = 0;
+    };
+
+    // RAII timer around one subsystem's work for the current cycle
+    class Stage {
+        CycleWatchdog& watchdog;
+        int id;
+        Clock::time_point start;
+    public:
+        Stage(CycleWatchdog& wd, int subsystem) : watchdog(wd), id(subsystem), start(Clock::now()) {}
+        ~Stage() { watchdog.heartbeat(id, start, Clock::now()); }
+        Stage(const Stage&) = delete;
+        Stage& operator=(const Stage&) = delete;
+    };
+
+private:
+    std::vector<Subsystem> subsystems;
+    std::chrono::nanoseconds period;
+    Clock::time_point cycleStart;
+    Clock::time_point deadline;     // end of this cycle's period, re-anchored after a late start
+    Clock::time_point dueBy;        // when this cycle's work is due: one period after its scheduled start
+    int64_t cycle = 0;
+
+    int level = 0;
+    int maxLevel = 0;
+    int overrunStreak = 0;
+    int slackStreak = 0;
+
+    uint64_t cycles = 0;
+    uint64_t overruns = 0;
+    double worstLoad = 0.0;
+    double stageMs = 0.0;           // time spent inside Stage guards this cycle
+    double overheadMs = 0.0;        // EWMA of cycle time not attributed to any subsystem
+
+    void heartbeat(int id, Clock::time_point start, Clock::time_point end);
+    bool isShed(const Subsystem& s, int atLevel) const;
+    double predictedCycleMs(int atLevel) const;
+
+public:
+    explicit CycleWatchdog(double periodSeconds);
+
+    /**
+     * @brief Registers a subsystem
+     * @param budgetMs Time the subsystem may use per run
+     * @param shedLevel DEFERRABLE only: degradation level that starts shedding it (1 = first to go)
+     * @param decimation DEFERRABLE only: while shed, run every Nth cycle
+     * @return Id used with Stage and shouldRun()
+     */
+    int registerSubsystem(const std::string& name, Criticality criticality, double budgetMs,
+                          int shedLevel = 0, int decimation = 1);
+
+    void beginCycle(int64_t cycleNumber);
+
+    // False when a shed subsystem should skip this cycle (counted as skipped, not as a missed heartbeat)
+    bool shouldRun(int id);
+
+    /**
+     * @brief Closes the cycle: deadline / heartbeat checks and degradation level changes
+     * @return true if the degradation level changed (describeMode() has the new mode)
+     */
+    bool endCycle();
+
+    Snapshot snapshot() const { return Snapshot{level, overrunStreak, slackStreak}; }
+    void restore(const Snapshot& snapshot);
+
+    Clock::time_point nextDeadline() const { return deadline; }
+    int getLevel() const { return level; }
+    uint64_t criticalMisses() const;   // deadline misses + missed heartbeats of CRITICAL subsystems
+    std::string describeMode() const;
+    void report() const;
+};
+
+#endif
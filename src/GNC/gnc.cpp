@@ -11,10 +11,99 @@ void GNC::initialize() {
     std::cout << "GNC Initialized (Guidance, Navigation & Control)" << std::endl;
 }
 
-void GNC::update() {
-    NULL; // Placeholder
+/**
+ * A GPS fix arrives GPS_LATENCY after its epoch, so it is compared with the baro altitude
+ * at that epoch propagated to now with the fix's own vertical velocity - not with the current baro.
+ */
+void GNC::update(GpsStream& gps, BaroStream& baro) {
+    BaroSample sample;
+    while (baro.pop(sample)) {
+        if (!std::isfinite(sample.altitude)) continue;   // above the baro's range (zero pressure)
+        lastBaroAltitude = sample.altitude;
+        lastBaroTime = sample.time;
+        baroSamples++;
+    }
+
+    GpsFix fix;
+    while (gps.pop(fix)) {
+        if (lastBaroTime >= 0.0) {
+            double gpsNow = fix.altitude + fix.verticalVelocity * (lastBaroTime - fix.time);
+            double residual = gpsNow - (lastBaroAltitude + baroOffset);
+            baroOffset += (gpsFixes == 0 ? 1.0 : GPS_BLEND) * residual;
+        }
+        navVelocity = fix.verticalVelocity;
+        lastFixTime = fix.time;
+        gpsFixes++;
+    }
+
+    if (lastBaroTime >= 0.0) {
+        navAltitude = lastBaroAltitude + baroOffset;
+        navValid = true;
+    }
+}
+
+void GNC::configureLanding(const LandingVehicle& vehicle) {
+    landing.setVehicle(vehicle);
+    landingDryMass = vehicle.dryMass;
+    reportedLandingStatus = LandingStatus::IDLE;
+}
+
+
+/**
+ * Vertical channel only: the flight dynamics are one-dimensional, so downrange position and
+ * velocity are zero and the plan's vertical acceleration is what gets flown.
+ */
+bool GNC::updateLanding(double time, double fuel, double gravity, double period, LandingCommand& command) {
+    if (!landing.isEngaged()) {
+        bool descending = navValid && navVelocity < 0.0;
+        if (!descending || !(navAltitude > 0.0 && navAltitude <= LANDING_IGNITION_ALTITUDE)) return false;
+    }
+
+    LandingState state;
+    state.time = time;
+    state.position[0] = navAltitude;
+    state.velocity[0] = navVelocity;
+    state.mass = landingDryMass + fuel;
+    state.gravity = gravity;
+    LandingStatus status = landing.update(state);
+
+    if (status != reportedLandingStatus && consoleMessages) {
+        std::cout << "[GNC] Landing guidance: " << landingStatusName(status) << " at T+" << time << "s";
+        if (landing.isEngaged()) {
+            std::cout << " | Burn time: " << landing.getTimeOfFlight() << " s | Planned propellant: "
+                      << landing.plannedPropellant() << " kg";
+        }
+        std::cout << "\n";
+    }
+    reportedLandingStatus = status;
+
+    if (!landing.isEngaged()) return false;
+    command = landing.command(time, period);
+    return true;
+}
+
+
+GNC::Snapshot GNC::snapshot() const {
+    return Snapshot{navAltitude, navVelocity, baroOffset, lastBaroAltitude, lastBaroTime, lastFixTime,
+                    navValid, gpsFixes, baroSamples, reportedLandingStatus, landing.snapshot()};
 }
 
+
+void GNC::restore(const Snapshot& snapshot) {
+    navAltitude = snapshot.navAltitude;
+    navVelocity = snapshot.navVelocity;
+    baroOffset = snapshot.baroOffset;
+    lastBaroAltitude = snapshot.lastBaroAltitude;
+    lastBaroTime = snapshot.lastBaroTime;
+    lastFixTime = snapshot.lastFixTime;
+    navValid = snapshot.navValid;
+    gpsFixes = snapshot.gpsFixes;
+    baroSamples = snapshot.baroSamples;
+    reportedLandingStatus = snapshot.reportedLandingStatus;
+    landing.restore(snapshot.landing);
+}
+
+
 void GNC::adjustThrust(double deltaV) {
     NULL; // Placeholder
 }
@@ -1,13 +1,66 @@
 #ifndef GNC_H
 #define GNC_H
 
-// Placeholder for now.
+#include "sensor_data.h"
+#include "landing_guidance.h"
+#include <cstdint>
+
+// Navigation: barometric altitude blended with latency-compensated GPS.
+// Guidance: powered-descent landing burn (LandingGuidance) flown on the navigation solution.
 
 class GNC {
+private:
+    // Complementary filter: baro carries the high-rate altitude, GPS pulls out its slow bias
+    static constexpr double GPS_BLEND = 0.2;        // fraction of the GPS residual applied per fix
+
+    double navAltitude = 0.0;       // m
+    double navVelocity = 0.0;       // m/s (latest GPS vertical velocity)
+    double baroOffset = 0.0;        // GPS-estimated baro bias (m)
+    double lastBaroAltitude = 0.0;
+    double lastBaroTime = -1.0;
+    double lastFixTime = -1.0;      // epoch of the newest GPS fix
+    bool navValid = false;
+    uint64_t gpsFixes = 0, baroSamples = 0;
+
+    LandingGuidance landing{LandingVehicle{}};
+    double landingDryMass = LandingVehicle{}.dryMass;
+    LandingStatus reportedLandingStatus = LandingStatus::IDLE;
+    bool consoleMessages = true;
+
 public:
+    // Navigation solution and landing guidance as update() / updateLanding() left them (checkpoints)
+    struct Snapshot {
+        double navAltitude = 0.0, navVelocity = 0.0, baroOffset = 0.0;
+        double lastBaroAltitude = 0.0, lastBaroTime = -1.0, lastFixTime = -1.0;
+        bool navValid = false;
+        uint64_t gpsFixes = 0, baroSamples = 0;
+        LandingStatus reportedLandingStatus = LandingStatus::IDLE;
+        LandingGuidance::Snapshot landing;
+    };
+
     void initialize();
-    void update();
+
+    // Drains both streams (once per cycle) and updates the navigation solution
+    void update(GpsStream& gps, BaroStream& baro);
     void adjustThrust(double deltaV);
+
+    // Landing burn: engages descending through LANDING_IGNITION_ALTITUDE (navigation solution).
+    // Returns true while guidance owns the engine; `command` is then the thrust to fly this cycle.
+    static constexpr double LANDING_IGNITION_ALTITUDE = 3000.0;     // m
+    void configureLanding(const LandingVehicle& vehicle);
+    bool updateLanding(double time, double fuel, double gravity, double period, LandingCommand& command);
+    void reportLanding(double cycleBudgetMs) const { landing.report(cycleBudgetMs); }
+    void setConsoleMessages(bool enabled) { consoleMessages = enabled; }   // landing status changes
+
+    Snapshot snapshot() const;
+    void restore(const Snapshot& snapshot);   // after configureLanding(), which resets the guidance
+
+    bool hasSolution() const { return navValid; }
+    double getAltitude() const { return navAltitude; }
+    double getVelocity() const { return navVelocity; }
+    double getFixAge(double now) const { return lastFixTime < 0.0 ? -1.0 : now - lastFixTime; }
+    uint64_t getGpsFixes() const { return gpsFixes; }
+    uint64_t getBaroSamples() const { return baroSamples; }
 };
 
 #endif
@@ -0,0 +1,960 @@
+/*
+Powered-descent guidance for the booster landing burn.
+
+Research:
+
+1. Açıkmeşe, Ploen, "Convex Programming Approach to Powered Descent Guidance for Mars Landing",
+Journal of Guidance, Control, and Dynamics 30(5), 2007 - lossless convexification of the thrust bounds
+https://doi.org/10.2514/1.27553
+
+2. Blackmore, Açıkmeşe, Scharf, "Minimum-Landing-Error Powered-Descent Guidance for Mars Landing Using
+Convex Optimization", Journal of Guidance, Control, and Dynamics 33(4), 2010 - G-FOLD, time-of-flight search
+https://doi.org/10.2514/1.47202
+
+3. Stellato, Banjac, Goulart, Bemporad, Boyd, "OSQP: An Operator Splitting Solver for Quadratic Programs",
+Mathematical Programming Computation 12, 2020 - ADMM splitting, ρ adaptation, termination criteria
+https://arxiv.org/abs/1711.08013
+*/
+
+#include "landing_guidance.h"
+#include "flight_dynamics.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+
+
+namespace {
+
+constexpr double STANDARD_GRAVITY = 9.80665;   // m/s², Isp -> exhaust velocity
+constexpr double SIGMA = 1e-6;                 // ADMM x-regularization
+constexpr double RELAXATION = 1.6;             // ADMM over-relaxation α
+constexpr double EQUALITY_RHO_SCALE = 1e3;
+constexpr int CHECK_INTERVAL = 10;             // iterations between residual checks
+constexpr int ADAPT_INTERVAL = 50;             // iterations between ρ updates
+constexpr double INACCURATE_RESIDUAL = 1e-2;   // unconverged re-solves below this are still flown
+
+using Clock = std::chrono::steady_clock;
+
+}  // namespace
+
+
+
+/**
+==========================================
+    ConicAdmm (instantiated here by LandingGuidance)
+==========================================
+*/
+template<std::size_t NV, std::size_t NROWS, std::size_t NCONES>
+void ConicAdmm<NV, NROWS, NCONES>::clear() {
+    for (std::size_t i = 0; i < NROWS; ++i) {
+        std::fill(A[i], A[i] + NV, 0.0);
+        lower[i] = -INFINITE_BOUND;
+        upper[i] = INFINITE_BOUND;
+        offset[i] = 0.0;
+    }
+    std::fill(q, q + NV, 0.0);
+    coneStart.fill(0);
+    coneSize.fill(0);
+    coneRows = 0;
+}
+
+
+template<std::size_t NV, std::size_t NROWS, std::size_t NCONES>
+void ConicAdmm<NV, NROWS, NCONES>::prepare() {
+    auto scaleRow = [this](std::size_t row, double s) {
+        for (std::size_t j = 0; j < NV; ++j) A[row][j] *= s;
+        offset[row] *= s;
+        if (lower[row] > -INFINITE_BOUND) lower[row] *= s;
+        if (upper[row] < INFINITE_BOUND) upper[row] *= s;
+    };
+    auto rowMax = [this](std::size_t row) {
+        double largest = 0.0;
+        for (std::size_t j = 0; j < NV; ++j) largest = std::max(largest, std::fabs(A[row][j]));
+        return largest;
+    };
+
+    // Ruiz equilibration: rows (one factor per cone block, so the cone stays a cone), then columns
+    std::fill(columnScale, columnScale + NV, 1.0);
+    for (int pass = 0; pass < EQUILIBRATION_PASSES; ++pass) {
+        for (std::size_t c = 0; c < NCONES; ++c) {
+            double largest = 0.0;
+            for (std::size_t r = coneStart[c]; r < coneStart[c] + coneSize[c]; ++r) largest = std::max(largest, rowMax(r));
+            if (largest <= 0.0) continue;
+            for (std::size_t r = coneStart[c]; r < coneStart[c] + coneSize[c]; ++r) scaleRow(r, 1.0 / std::sqrt(largest));
+        }
+        for (std::size_t r = coneRows; r < NROWS; ++r) {
+            double largest = rowMax(r);
+            if (largest > 0.0) scaleRow(r, 1.0 / std::sqrt(largest));
+        }
+        for (std::size_t j = 0; j < NV; ++j) {
+            double largest = 0.0;
+            for (std::size_t r = 0; r < NROWS; ++r) largest = std::max(largest, std::fabs(A[r][j]));
+            if (largest <= 0.0) continue;
+            double s = 1.0 / std::sqrt(largest);
+            for (std::size_t r = 0; r < NROWS; ++r) A[r][j] *= s;
+            columnScale[j] *= s;
+        }
+    }
+
+    // Solver variables are x / columnScale; the cost follows, normalized to unit size
+    double largestCost = 0.0;
+    for (std::size_t j = 0; j < NV; ++j) {
+        q[j] *= columnScale[j];
+        largestCost = std::max(largestCost, std::fabs(q[j]));
+    }
+    if (largestCost > 0.0) {
+        for (std::size_t j = 0; j < NV; ++j) q[j] /= largestCost;
+    }
+
+    for (std::size_t r = 0; r < NROWS; ++r) {
+        bool equality = r >= coneRows && lower[r] == upper[r];
+        rho[r] = equality ? baseRho * EQUALITY_RHO_SCALE : baseRho;
+    }
+    compress();
+    factor();
+}
+
+
+// Row-compressed copy of the equilibrated A: every product below touches only the nonzeros
+template<std::size_t NV, std::size_t NROWS, std::size_t NCONES>
+void ConicAdmm<NV, NROWS, NCONES>::compress() {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < NROWS; ++i) {
+        rowStart[i] = static_cast<uint32_t>(n);
+        for (std::size_t j = 0; j < NV; ++j) {
+            if (A[i][j] == 0.0) continue;
+            values[n] = A[i][j];
+            columns[n++] = static_cast<uint16_t>(j);
+        }
+    }
+    rowStart[NROWS] = static_cast<uint32_t>(n);
+}
+
+
+// L Lᵀ = σI + Aᵀ R A  (dense NV x NV factor, sparse accumulation)
+template<std::size_t NV, std::size_t NROWS, std::size_t NCONES>
+void ConicAdmm<NV, NROWS, NCONES>::factor() {
+    for (std::size_t r = 0; r < NV; ++r) {
+        std::fill(L[r], L[r] + NV, 0.0);
+        L[r][r] = SIGMA;
+    }
+    for (std::size_t i = 0; i < NROWS; ++i) {
+        for (uint32_t a = rowStart[i]; a < rowStart[i + 1]; ++a) {
+            double w = rho[i] * values[a];
+            for (uint32_t b = rowStart[i]; b <= a; ++b) L[columns[a]][columns[b]] += w * values[b];   // columns ascend
+        }
+    }
+
+    for (std::size_t j = 0; j < NV; ++j) {
+        double d = L[j][j];
+        for (std::size_t k = 0; k < j; ++k) d -= L[j][k] * L[j][k];
+        d = std::sqrt(std::max(d, 1e-300));
+        L[j][j] = d;
+        for (std::size_t i = j + 1; i < NV; ++i) {
+            double s = L[i][j];
+            for (std::size_t k = 0; k < j; ++k) s -= L[i][k] * L[j][k];
+            L[i][j] = s / d;
+        }
+    }
+}
+
+
+template<std::size_t NV, std::size_t NROWS, std::size_t NCONES>
+void ConicAdmm<NV, NROWS, NCONES>::multiplyA(const double* v, double* out) const {
+    for (std::size_t i = 0; i < NROWS; ++i) {
+        double s = 0.0;
+        for (uint32_t a = rowStart[i]; a < rowStart[i + 1]; ++a) s += values[a] * v[columns[a]];
+        out[i] = s;
+    }
+}
+
+template<std::size_t NV, std::size_t NROWS, std::size_t NCONES>
+void ConicAdmm<NV, NROWS, NCONES>::multiplyAT(const double* v, double* out) const {
+    std::fill(out, out + NV, 0.0);
+    for (std::size_t i = 0; i < NROWS; ++i) {
+        if (v[i] == 0.0) continue;
+        for (uint32_t a = rowStart[i]; a < rowStart[i + 1]; ++a) out[columns[a]] += values[a] * v[i];
+    }
+}
+
+
+// Π_K: second-order cones {(t, s) : |s| <= t} (shifted by the row offsets), then boxes
+template<std::size_t NV, std::size_t NROWS, std::size_t NCONES>
+void ConicAdmm<NV, NROWS, NCONES>::project(double* w) const {
+    for (std::size_t c = 0; c < NCONES; ++c) {
+        const std::size_t s = coneStart[c], n = coneSize[c];
+        if (n == 0) continue;
+
+        double t = w[s] + offset[s];
+        double norm = 0.0;
+        for (std::size_t r = s + 1; r < s + n; ++r) {
+            double v = w[r] + offset[r];
+            norm += v * v;
+        }
+        norm = std::sqrt(norm);
+
+        if (norm <= t) continue;                        // inside
+        if (norm <= -t) {                               // polar cone: project to the apex
+            for (std::size_t r = s; r < s + n; ++r) w[r] = -offset[r];
+            continue;
+        }
+        double scale = 0.5 * (norm + t);
+        for (std::size_t r = s + 1; r < s + n; ++r) {
+            w[r] = scale * (w[r] + offset[r]) / norm - offset[r];
+        }
+        w[s] = scale - offset[s];
+    }
+    for (std::size_t r = coneRows; r < NROWS; ++r) {
+        w[r] = std::clamp(w[r], lower[r], upper[r]);
+    }
+}
+
+
+template<std::size_t NV, std::size_t NROWS, std::size_t NCONES>
+void ConicAdmm<NV, NROWS, NCONES>::warmStartFromX() {
+    for (std::size_t j = 0; j < NV; ++j) xt[j] = x[j] / columnScale[j];
+    multiplyA(xt, z);
+    project(z);
+}
+
+
+/**
+ * Primal infeasibility certificate (OSQP): the dual step δy = y - y_prev between checks, when
+ * Aᵀδy ≈ 0 and the support function of the constraint set along δy is negative.
+ * Cone rows {w : w + offset ∈ K} contribute -δyᵀ offset when δy lies in -K (SOC is self-dual), box
+ * rows u·max(δy, 0) + l·min(δy, 0).
+ */
+template<std::size_t NV, std::size_t NROWS, std::size_t NCONES>
+bool ConicAdmm<NV, NROWS, NCONES>::certifiesInfeasible(bool havePrevious, double tolerance) {
+    double delta[NROWS];
+    double normDelta = 0.0;
+    for (std::size_t i = 0; i < NROWS; ++i) {
+        delta[i] = y[i] - yPrevious[i];
+        normDelta = std::max(normDelta, std::fabs(delta[i]));
+        yPrevious[i] = y[i];
+    }
+    if (!havePrevious || normDelta <= 1e-12) return false;
+    const double eps = tolerance * normDelta;
+
+    multiplyAT(delta, ATy);
+    for (std::size_t j = 0; j < NV; ++j) {
+        if (std::fabs(ATy[j]) > eps) return false;
+    }
+
+    double support = 0.0;
+    for (std::size_t c = 0; c < NCONES; ++c) {
+        const std::size_t s = coneStart[c], n = coneSize[c];
+        double norm = 0.0;
+        for (std::size_t r = s + 1; r < s + n; ++r) norm += delta[r] * delta[r];
+        if (delta[s] + std::sqrt(norm) > eps) return false;
+        for (std::size_t r = s; r < s + n; ++r) support -= delta[r] * offset[r];
+    }
+    for (std::size_t r = coneRows; r < NROWS; ++r) {
+        if (delta[r] > eps) {
+            if (upper[r] >= INFINITE_BOUND) return false;
+            support += upper[r] * delta[r];
+        } else if (delta[r] < -eps) {
+            if (lower[r] <= -INFINITE_BOUND) return false;
+            support += lower[r] * delta[r];
+        }
+    }
+    return support < -eps;
+}
+
+
+template<std::size_t NV, std::size_t NROWS, std::size_t NCONES>
+typename ConicAdmm<NV, NROWS, NCONES>::Result
+ConicAdmm<NV, NROWS, NCONES>::solve(int maxIterations, Clock::time_point deadline, double tolerance) {
+    Result result;
+    double w[NROWS];
+    for (std::size_t j = 0; j < NV; ++j) x[j] /= columnScale[j];
+    std::copy(y, y + NROWS, yPrevious);
+
+    for (int iteration = 1; iteration <= maxIterations; ++iteration) {
+        // x̃ = (σI + AᵀRA)⁻¹ (σx - q + Aᵀ(Rz - y))
+        for (std::size_t i = 0; i < NROWS; ++i) w[i] = rho[i] * z[i] - y[i];
+        multiplyAT(w, rhs);
+        for (std::size_t j = 0; j < NV; ++j) rhs[j] += SIGMA * x[j] - q[j];
+
+        for (std::size_t i = 0; i < NV; ++i) {              // L u = rhs
+            double s = rhs[i];
+            for (std::size_t k = 0; k < i; ++k) s -= L[i][k] * xt[k];
+            xt[i] = s / L[i][i];
+        }
+        for (std::size_t i = NV; i-- > 0;) {                // Lᵀ x̃ = u
+            double s = xt[i];
+            for (std::size_t k = i + 1; k < NV; ++k) s -= L[k][i] * xt[k];
+            xt[i] = s / L[i][i];
+        }
+
+        // Relaxed z / y updates
+        multiplyA(xt, Ax);
+        for (std::size_t j = 0; j < NV; ++j) x[j] = RELAXATION * xt[j] + (1.0 - RELAXATION) * x[j];
+        for (std::size_t i = 0; i < NROWS; ++i) {
+            Ax[i] = RELAXATION * Ax[i] + (1.0 - RELAXATION) * z[i];
+            w[i] = Ax[i] + y[i] / rho[i];
+        }
+        project(w);
+        for (std::size_t i = 0; i < NROWS; ++i) {
+            y[i] += rho[i] * (Ax[i] - w[i]);
+            z[i] = w[i];
+        }
+
+        result.iterations = iteration;
+        if (iteration % CHECK_INTERVAL != 0 && iteration != maxIterations) continue;
+
+        // Residuals (∞-norm, OSQP termination)
+        multiplyA(x, Ax);
+        multiplyAT(y, ATy);
+        double primal = 0.0, normAx = 0.0, normZ = 0.0, dual = 0.0, normATy = 0.0, normQ = 0.0;
+        for (std::size_t i = 0; i < NROWS; ++i) {
+            primal = std::max(primal, std::fabs(Ax[i] - z[i]));
+            normAx = std::max(normAx, std::fabs(Ax[i]));
+            normZ = std::max(normZ, std::fabs(z[i]));
+        }
+        for (std::size_t j = 0; j < NV; ++j) {
+            dual = std::max(dual, std::fabs(q[j] + ATy[j]));
+            normATy = std::max(normATy, std::fabs(ATy[j]));
+            normQ = std::max(normQ, std::fabs(q[j]));
+        }
+        result.primalResidual = primal;
+        result.dualResidual = dual;
+
+        double primalScale = std::max(normAx, normZ);
+        double dualScale = std::max(normATy, normQ);
+        if (primal <= tolerance * (1.0 + primalScale) && dual <= tolerance * (1.0 + dualScale)) {
+            result.converged = true;
+            break;
+        }
+        if (certifiesInfeasible(iteration > CHECK_INTERVAL, tolerance)) {
+            result.infeasible = true;
+            break;
+        }
+        if (Clock::now() >= deadline) break;
+
+        if (iteration % ADAPT_INTERVAL == 0) {
+            double ratio = std::sqrt((primal / std::max(primalScale, 1e-12)) / std::max(dual / std::max(dualScale, 1e-12), 1e-12));
+            if (ratio > 5.0 || ratio < 0.2) {
+                double updated = std::clamp(baseRho * ratio, 1e-6, 1e6);
+                for (std::size_t r = 0; r < NROWS; ++r) rho[r] *= updated / baseRho;
+                baseRho = updated;
+                factor();
+            }
+        }
+    }
+
+    for (std::size_t j = 0; j < NV; ++j) x[j] *= columnScale[j];
+    if (!result.converged) baseRho = DEFAULT_RHO;   // do not carry a runaway ρ into the next problem
+    if (result.infeasible) std::fill(y, y + NROWS, 0.0);
+    return result;
+}
+
+
+
+/**
+==========================================
+    Landing Guidance
+==========================================
+*/
+const char* landingStatusName(LandingStatus status) {
+    switch (status) {
+        case LandingStatus::IDLE:          return "Idle";
+        case LandingStatus::SEARCHING:     return "Searching";
+        case LandingStatus::SOLVED:        return "Solved";
+        case LandingStatus::INACCURATE:    return "Inaccurate (flying best iterate)";
+        case LandingStatus::INFEASIBLE:    return "Infeasible";
+        case LandingStatus::NO_PROPELLANT: return "No Propellant";
+        default:                           return "Unknown";
+    }
+}
+
+
+LandingGuidance::LandingGuidance(const LandingVehicle& vehicle) : vehicle(vehicle) {
+    reset();
+}
+
+
+// Plan and engagement are dropped; solve logs are kept (they span every landing)
+void LandingGuidance::reset() {
+    engaged = false;
+    status = LandingStatus::IDLE;
+    nextStretch = 0;
+    search.active = false;
+    planStart = planDuration = plannedFuel = 0.0;
+    std::fill(planControls, planControls + NV, 0.0);
+    std::fill(solver.x, solver.x + NV, 0.0);
+    std::fill(solver.y, solver.y + ROWS, 0.0);
+    std::fill(solver.z, solver.z + ROWS, 0.0);
+}
+
+
+/**
+ * SOCP for landing in `timeOfFlight` from `state` (variables per node k: σ_k, u_k,up, u_k,downrange)
+ *     r_k = r0 + v0 t_k + ½ g t_k² + Σ_{j<k} Δt² (k - j - ½) u_j        v_k = v0 + g t_k + Σ_{j<k} Δt u_j
+ *     z_k = ln m0 - α Δt Σ_{j<k} σ_j
+ */
+void LandingGuidance::build(const LandingState& state, double timeOfFlight) {
+    solver.clear();
+
+    const double dt = timeOfFlight / NODES;
+    const double alpha = 1.0 / (vehicle.isp * STANDARD_GRAVITY);
+    const double rho1 = vehicle.minThrottle * vehicle.maxThrust;
+    const double rho2 = vehicle.maxThrust;
+    const double z0 = std::log(state.mass);
+    const double gravity[DIMS] = {-state.gravity, 0.0};
+    const double tanGlide = std::tan(vehicle.glideSlope);
+
+    auto sigma = [](std::size_t k) { return 3 * k; };
+    auto accel = [](std::size_t k, std::size_t d) { return 3 * k + 1 + d; };
+    auto drift = [&](std::size_t d, double t) {   // unforced position
+        return state.position[d] + state.velocity[d] * t + 0.5 * gravity[d] * t * t;
+    };
+
+    // Objective: propellant ∝ Σ σ_k Δt
+    for (std::size_t k = 0; k < NODES; ++k) solver.q[sigma(k)] = dt;
+
+    std::size_t row = 0, cone = 0;
+
+    // |u_k| <= σ_k
+    for (std::size_t k = 0; k < NODES; ++k, ++cone) {
+        solver.coneStart[cone] = row;
+        solver.coneSize[cone] = DIMS + 1;
+        solver.A[row++][sigma(k)] = 1.0;
+        for (std::size_t d = 0; d < DIMS; ++d) solver.A[row++][accel(k, d)] = 1.0;
+    }
+
+    // Glide slope at interior nodes: tan γ |r_downrange| <= r_up
+    for (std::size_t k = 1; k < NODES; ++k, ++cone) {
+        solver.coneStart[cone] = row;
+        solver.coneSize[cone] = DIMS;
+        const double t = k * dt;
+        for (std::size_t j = 0; j < k; ++j) {
+            double c = dt * dt * (k - j - 0.5);
+            solver.A[row][accel(j, 0)] = c;
+            solver.A[row + 1][accel(j, 1)] = tanGlide * c;
+        }
+        solver.offset[row] = drift(0, t);
+        solver.offset[row + 1] = tanGlide * drift(1, t);
+        row += DIMS;
+    }
+    solver.coneRows = row;
+
+    // Thrust bounds, linearized about z0_k = ln(m0 - α ρ2 t_k):  μ1 (1 - (z_k - z0_k)) <= σ_k <= μ2 (1 - (z_k - z0_k))
+    for (std::size_t k = 0; k < NODES; ++k) {
+        double zk = std::log(std::max(state.mass - alpha * rho2 * k * dt, vehicle.dryMass));
+        double mu1 = rho1 * std::exp(-zk);
+        double mu2 = rho2 * std::exp(-zk);
+
+        solver.A[row][sigma(k)] = 1.0;
+        solver.A[row + 1][sigma(k)] = 1.0;
+        for (std::size_t j = 0; j < k; ++j) {
+            solver.A[row][sigma(j)] = -mu1 * alpha * dt;
+            solver.A[row + 1][sigma(j)] = -mu2 * alpha * dt;
+        }
+        solver.lower[row] = mu1 * (1.0 - z0 + zk);
+        solver.upper[row + 1] = mu2 * (1.0 - z0 + zk);
+        row += 2;
+    }
+
+    // Pointing: u_k,up >= cos θ σ_k
+    for (std::size_t k = 0; k < NODES; ++k) {
+        solver.A[row][accel(k, 0)] = 1.0;
+        solver.A[row][sigma(k)] = -std::cos(vehicle.maxTilt);
+        solver.lower[row++] = 0.0;
+    }
+
+    // Terminal: on the pad, at rest
+    for (std::size_t d = 0; d < DIMS; ++d) {
+        for (std::size_t j = 0; j < NODES; ++j) solver.A[row][accel(j, d)] = dt * dt * (NODES - j - 0.5);
+        solver.lower[row] = solver.upper[row] = -drift(d, timeOfFlight);
+        row++;
+    }
+    for (std::size_t d = 0; d < DIMS; ++d) {
+        for (std::size_t j = 0; j < NODES; ++j) solver.A[row][accel(j, d)] = dt;
+        solver.lower[row] = solver.upper[row] = -(state.velocity[d] + gravity[d] * timeOfFlight);
+        row++;
+    }
+
+    // Final mass >= dry mass
+    for (std::size_t j = 0; j < NODES; ++j) solver.A[row][sigma(j)] = 1.0;
+    solver.upper[row++] = (z0 - std::log(vehicle.dryMass)) / (alpha * dt);
+
+    solver.prepare();
+}
+
+
+// Unconverged iterates are only accepted (as INACCURATE) while a plan is already being flown
+bool LandingGuidance::solveFor(const LandingState& state, double timeOfFlight, bool warm, bool flying, SolveLog& log, double& fuel) {
+    const auto start = Clock::now();
+
+    build(state, timeOfFlight);
+    if (warm) {
+        solver.warmStartFromX();
+    } else {
+        std::fill(solver.x, solver.x + NV, 0.0);
+        std::fill(solver.y, solver.y + ROWS, 0.0);
+        std::fill(solver.z, solver.z + ROWS, 0.0);
+    }
+    auto deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(SOLVE_BUDGET));
+    Solver::Result result = solver.solve(MAX_ITERATIONS, deadline, flying ? RESOLVE_TOLERANCE : TOLERANCE);
+
+    double sum = 0.0;
+    for (std::size_t k = 0; k < NODES; ++k) sum += solver.x[3 * k];
+    double dt = timeOfFlight / NODES;
+    fuel = state.mass * (1.0 - std::exp(-dt * sum / (vehicle.isp * STANDARD_GRAVITY)));
+
+    bool usable = result.converged || (flying && !result.infeasible && result.primalResidual < INACCURATE_RESIDUAL);
+    Outcome outcome = result.converged ? Outcome::CONVERGED : result.infeasible ? Outcome::INFEASIBLE : Outcome::CAPPED;
+    log.add(std::chrono::duration<double, std::milli>(Clock::now() - start).count(), result.iterations, outcome);
+    cycleSolves++;
+    if (usable && !result.converged) status = LandingStatus::INACCURATE;
+    return usable;
+}
+
+
+void LandingGuidance::storePlan(double start, double duration, double fuel) {
+    std::copy(solver.x, solver.x + NV, planControls);
+    planStart = start;
+    planDuration = duration;
+    plannedFuel = fuel;
+}
+
+
+// Previous plan resampled onto the new node times (zero-order hold)
+void LandingGuidance::shiftWarmStart(double newStart, double newDuration) {
+    const double oldDt = planDuration / NODES;
+    const double newDt = newDuration / NODES;
+    for (std::size_t k = 0; k < NODES; ++k) {
+        double t = newStart + (k + 0.5) * newDt - planStart;
+        std::size_t old = static_cast<std::size_t>(std::clamp(t / oldDt, 0.0, static_cast<double>(NODES - 1)));
+        for (std::size_t v = 0; v < DIMS + 1; ++v) solver.x[3 * k + v] = planControls[3 * old + v];
+    }
+}
+
+
+/**
+==========================================
+    Ignition Search, Then Warm Re-Solves
+==========================================
+
+Every call does at most CYCLE_BUDGET of solver work: a solve only starts while a capped one (SOLVE_BUDGET)
+still fits. The search resumes where the previous call stopped; a re-solve attempt that does not fit is
+retried on the next call from the then-measured state.
+*/
+LandingStatus LandingGuidance::update(const LandingState& state) {
+    const auto cycleStart = Clock::now();
+    const auto cycleDeadline = cycleStart + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(CYCLE_BUDGET));
+    auto fits = [&cycleDeadline]() {
+        return Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(SOLVE_BUDGET)) <= cycleDeadline;
+    };
+    cycleSolves = 0;
+
+    if (engaged) {
+        resolve(state, cycleDeadline);
+    } else {
+        if (!search.active) beginSearch(state);
+        if (search.active) {
+            search.cycles++;
+            // Solves only while the plan can still start on time, within the cycle cap
+            bool inTime = state.time < search.start.time && search.cycles <= MAX_SEARCH_CYCLES;
+            while (inTime && search.stage != SearchStage::DONE && fits()) searchStep();
+            search.milliseconds += std::chrono::duration<double, std::milli>(Clock::now() - cycleStart).count();
+            if (search.stage == SearchStage::DONE || !inTime || search.cycles >= MAX_SEARCH_CYCLES) finishSearch();
+        }
+    }
+
+    if (cycleSolves > 0) {
+        cycleLog.add(std::chrono::duration<double, std::milli>(Clock::now() - cycleStart).count(), cycleSolves, Outcome::CONVERGED);
+    }
+    return status;
+}
+
+
+// The burn is planned from the free-fall state at ignition, SEARCH_LEAD from now (drag is left to the re-solves)
+void LandingGuidance::beginSearch(const LandingState& state) {
+    const double alpha = 1.0 / (vehicle.isp * STANDARD_GRAVITY);
+    const double rho1 = vehicle.minThrottle * vehicle.maxThrust;
+    const double rho2 = vehicle.maxThrust;
+
+    double propellant = state.mass - vehicle.dryMass;
+    if (propellant <= 1.0) {
+        status = LandingStatus::NO_PROPELLANT;
+        return;
+    }
+
+    LandingState start = state;
+    start.time = state.time + SEARCH_LEAD;
+    start.position[0] += state.velocity[0] * SEARCH_LEAD - 0.5 * state.gravity * SEARCH_LEAD * SEARCH_LEAD;
+    start.position[1] += state.velocity[1] * SEARCH_LEAD;
+    start.velocity[0] -= state.gravity * SEARCH_LEAD;
+
+    // G-FOLD bounds: no faster than full thrust can null the velocity, no longer than the propellant lasts at min throttle
+    double speed = std::hypot(start.velocity[0], start.velocity[1]);
+    double tMin = std::max(vehicle.dryMass * speed / rho2, 1.0);
+    double tMax = propellant / (alpha * rho1);
+    if (tMax <= tMin || start.position[0] <= 0.0) {
+        status = LandingStatus::INFEASIBLE;
+        return;
+    }
+
+    search = Search{};
+    search.active = true;
+    search.start = start;
+    search.tMin = tMin;
+    search.tMax = tMax;
+    status = LandingStatus::SEARCHING;
+}
+
+
+/**
+ * One solve of the search. Grid from the shortest time of flight up, each solve warm started from the last
+ * feasible one; fuel is unimodal in the time of flight (Blackmore 2010), so the grid stops once it starts
+ * rising again. Then golden-section refinement inside the neighbouring grid cells (one new interior point
+ * per step, the other is carried over) and a final solve at the refined time, kept only if it beats the best
+ * grid point.
+ */
+void LandingGuidance::searchStep() {
+    Search& s = search;
+    const LandingState& state = s.start;
+    const double ratio = 0.5 * (std::sqrt(5.0) - 1.0);
+    double fuel = 0.0;
+    s.solves++;
+
+    auto refine = [&s, ratio]() {
+        const double cell = (s.tMax - s.tMin) / SEARCH_POINTS;
+        s.lo = std::max(s.tMin, s.bestTime - cell);
+        s.hi = std::min(s.tMax, s.bestTime + cell);
+        s.a = s.hi - ratio * (s.hi - s.lo);
+        s.b = s.lo + ratio * (s.hi - s.lo);
+        s.stage = !s.found ? SearchStage::DONE : GOLDEN_STEPS > 0 ? SearchStage::GOLDEN : SearchStage::FINAL;
+    };
+    auto keep = [&s, this](double tf, double fuel) {
+        s.bestFuel = fuel;
+        s.bestTime = tf;
+        std::copy(solver.x, solver.x + NV, s.bestControls);
+        s.found = true;
+    };
+
+    switch (s.stage) {
+        case SearchStage::GRID: {
+            double tf = s.tMin + (s.tMax - s.tMin) * (s.point + 0.5) / SEARCH_POINTS;
+            s.point++;
+            bool ok = solveFor(state, tf, s.found, false, searchLog, fuel);
+            if (ok && !(s.found && fuel >= s.bestFuel)) {
+                keep(tf, fuel);
+                if (s.point >= SEARCH_POINTS) refine();
+            } else if (s.found || s.point >= SEARCH_POINTS) {
+                refine();
+            }
+            break;
+        }
+        case SearchStage::GOLDEN:
+            std::copy(s.bestControls, s.bestControls + NV, solver.x);
+            if (!s.haveA) {
+                s.okA = solveFor(state, s.a, true, false, searchLog, s.fuelA);
+                s.haveA = true;
+            } else {
+                s.okB = solveFor(state, s.b, true, false, searchLog, s.fuelB);
+                s.haveB = true;
+            }
+            if (!(s.haveA && s.haveB)) break;
+
+            if (s.okA && (!s.okB || s.fuelA <= s.fuelB)) {
+                s.hi = s.b;
+                s.b = s.a, s.fuelB = s.fuelA, s.okB = s.okA;
+                s.a = s.hi - ratio * (s.hi - s.lo);
+                s.haveA = false;
+            } else {
+                s.lo = s.a;
+                s.a = s.b, s.fuelA = s.fuelB, s.okA = s.okB;
+                s.b = s.lo + ratio * (s.hi - s.lo);
+                s.haveB = false;
+            }
+            if (++s.step >= GOLDEN_STEPS) s.stage = SearchStage::FINAL;
+            break;
+        case SearchStage::FINAL: {
+            double refined = 0.5 * (s.lo + s.hi);
+            std::copy(s.bestControls, s.bestControls + NV, solver.x);
+            if (solveFor(state, refined, true, false, searchLog, fuel) && fuel <= s.bestFuel) keep(refined, fuel);
+            s.stage = SearchStage::DONE;
+            break;
+        }
+        case SearchStage::DONE:
+            break;
+    }
+}
+
+
+// Engages on the best point found so far (the search may have been cut short); nothing found is retried next call
+void LandingGuidance::finishSearch() {
+    search.active = false;
+    if (!search.found) {
+        status = LandingStatus::INFEASIBLE;
+        ignitionLog.add(search.milliseconds, search.solves, Outcome::INFEASIBLE);
+        return;
+    }
+    ignitionLog.add(search.milliseconds, search.solves, Outcome::CONVERGED);
+
+    std::copy(search.bestControls, search.bestControls + NV, solver.x);
+    storePlan(search.start.time, search.bestTime, search.bestFuel);
+    engaged = true;
+    status = LandingStatus::SOLVED;
+    nextStretch = 0;
+    ignitionTime = lastSolveTime = search.start.time;
+}
+
+
+// Same landing time from the measured state; if disturbances made that infeasible, allow 5 % longer
+LandingStatus LandingGuidance::resolve(const LandingState& state, Clock::time_point cycleDeadline) {
+    static constexpr double STRETCH[] = {1.0, 1.05};
+
+    double timeToGo = planStart + planDuration - state.time;
+    bool due = nextStretch > 0 || state.time - lastSolveTime >= 1.0 / RESOLVE_RATE - 1e-9;
+    if (!due || state.time < planStart || timeToGo <= TERMINAL_TIME) {
+        return status;   // before ignition / between re-solves / terminal phase: keep flying the current plan
+    }
+    lastSolveTime = state.time;
+
+    for (int attempt = nextStretch; attempt < static_cast<int>(std::size(STRETCH)); ++attempt) {
+        if (attempt > nextStretch &&
+            Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(SOLVE_BUDGET)) > cycleDeadline) {
+            nextStretch = attempt;   // out of cycle budget: next call, from the newer state
+            return status;
+        }
+        double tf = timeToGo * STRETCH[attempt], fuel = 0.0;
+        shiftWarmStart(state.time, tf);
+        LandingStatus previous = status;
+        status = LandingStatus::SOLVED;
+        if (solveFor(state, tf, true, true, resolveLog, fuel)) {
+            storePlan(state.time, tf, fuel);
+            nextStretch = 0;
+            return status;
+        }
+        status = previous;
+    }
+    nextStretch = 0;
+    status = LandingStatus::INFEASIBLE;   // keep the previous plan
+    return status;
+}
+
+
+LandingGuidance::Snapshot LandingGuidance::snapshot() const {
+    Snapshot snapshot;
+    snapshot.engaged = engaged;
+    snapshot.status = status;
+    snapshot.ignitionTime = ignitionTime;
+    snapshot.lastSolveTime = lastSolveTime;
+    snapshot.nextStretch = nextStretch;
+    snapshot.search = search;
+    snapshot.planStart = planStart;
+    snapshot.planDuration = planDuration;
+    snapshot.plannedFuel = plannedFuel;
+    std::copy(planControls, planControls + NV, snapshot.planControls.begin());
+    std::copy(solver.x, solver.x + NV, snapshot.x.begin());
+    std::copy(solver.z, solver.z + ROWS, snapshot.z.begin());
+    std::copy(solver.y, solver.y + ROWS, snapshot.y.begin());
+    snapshot.rho = solver.getBaseRho();
+    return snapshot;
+}
+
+
+void LandingGuidance::restore(const Snapshot& snapshot) {
+    engaged = snapshot.engaged;
+    status = snapshot.status;
+    ignitionTime = snapshot.ignitionTime;
+    lastSolveTime = snapshot.lastSolveTime;
+    nextStretch = snapshot.nextStretch;
+    search = snapshot.search;
+    planStart = snapshot.planStart;
+    planDuration = snapshot.planDuration;
+    plannedFuel = snapshot.plannedFuel;
+    std::copy(snapshot.planControls.begin(), snapshot.planControls.end(), planControls);
+    std::copy(snapshot.x.begin(), snapshot.x.end(), solver.x);
+    std::copy(snapshot.z.begin(), snapshot.z.end(), solver.z);
+    std::copy(snapshot.y.begin(), snapshot.y.end(), solver.y);
+    solver.setBaseRho(snapshot.rho);
+}
+
+
+// Plan averaged over [time, time + period]: the command held for one control period delivers the planned Δv
+// even when the node spacing differs from the control rate (and the windows covering ignition and the end of the plan)
+LandingCommand LandingGuidance::command(double time, double period) const {
+    LandingCommand command;
+    const double end = planStart + planDuration;
+    if (!engaged || time + period <= planStart || time >= end) return command;
+
+    const double dt = planDuration / NODES;
+    const double windowEnd = std::min(time + period, end);
+    for (std::size_t k = static_cast<std::size_t>(std::max(time - planStart, 0.0) / dt); k < NODES; ++k) {
+        double nodeStart = planStart + k * dt;
+        if (nodeStart >= windowEnd) break;
+        double weight = std::max(std::min(nodeStart + dt, windowEnd) - std::max(nodeStart, time), 0.0) / period;
+        command.throttleAcceleration += weight * planControls[3 * k];
+        command.acceleration[0] += weight * planControls[3 * k + 1];
+        command.acceleration[1] += weight * planControls[3 * k + 2];
+    }
+    // An unconverged or loosely converged plan can leave |u| a hair above σ: never burn less than the thrust flown
+    command.throttleAcceleration = std::max(command.throttleAcceleration, std::hypot(command.acceleration[0], command.acceleration[1]));
+    command.active = true;
+    command.timeToGo = end - time;
+    return command;
+}
+
+
+
+/**
+==========================================
+    Solve-Time Report
+==========================================
+*/
+void LandingGuidance::SolveLog::add(double ms, int iters, Outcome outcome) {
+    milliseconds[count % CAPACITY] = static_cast<float>(ms);
+    iterations[count % CAPACITY] = static_cast<uint16_t>(std::min(iters, 65535));
+    outcomes[count % CAPACITY] = outcome;
+    count++;
+    total++;
+    if (outcome == Outcome::INFEASIBLE) infeasible++;
+    if (outcome == Outcome::CAPPED) capped++;
+}
+
+
+// Percentiles over every logged entry and over the converged ones alone (a capped solve sits at the time cap)
+void LandingGuidance::report(double cycleBudgetMs) const {
+    auto print = [](const char* name, const char* unit, const char* countName, const SolveLog& log, double budgetMs, bool outcomes) {
+        if (log.total == 0) return;
+        const std::size_t n = std::min(log.count, SolveLog::CAPACITY);
+        std::array<float, SolveLog::CAPACITY> all = log.milliseconds, converged{};
+        std::size_t m = 0;
+        double iterations = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            iterations += log.iterations[i];
+            if (log.outcomes[i] == Outcome::CONVERGED) converged[m++] = log.milliseconds[i];
+        }
+        std::sort(all.begin(), all.begin() + n);
+        std::sort(converged.begin(), converged.begin() + m);
+        auto percentiles = [](const std::array<float, SolveLog::CAPACITY>& sorted, std::size_t size) {
+            auto at = [&](double p) { return sorted[std::min(size - 1, static_cast<std::size_t>(p * (size - 1) + 0.5))]; };
+            std::ostringstream out;
+            out << std::fixed << std::setprecision(3) << "p50: " << at(0.50) << " ms | p90: " << at(0.90)
+                << " ms | p99: " << at(0.99) << " ms | max: " << sorted[size - 1] << " ms";
+            return out.str();
+        };
+
+        std::cout << "[GNC] " << name << ": " << log.total << " " << unit;
+        if (outcomes) {
+            std::cout << " (" << log.total - log.infeasible - log.capped << " converged, " << log.infeasible
+                      << " certified infeasible, " << log.capped << " capped)";
+        }
+        std::cout << " | " << countName << " avg: " << std::fixed << std::setprecision(0) << iterations / n
+                  << " | " << percentiles(all, n) << " | " << (all[n - 1] <= budgetMs ? "fits" : "EXCEEDS") << " the "
+                  << budgetMs << " ms budget\n" << std::defaultfloat;
+        if (outcomes && m > 0 && m < n) std::cout << "[GNC]     converged only: " << percentiles(converged, m) << "\n";
+    };
+
+    const double cycleMs = CYCLE_BUDGET * 1000.0;
+    print("Landing ignition search", "solves", "Iterations", searchLog, cycleMs, true);
+    print("Landing ignition (whole search)", "searches", "Solves", ignitionLog, MAX_SEARCH_CYCLES * cycleMs, false);
+    print("Landing re-solves (warm)", "solves", "Iterations", resolveLog, cycleMs, true);
+    print("Landing guidance per cycle", "cycles", "Solves", cycleLog, std::min(cycleMs, cycleBudgetMs), false);
+}
+
+
+
+
+/**
+==========================================
+    Closed-Loop Landing Benchmark (--bench-landing)
+==========================================
+
+Dispersed landing burns flown against the FlightDynamics vertical channel (drag included - the guidance
+does not model it) plus a downrange double integrator, at the 10 Hz flight cycle with 5 Hz re-solves.
+*/
+void LandingGuidance::benchmark(const LandingVehicle& vehicle, double dragArea, int runs) {
+    constexpr double CYCLE = 0.1;
+    constexpr int PLANT_STEPS = 10;              // the plant is integrated finer than the guidance cycle
+    constexpr double SAFE_SPEED = 3.0;           // m/s at touchdown (landing legs)
+    constexpr double SAFE_MISS = 5.0;            // m from the pad
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<double> altitude(2000.0, 3000.0), descent(-220.0, -150.0),
+        downrange(-300.0, 300.0), drift(-15.0, 15.0), propellant(5000.0, 8000.0);
+
+    LandingGuidance guidance(vehicle);
+    int landed = 0, infeasible = 0;
+    double worstSpeed = 0.0, worstMiss = 0.0, sumSpeed = 0.0, sumFuelError = 0.0;
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "     Powered Landing Guidance Bench     " << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "[BENCH] " << runs << " landings | Dry mass: " << vehicle.dryMass << " kg | Thrust: "
+              << vehicle.maxThrust << " N (" << vehicle.minThrottle * 100.0 << "-100 %) | Isp: " << vehicle.isp << " s\n";
+
+    for (int run = 0; run < runs; ++run) {
+        double fuel0 = propellant(random);
+        FlightDynamics plant(vehicle.dryMass + fuel0, 0.0, 0.0, vehicle.isp, dragArea);
+        FlightDynamics::State s = plant.getState();
+        s.altitude = altitude(random);
+        s.velocity = descent(random);
+        s.fuel = fuel0;
+        plant.setState(s);
+        double x = downrange(random), vx = drift(random);
+
+        guidance.reset();
+        double time = 0.0, ignitionPlan = 0.0;
+        bool touchdown = false;
+        while (time < 120.0 && !touchdown) {
+            s = plant.getState();
+            s.mass = vehicle.dryMass + s.fuel;     // the plant's mass follows the propellant
+            plant.setState(s);
+
+            LandingState state;
+            state.time = time;
+            state.position[0] = s.altitude;
+            state.position[1] = x;
+            state.velocity[0] = s.velocity;
+            state.velocity[1] = vx;
+            state.mass = s.mass;
+            state.gravity = s.gravity;
+            bool wasEngaged = guidance.isEngaged();
+            guidance.update(state);                 // an ignition search that finds nothing is retried next cycle
+            if (!wasEngaged && guidance.isEngaged()) ignitionPlan = guidance.plannedPropellant();
+
+            LandingCommand command = guidance.command(time, CYCLE);
+            double ax = command.active ? command.acceleration[1] : 0.0;
+            plant.setThrust(command.active ? command.acceleration[0] * s.mass : 0.0);
+            plant.setBurnRate(command.active ? command.throttleAcceleration * s.mass / (vehicle.isp * STANDARD_GRAVITY) : 0.0);
+
+            for (int step = 0; step < PLANT_STEPS && !touchdown; ++step) {
+                plant.integrate(CYCLE / PLANT_STEPS);
+                touchdown = plant.getAltitude() <= 0.0;
+            }
+            x += vx * CYCLE + 0.5 * ax * CYCLE * CYCLE;
+            vx += ax * CYCLE;
+            time += CYCLE;
+        }
+
+        if (!guidance.isEngaged()) {
+            infeasible++;
+            continue;
+        }
+        double speed = std::hypot(plant.getVelocity(), vx);
+        double miss = std::fabs(x);
+        if (touchdown && speed < SAFE_SPEED && miss < SAFE_MISS) landed++;
+        worstSpeed = std::max(worstSpeed, speed);
+        worstMiss = std::max(worstMiss, miss);
+        sumSpeed += speed;
+        sumFuelError += (fuel0 - plant.getFuel()) - ignitionPlan;
+    }
+
+    int flown = runs - infeasible;
+    std::cout << std::fixed << std::setprecision(2)
+              << "[BENCH] Landed (< " << SAFE_SPEED << " m/s, < " << SAFE_MISS << " m): " << landed << " / " << flown
+              << " flown | Never ignited: " << infeasible << "\n"
+              << "[BENCH] Touchdown speed avg: " << (flown ? sumSpeed / flown : 0.0) << " m/s, worst: " << worstSpeed
+              << " m/s | Worst miss: " << worstMiss << " m | Propellant over the ignition plan: "
+              << (flown ? sumFuelError / flown : 0.0) << " kg avg\n" << std::defaultfloat;
+    guidance.report(CYCLE * 1000.0);
+}
@@ -0,0 +1,257 @@
+#ifndef LANDING_GUIDANCE_H
+#define LANDING_GUIDANCE_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+
+
+// Landing-burn vehicle limits
+struct LandingVehicle {
+    double dryMass = 25600.0;       // kg
+    double maxThrust = 845000.0;    // N (landing engine(s) at full throttle)
+    double minThrottle = 0.4;       // fraction of maxThrust; the engine cannot throttle lower without shutting down
+    double isp = 288.0;             // s
+    double maxTilt = 0.35;          // rad, thrust direction from vertical
+    double glideSlope = 0.07;       // rad, minimum elevation of the vehicle as seen from the pad
+};
+
+// Axes: [0] up, [1] downrange (landing pad at the origin)
+struct LandingState {
+    double time = 0.0;              // s
+    double position[2] = {0.0, 0.0};
+    double velocity[2] = {0.0, 0.0};
+    double mass = 0.0;              // kg (wet)
+    double gravity = 9.80665;       // m/s²
+};
+
+enum class LandingStatus { IDLE, SEARCHING, SOLVED, INACCURATE, INFEASIBLE, NO_PROPELLANT };
+const char* landingStatusName(LandingStatus status);
+
+struct LandingCommand {
+    bool active = false;            // false: engine off (not engaged, or past the end of the plan)
+    double acceleration[2] = {0.0, 0.0};   // thrust / mass (m/s²)
+    double throttleAcceleration = 0.0;     // Γ / m, the magnitude slack (>= |acceleration|, equal at the optimum)
+    double timeToGo = 0.0;          // s
+};
+
+
+
+/**
+==========================================
+    Fixed-Size Conic Solver (ADMM)
+==========================================
+
+- Solves  min q'x  s.t.  Ax + b ∈ K,  K = product of second-order cones and boxes, by the OSQP splitting:
+      (σI + A'RA) x̃ = σx - q + A'(Rz - y)       (one Cholesky factor per problem / ρ update)
+      z ← Π_K(α Ax̃ + (1-α)z + R⁻¹y),  y ← y + R(α Ax̃ + (1-α)z - z)
+- Sizes are compile-time constants and every array is a member: no heap, bounded work per iteration
+  (products run over a row-compressed copy of A),
+  and a hard iteration / wall-clock cap on every solve.
+- Member definitions live in landing_guidance.cpp, the only place the template is instantiated.
+- Ruiz equilibration of rows (one factor per cone block) and columns when the problem is built; `x` is
+  always in problem units outside solve(). Equality rows get ρ x 1e3; ρ adapts to the primal/dual
+  residual ratio every ADAPT_INTERVAL iterations.
+- Infeasible problems are detected from the dual iterates (OSQP certificate) instead of running out the cap.
+*/
+template<std::size_t NV, std::size_t NROWS, std::size_t NCONES>
+class ConicAdmm {
+public:
+    static constexpr double INFINITE_BOUND = 1e20;
+    static constexpr double DEFAULT_RHO = 0.01;
+    static constexpr int EQUILIBRATION_PASSES = 3;
+
+    struct Result {
+        bool converged = false;
+        bool infeasible = false;            // primal infeasibility certificate found
+        int iterations = 0;
+        double primalResidual = 0.0;
+        double dualResidual = 0.0;
+    };
+
+    // Problem data (filled by the caller, then prepare())
+    double A[NROWS][NV];
+    double lower[NROWS], upper[NROWS];      // box rows; cone rows use `offset` instead
+    double offset[NROWS];
+    double q[NV];
+    std::array<std::size_t, NCONES> coneStart{}, coneSize{};
+    std::size_t coneRows = 0;               // cone blocks occupy rows [0, coneRows)
+
+    // Iterates (kept between solves for warm starts)
+    double x[NV], z[NROWS], y[NROWS];
+
+    void clear();
+    void prepare();                         // equilibrate + factor
+    void warmStartFromX();                  // z = Π(Ax), keeps y
+    double getBaseRho() const { return baseRho; }
+    void setBaseRho(double value) { baseRho = value; }
+    Result solve(int maxIterations, std::chrono::steady_clock::time_point deadline, double tolerance);
+
+private:
+    double rho[NROWS];
+    double baseRho = DEFAULT_RHO;           // kept across solves for warm starts, reset after a failure
+    double columnScale[NV];                 // x = columnScale * solver variable
+    double values[NROWS * NV];              // A by rows, nonzeros only (capacity = dense size)
+    uint16_t columns[NROWS * NV];
+    uint32_t rowStart[NROWS + 1];
+    double L[NV][NV];                       // Cholesky factor of σI + A'RA
+    double rhs[NV], xt[NV], Ax[NROWS], ATy[NV];
+    double yPrevious[NROWS];                // y at the previous residual check (infeasibility test)
+
+    void compress();
+    void factor();
+    bool certifiesInfeasible(bool havePrevious, double tolerance);
+    void project(double* w) const;
+    void multiplyA(const double* v, double* out) const;
+    void multiplyAT(const double* v, double* out) const;
+};
+
+
+
+/**
+==========================================
+    Powered-Descent Landing Guidance (G-FOLD style)
+==========================================
+
+- Fuel-optimal landing by lossless convexification: with u = T/m, σ = Γ/m and z = ln m the non-convex
+  thrust bounds ρ1 <= |T| <= ρ2 become |u| <= σ plus bounds on σ linear in z, and the mass equation
+  ż = -σ/(Isp g0) is linear, so the whole problem is one SOCP over N fixed nodes (zero-order hold).
+- Constraints: thrust magnitude (min and max throttle), thrust pointing cone, glide slope, pinned
+  terminal position / velocity, final mass >= dry mass. Objective: propellant used.
+- A short time-of-flight search (fuel vs tf) plans the burn from the free-fall state SEARCH_LEAD ahead; it is
+  spread over the flight cycles before that ignition, at most CYCLE_BUDGET of solves per update(), so the
+  engine lights on time without the search ever holding the cycle. After that the plan is re-solved at
+  RESOLVE_RATE from the measured state, warm started from the previous plan shifted in time, until
+  TERMINAL_TIME to go, after which the last plan is flown open loop.
+- Solve times are logged separately for the ignition search, the warm re-solves and the work per cycle;
+  converged solves are also reported on their own (certified infeasible and capped solves are counted).
+*/
+class LandingGuidance {
+public:
+    static constexpr std::size_t NODES = 20;
+    static constexpr double RESOLVE_RATE = 5.0;          // Hz
+    static constexpr double TERMINAL_TIME = 0.5;         // s to go: stop re-solving
+    static constexpr int SEARCH_POINTS = 8;              // time-of-flight candidates at ignition
+    static constexpr int GOLDEN_STEPS = 4;               // refinement around the best candidate
+    static constexpr double SEARCH_LEAD = 1.0;           // s between the start of the search and ignition
+    static constexpr int MAX_SEARCH_CYCLES = 8;          // update() calls the search may span (then flies its best point)
+    static constexpr double CYCLE_BUDGET = 0.040;        // s of wall time per update() (the watchdog budget)
+    static constexpr int MAX_ITERATIONS = 4000;
+    static constexpr double SOLVE_BUDGET = 0.020;        // s of wall time per solve: two fit one cycle
+    static constexpr double TOLERANCE = 1e-4;            // ignition search: fuel decides the time of flight
+    static constexpr double RESOLVE_TOLERANCE = 1e-3;    // re-solves (OSQP's default): the next one corrects it
+
+    explicit LandingGuidance(const LandingVehicle& vehicle);
+
+    // Searches over the first calls and engages once a plan is found (the engine lights at its start time),
+    // then re-solves every 1 / RESOLVE_RATE s
+    LandingStatus update(const LandingState& state);
+    LandingCommand command(double time, double period) const;     // plan averaged over one control period
+
+    void setVehicle(const LandingVehicle& limits) { vehicle = limits; reset(); }
+    bool isEngaged() const { return engaged; }
+    LandingStatus getStatus() const { return status; }
+    double getTimeOfFlight() const { return planStart + planDuration - ignitionTime; }
+    double plannedPropellant() const { return plannedFuel; }
+    void reset();
+
+    // Solve-time percentiles (ignition search, warm re-solves, work per cycle) against the landing budgets
+    void report(double cycleBudgetMs) const;
+
+    // Closed-loop dispersed landings against FlightDynamics; prints touchdown accuracy and solve times
+    static void benchmark(const LandingVehicle& vehicle, double dragArea, int runs);
+
+private:
+    static constexpr std::size_t DIMS = 2;
+    static constexpr std::size_t NV = NODES * (DIMS + 1);                 // σ_k, u_k per node
+    static constexpr std::size_t CONES = NODES + (NODES - 1);             // thrust cones, glide-slope cones
+    static constexpr std::size_t CONE_ROWS = NODES * (DIMS + 1) + (NODES - 1) * DIMS;
+    static constexpr std::size_t BOX_ROWS = 2 * NODES + NODES + 2 * DIMS + 1;
+    static constexpr std::size_t ROWS = CONE_ROWS + BOX_ROWS;
+    using Solver = ConicAdmm<NV, ROWS, CONES>;
+
+    enum class Outcome : uint8_t { CONVERGED, INFEASIBLE, CAPPED };   // CAPPED: iteration / time cap, no certificate
+
+    struct SolveLog {
+        static constexpr std::size_t CAPACITY = 4096;
+        std::array<float, CAPACITY> milliseconds{};
+        std::array<uint16_t, CAPACITY> iterations{};
+        std::array<Outcome, CAPACITY> outcomes{};
+        std::size_t count = 0;
+        uint64_t total = 0, infeasible = 0, capped = 0;
+        void add(double ms, int iters, Outcome outcome);
+    };
+
+public:
+    // Ignition search state, carried between update() calls
+    enum class SearchStage { GRID, GOLDEN, FINAL, DONE };
+    struct Search {
+        bool active = false;
+        SearchStage stage = SearchStage::GRID;
+        LandingState start;                 // predicted state at ignition
+        double tMin = 0.0, tMax = 0.0;
+        int point = 0, step = 0;            // next grid point, golden steps done
+        double lo = 0.0, hi = 0.0;          // golden-section bracket and its interior points
+        double a = 0.0, b = 0.0, fuelA = 0.0, fuelB = 0.0;
+        bool okA = false, okB = false, haveA = false, haveB = false;
+        bool found = false;
+        double bestFuel = 0.0, bestTime = 0.0;
+        double bestControls[NV] = {};
+        int solves = 0, cycles = 0;
+        double milliseconds = 0.0;          // solver time summed over the cycles
+    };
+
+    // Everything update() and command() carry between calls, the solver warm start included (checkpoints);
+    // the solve logs are statistics of this process and stay with it
+    struct Snapshot {
+        bool engaged = false;
+        LandingStatus status = LandingStatus::IDLE;
+        double ignitionTime = 0.0;
+        double lastSolveTime = 0.0;
+        int nextStretch = 0;
+        Search search;
+        double planStart = 0.0, planDuration = 0.0, plannedFuel = 0.0;
+        std::array<double, NV> planControls{};
+        std::array<double, NV> x{};
+        std::array<double, ROWS> z{}, y{};
+        double rho = Solver::DEFAULT_RHO;
+    };
+
+    Snapshot snapshot() const;
+    void restore(const Snapshot& snapshot);
+
+private:
+
+    LandingVehicle vehicle;
+    Solver solver;
+
+    bool engaged = false;
+    LandingStatus status = LandingStatus::IDLE;
+    double ignitionTime = 0.0;
+    double lastSolveTime = 0.0;
+    int nextStretch = 0;                    // re-solve attempt that ran out of cycle budget, retried next call
+    int cycleSolves = 0;
+    Search search;
+
+    // Current plan
+    double planStart = 0.0, planDuration = 0.0;
+    double planControls[NV] = {};
+    double plannedFuel = 0.0;
+
+    SolveLog searchLog, resolveLog;
+    SolveLog ignitionLog;                   // whole search per ignition (count = solves)
+    SolveLog cycleLog;                      // update() calls that solved (count = solves)
+
+    void build(const LandingState& state, double timeOfFlight);
+    bool solveFor(const LandingState& state, double timeOfFlight, bool warm, bool flying, SolveLog& log, double& fuel);
+    void beginSearch(const LandingState& state);
+    void searchStep();
+    void finishSearch();
+    LandingStatus resolve(const LandingState& state, std::chrono::steady_clock::time_point cycleDeadline);
+    void shiftWarmStart(double newStart, double newDuration);
+    void storePlan(double start, double duration, double fuel);
+};
+
+#endif
@@ -0,0 +1,271 @@
+/*
+Orbital mechanics for the coast phases: state vector / element conversion, a closed-form Kepler
+propagator with first-order J2 secular rates, and analytic event search.
+
+Research:
+
+1. Vallado, Fundamentals of Astrodynamics and Applications - RV2COE / COE2RV (Algorithms 9 & 10)
+2. Brouwer, Solution of the problem of artificial satellite theory without drag (secular J2 terms)
+https://ui.adsabs.harvard.edu/abs/1959AJ.....64..378B
+*/
+
+#include "orbital_mechanics.h"
+#include <algorithm>
+
+
+namespace {
+
+constexpr double SMALL = 1e-10;  // Threshold for circular / equatorial special cases
+
+double wrapTwoPi(double angle) {
+    angle = std::fmod(angle, TWO_PI);
+    return angle < 0 ? angle + TWO_PI : angle;
+}
+
+// Wraps into (0, 2π] so "next" events are always strictly in the future
+double wrapPositive(double angle) {
+    angle = wrapTwoPi(angle);
+    return angle < 1e-12 ? TWO_PI : angle;
+}
+
+double safeAcos(double x) {
+    return std::acos(std::clamp(x, -1.0, 1.0));
+}
+
+}  // namespace
+
+
+
+/**
+==========================================
+    Kepler's Equation (Newton-Raphson)
+==========================================
+
+M = E - e sin(E), converges in a few iterations for e < 0.99
+*/
+double solveKepler(double meanAnomaly, double e) {
+    double M = wrapTwoPi(meanAnomaly);
+    double E = (e < 0.8) ? M : M_PI;
+
+    for (int iteration = 0; iteration < 50; ++iteration) {
+        double delta = (E - e * std::sin(E) - M) / (1.0 - e * std::cos(E));
+        E -= delta;
+        if (std::fabs(delta) < 1e-14) break;
+    }
+    return E;
+}
+
+
+double trueToMeanAnomaly(double trueAnomaly, double e) {
+    double E = 2.0 * std::atan2(std::sqrt(1.0 - e) * std::sin(trueAnomaly / 2.0),
+                                std::sqrt(1.0 + e) * std::cos(trueAnomaly / 2.0));
+    return wrapTwoPi(E - e * std::sin(E));
+}
+
+
+
+/**
+==========================================
+    State Vector -> Classical Elements
+==========================================
+*/
+OrbitalElements stateToElements(const StateVector& state) {
+    OrbitalElements el;
+    const Vec3& r = state.r;
+    const Vec3& v = state.v;
+
+    double rMag = r.norm();
+    double vMag = v.norm();
+    Vec3 h = r.cross(v);
+    double hMag = h.norm();
+    Vec3 node{-h.y, h.x, 0.0};   // k x h
+    double nodeMag = node.norm();
+
+    Vec3 eVec = (r * (vMag * vMag - MU_EARTH / rMag) - v * r.dot(v)) * (1.0 / MU_EARTH);
+    el.e = eVec.norm();
+
+    double energy = 0.5 * vMag * vMag - MU_EARTH / rMag;
+    el.a = -MU_EARTH / (2.0 * energy);
+    el.i = safeAcos(h.z / hMag);
+
+    bool circular = el.e < SMALL;
+    bool equatorial = nodeMag < SMALL * hMag;
+    double trueAnomaly;
+
+    if (!equatorial) {
+        el.raan = wrapTwoPi(std::atan2(node.y, node.x));
+
+        if (!circular) {
+            el.argp = safeAcos(node.dot(eVec) / (nodeMag * el.e));
+            if (eVec.z < 0) el.argp = TWO_PI - el.argp;
+            trueAnomaly = safeAcos(eVec.dot(r) / (el.e * rMag));
+            if (r.dot(v) < 0) trueAnomaly = TWO_PI - trueAnomaly;
+        } else {
+            // Argument of latitude stands in for the true anomaly
+            el.argp = 0.0;
+            trueAnomaly = safeAcos(node.dot(r) / (nodeMag * rMag));
+            if (r.z < 0) trueAnomaly = TWO_PI - trueAnomaly;
+        }
+    } else {
+        el.raan = 0.0;
+        double sense = (h.z >= 0) ? 1.0 : -1.0;
+
+        if (!circular) {
+            el.argp = wrapTwoPi(sense * std::atan2(eVec.y, eVec.x));
+            trueAnomaly = safeAcos(eVec.dot(r) / (el.e * rMag));
+            if (r.dot(v) < 0) trueAnomaly = TWO_PI - trueAnomaly;
+        } else {
+            // True longitude stands in for the true anomaly
+            el.argp = 0.0;
+            trueAnomaly = wrapTwoPi(sense * std::atan2(r.y, r.x));
+        }
+    }
+
+    el.meanAnomaly = (el.e < 1.0) ? trueToMeanAnomaly(trueAnomaly, el.e) : 0.0;
+    return el;
+}
+
+
+
+/**
+==========================================
+    Classical Elements -> State Vector
+==========================================
+*/
+StateVector elementsToState(const OrbitalElements& el) {
+    double E = solveKepler(el.meanAnomaly, el.e);
+    double nu = 2.0 * std::atan2(std::sqrt(1.0 + el.e) * std::sin(E / 2.0),
+                                 std::sqrt(1.0 - el.e) * std::cos(E / 2.0));
+
+    double p = el.a * (1.0 - el.e * el.e);
+    double rMag = p / (1.0 + el.e * std::cos(nu));
+    double vScale = std::sqrt(MU_EARTH / p);
+
+    // Perifocal frame
+    double rp = rMag * std::cos(nu), rq = rMag * std::sin(nu);
+    double vp = -vScale * std::sin(nu), vq = vScale * (el.e + std::cos(nu));
+
+    // Rotation perifocal -> ECI: R3(-Ω) R1(-i) R3(-ω)
+    double cO = std::cos(el.raan), sO = std::sin(el.raan);
+    double ci = std::cos(el.i),    si = std::sin(el.i);
+    double cw = std::cos(el.argp), sw = std::sin(el.argp);
+
+    Vec3 P{cO * cw - sO * sw * ci, sO * cw + cO * sw * ci, sw * si};
+    Vec3 Q{-cO * sw - sO * cw * ci, -sO * sw + cO * cw * ci, cw * si};
+
+    return StateVector{P * rp + Q * rq, P * vp + Q * vq};
+}
+
+
+
+/**
+==========================================
+    Kepler Propagator Setup - J2 Secular Rates (computed once)
+==========================================
+
+    k   = 1.5 * J2 * (Re / p)^2 * n0
+    Ω̇   = -k cos(i)
+    ω̇   =  k (2 - 2.5 sin²(i))
+    Ṁ   =  n0 + k sqrt(1 - e²) (1 - 1.5 sin²(i))
+*/
+void KeplerPropagator::initialize(const StateVector& state, double epochTime) {
+    epochState = state;
+    epochElements = stateToElements(state);
+    epoch = epochTime;
+    valid = epochElements.e < 1.0 && epochElements.a > 0.0;
+
+    if (!valid) {
+        meanMotion = raanRate = argpRate = 0.0;
+        return;
+    }
+
+    const OrbitalElements& el = epochElements;
+    double n0 = std::sqrt(MU_EARTH / (el.a * el.a * el.a));
+    double p = el.a * (1.0 - el.e * el.e);
+    double k = 1.5 * J2_EARTH * (R_EARTH / p) * (R_EARTH / p) * n0;
+    double sin2i = std::sin(el.i) * std::sin(el.i);
+
+    raanRate = -k * std::cos(el.i);
+    argpRate = k * (2.0 - 2.5 * sin2i);
+    meanMotion = n0 + k * std::sqrt(1.0 - el.e * el.e) * (1.0 - 1.5 * sin2i);
+}
+
+
+
+// O(1) for any time span - the secular drift is linear in time
+OrbitalElements KeplerPropagator::elementsAt(double t) const {
+    OrbitalElements el = epochElements;
+    double dt = t - epoch;
+
+    el.raan = wrapTwoPi(el.raan + raanRate * dt);
+    el.argp = wrapTwoPi(el.argp + argpRate * dt);
+    el.meanAnomaly = wrapTwoPi(el.meanAnomaly + meanMotion * dt);
+    return el;
+}
+
+
+StateVector KeplerPropagator::stateAt(double t) const {
+    return elementsToState(elementsAt(t));
+}
+
+
+
+// ==========================================
+//    Event Search (analytic, no stepping)
+// ==========================================
+double KeplerPropagator::nextPeriapsis(double t) const {
+    return t + wrapPositive(-elementsAt(t).meanAnomaly) / meanMotion;
+}
+
+double KeplerPropagator::nextApoapsis(double t) const {
+    return t + wrapPositive(M_PI - elementsAt(t).meanAnomaly) / meanMotion;
+}
+
+
+/**
+ * Argument of latitude u = ω + ν. Because ω drifts under J2 the target true anomaly depends
+ * on the (unknown) crossing time, so refine with a few fixed-point passes - the drift per orbit is tiny.
+ */
+double KeplerPropagator::timeToArgumentOfLatitude(double t, double targetU) const {
+    OrbitalElements now = elementsAt(t);
+    double crossing = t;
+
+    for (int pass = 0; pass < 4; ++pass) {
+        double argp = elementsAt(crossing).argp;
+        double targetM = trueToMeanAnomaly(wrapTwoPi(targetU - argp), now.e);
+        crossing = t + wrapPositive(targetM - now.meanAnomaly) / meanMotion;
+    }
+    return crossing;
+}
+
+double KeplerPropagator::nextAscendingNode(double t) const {
+    return timeToArgumentOfLatitude(t, 0.0);
+}
+
+double KeplerPropagator::nextDescendingNode(double t) const {
+    return timeToArgumentOfLatitude(t, M_PI);
+}
+
+
+/**
+ * Retrograde burn at the next apoapsis that drops periapsis to the target altitude:
+ *     Δv = sqrt(μ(2/ra - 1/a)) - sqrt(μ(2/ra - 1/a'))    with a' = (ra + rp') / 2
+ */
+DeorbitWindow KeplerPropagator::nextDeorbitWindow(double t, double targetPeriapsisAltitude) const {
+    DeorbitWindow window;
+    if (!valid) return window;
+
+    const OrbitalElements el = elementsAt(t);
+    double ra = el.apoapsisRadius();
+    double rpTarget = R_EARTH + targetPeriapsisAltitude;
+    if (rpTarget >= ra) return window;
+
+    double aTarget = 0.5 * (ra + rpTarget);
+    double vBefore = std::sqrt(MU_EARTH * (2.0 / ra - 1.0 / el.a));
+    double vAfter = std::sqrt(MU_EARTH * (2.0 / ra - 1.0 / aTarget));
+
+    window.time = nextApoapsis(t);
+    window.deltaV = std::max(vBefore - vAfter, 0.0);
+    window.valid = true;
+    return window;
+}
@@ -0,0 +1,120 @@
+#ifndef ORBITAL_MECHANICS_H
+#define ORBITAL_MECHANICS_H
+
+#include <cmath>
+
+
+// ==========================================
+//    Earth Constants (WGS-84 / EGM-96)
+// ==========================================
+constexpr double MU_EARTH = 3.986004418e14;      // Gravitational parameter (m^3/s^2)
+constexpr double R_EARTH = 6378137.0;            // Equatorial radius (m)
+constexpr double J2_EARTH = 1.08262668e-3;       // Second zonal harmonic
+constexpr double TWO_PI = 6.283185307179586;
+
+
+// Minimal 3-vector for orbital computations (ECI frame)
+struct Vec3 {
+    double x = 0, y = 0, z = 0;
+
+    Vec3 operator+(const Vec3& o) const { return {x + o.x, y + o.y, z + o.z}; }
+    Vec3 operator-(const Vec3& o) const { return {x - o.x, y - o.y, z - o.z}; }
+    Vec3 operator*(double s) const { return {x * s, y * s, z * s}; }
+    double dot(const Vec3& o) const { return x * o.x + y * o.y + z * o.z; }
+    Vec3 cross(const Vec3& o) const { return {y * o.z - z * o.y, z * o.x - x * o.z, x * o.y - y * o.x}; }
+    double norm() const { return std::sqrt(dot(*this)); }
+};
+
+
+// Cartesian state in the Earth-centered inertial frame
+struct StateVector {
+    Vec3 r;   // position (m)
+    Vec3 v;   // velocity (m/s)
+};
+
+
+/**
+ * @brief Classical orbital elements (angles in radians)
+ * - For circular orbits argp is 0 and meanAnomaly is measured from the ascending node
+ * - For equatorial orbits raan is 0 and argp is measured from the x axis
+ */
+struct OrbitalElements {
+    double a = 0;            // Semi-major axis (m)
+    double e = 0;            // Eccentricity
+    double i = 0;            // Inclination
+    double raan = 0;         // Right ascension of the ascending node
+    double argp = 0;         // Argument of periapsis
+    double meanAnomaly = 0;  // Mean anomaly
+
+    double periapsisRadius() const { return a * (1.0 - e); }
+    double apoapsisRadius() const { return a * (1.0 + e); }
+    double period() const { return TWO_PI * std::sqrt(a * a * a / MU_EARTH); }
+};
+
+
+// Deorbit opportunity: a retrograde burn at apoapsis that lowers periapsis to the target altitude
+struct DeorbitWindow {
+    double time = 0;        // Mission time of the burn (s)
+    double deltaV = 0;      // Required retrograde delta-V (m/s)
+    bool valid = false;
+};
+
+
+
+// ==========================================
+//    Element / State Conversion & Kepler's Equation
+// ==========================================
+OrbitalElements stateToElements(const StateVector& state);
+StateVector elementsToState(const OrbitalElements& elements);
+double solveKepler(double meanAnomaly, double e);       // Returns the eccentric anomaly
+double trueToMeanAnomaly(double trueAnomaly, double e);
+
+
+
+/**
+==========================================
+    Closed-Form Kepler Propagator with J2 Secular Drift
+==========================================
+
+- Secular J2 rates (node regression, apsidal precession, mean-motion correction) are computed once at epoch.
+- elementsAt()/stateAt() cost the same for any time span: one Kepler solve, no stepping.
+- Valid for closed (elliptic) orbits; isValid() is false for escape trajectories.
+*/
+class KeplerPropagator {
+private:
+    StateVector epochState;  // As passed to initialize() - re-initializing from it reproduces this propagator exactly
+    OrbitalElements epochElements;
+    double epoch = 0;        // Mission time of epochElements (s)
+    double meanMotion = 0;   // Perturbed mean motion (rad/s)
+    double raanRate = 0;     // dΩ/dt (rad/s)
+    double argpRate = 0;     // dω/dt (rad/s)
+    bool valid = false;
+
+    double timeToArgumentOfLatitude(double t, double targetU) const;
+
+public:
+    KeplerPropagator() = default;
+
+    /**
+     * @brief Initializes the propagator from a state vector
+     * @param state ECI position/velocity at `epochTime`
+     * @param epochTime Mission time of the state (s)
+     */
+    void initialize(const StateVector& state, double epochTime);
+
+    bool isValid() const { return valid; }
+    double getEpoch() const { return epoch; }
+    const StateVector& getEpochState() const { return epochState; }
+
+    OrbitalElements elementsAt(double t) const;
+    StateVector stateAt(double t) const;
+
+    // Event search - all return the first mission time strictly after t
+    double nextPeriapsis(double t) const;
+    double nextApoapsis(double t) const;
+    double nextAscendingNode(double t) const;
+    double nextDescendingNode(double t) const;
+    DeorbitWindow nextDeorbitWindow(double t, double targetPeriapsisAltitude) const;
+};
+
+#endif
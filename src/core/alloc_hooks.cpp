@@ -0,0 +1,64 @@
+#include "alloc_stats.h"
+#include <cstdlib>
+#include <new>
+
+
+// Bench / test builds only (see alloc_stats.h): linking this file swaps the process allocator
+namespace {
+
+[[maybe_unused]] const bool installed = (AllocStats::detail::hooked = true);
+
+void* countedAlloc(std::size_t size) {
+    AllocStats::detail::allocations++;
+    AllocStats::detail::bytes += size;
+    return std::malloc(size ? size : 1);
+}
+
+void* countedAlignedAlloc(std::size_t size, std::size_t alignment) {
+    AllocStats::detail::allocations++;
+    AllocStats::detail::bytes += size;
+    void* p = nullptr;
+    if (posix_memalign(&p, alignment < sizeof(void*) ? sizeof(void*) : alignment, size ? size : 1) != 0) {
+        return nullptr;
+    }
+    return p;
+}
+
+}  // namespace
+
+
+
+// ==========================================
+// Global operator new / delete replacements
+// ==========================================
+void* operator new(std::size_t size) {
+    if (void* p = countedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* p = countedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* p = countedAlignedAlloc(size, static_cast<std::size_t>(alignment))) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* p = countedAlignedAlloc(size, static_cast<std::size_t>(alignment))) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
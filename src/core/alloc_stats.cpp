@@ -0,0 +1,31 @@
+#include "alloc_stats.h"
+#include <sys/resource.h>
+
+
+namespace AllocStats {
+
+namespace detail {
+thread_local uint64_t allocations = 0;
+thread_local uint64_t bytes = 0;
+bool hooked = false;
+}  // namespace detail
+
+Snapshot thread() {
+    return Snapshot{detail::allocations, detail::bytes};
+}
+
+bool counting() {
+    return detail::hooked;
+}
+
+std::size_t peakRssKb() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return static_cast<std::size_t>(usage.ru_maxrss) / 1024;   // bytes on macOS
+#else
+    return static_cast<std::size_t>(usage.ru_maxrss);          // KiB on Linux
+#endif
+}
+
+}  // namespace AllocStats
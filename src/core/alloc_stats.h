@@ -0,0 +1,40 @@
+#ifndef ALLOC_STATS_H
+#define ALLOC_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+
+
+/**
+==========================================
+    Allocation Statistics
+==========================================
+
+alloc_hooks.cpp replaces the global operator new / delete with thin malloc wrappers that count
+allocations per thread (one thread_local increment, no shared counters, so no contention).
+Take a snapshot before and after a run on the same thread to get that run's heap traffic.
+
+The hooks are a bench/test instrument and are only linked when asked for (ALLOC_STATS=1 ./FULL_EXECUTE.sh);
+the flight executable keeps the system allocator and counting() reports false.
+*/
+namespace AllocStats {
+
+struct Snapshot {
+    uint64_t allocations;
+    uint64_t bytes;
+};
+
+Snapshot thread();          // totals for the calling thread since it started (zero without the hooks)
+bool counting();            // true when alloc_hooks.cpp is linked in
+std::size_t peakRssKb();    // process peak resident set size (KiB)
+
+// Written by the hooks; plain data with constant initialization, so safe to touch from inside operator new
+namespace detail {
+extern thread_local uint64_t allocations;
+extern thread_local uint64_t bytes;
+extern bool hooked;
+}  // namespace detail
+
+}  // namespace AllocStats
+
+#endif
@@ -0,0 +1,55 @@
+#include "arena.h"
+#include <sys/mman.h>
+#include <unistd.h>
+#include <iostream>
+
+
+
+BumpArena::BumpArena(std::size_t bytes, std::pmr::memory_resource* fallback)
+    : capacity(bytes), upstream(fallback) {
+
+    void* block = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (block == MAP_FAILED) {
+        std::cerr << "[ARENA ERROR] Could not map " << capacity << " bytes - using the heap only.\n";
+        capacity = 0;
+        return;
+    }
+    base = static_cast<char*>(block);
+
+    // First touch from the owning thread places the pages on its NUMA node (and keeps page faults out of the runs)
+    const long page = sysconf(_SC_PAGESIZE);
+    for (std::size_t i = 0; i < capacity; i += static_cast<std::size_t>(page)) {
+        base[i] = 0;
+    }
+}
+
+
+BumpArena::~BumpArena() {
+    if (base) {
+        munmap(base, capacity);
+    }
+}
+
+
+
+void* BumpArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    std::size_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+
+    if (base && aligned + bytes <= capacity) {
+        offset = aligned + bytes;
+        if (offset > highWater) highWater = offset;
+        return base + aligned;
+    }
+
+    overflows++;
+    return upstream->allocate(bytes, alignment);
+}
+
+
+void BumpArena::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    char* c = static_cast<char*>(p);
+    if (base && c >= base && c < base + capacity) {
+        return;  // arena memory is released by reset()
+    }
+    upstream->deallocate(p, bytes, alignment);
+}
@@ -0,0 +1,49 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+
+/**
+==========================================
+    Bump Arena (per-worker scratch memory)
+==========================================
+
+- One up-front block; allocate() is a pointer bump, deallocate() is a no-op, reset() frees everything at once.
+- Meant to be owned by a single worker thread and reset between runs, so there is no locking and no
+  fragmentation across threads. Exposed as a std::pmr::memory_resource so pmr containers can use it.
+- The block is mapped lazily and touched by the constructing thread: with Linux's first-touch policy a
+  worker that is pinned before it builds its arena gets NUMA-local pages.
+- If a run outgrows the block, requests fall through to the upstream heap and are counted as overflow.
+*/
+class BumpArena : public std::pmr::memory_resource {
+private:
+    char* base = nullptr;
+    std::size_t capacity = 0;
+    std::size_t offset = 0;
+    std::size_t highWater = 0;
+    uint64_t overflows = 0;
+    std::pmr::memory_resource* upstream;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+public:
+    explicit BumpArena(std::size_t bytes, std::pmr::memory_resource* fallback = std::pmr::new_delete_resource());
+    ~BumpArena() override;
+    BumpArena(const BumpArena&) = delete;
+    BumpArena& operator=(const BumpArena&) = delete;
+
+    // Releases every allocation; the caller must not hold pointers into the arena past this
+    void reset() { offset = 0; }
+
+    std::size_t used() const { return offset; }
+    std::size_t highWaterMark() const { return highWater; }
+    std::size_t size() const { return capacity; }
+    uint64_t overflowCount() const { return overflows; }
+};
+
+#endif
@@ -1,8 +1,149 @@
 #include <iostream>
+#include <cstring>
+#include <cstdlib>
 #include "cdh.h"
 #include "scheduler.h"
+#include "checkpoint.h"
+#include "branch_runner.h"
+#include "batch_runner.h"
+#include "sweep_coordinator.h"
+#include "landing_guidance.h"
+#include "ascent_optimizer.h"
+#include "reentry.h"
+#include "telemetry_server.h"
+
+
+/**
+ * What-if mode: clones canned variants from a saved checkpoint and runs them in parallel.
+ * Usage: --branch <checkpoint file> [duration seconds]
+ */
+static int runBranches(const char* path, double duration) {
+    SimulationCheckpoint checkpoint;
+    if (!checkpoint.loadFromFile(path)) {
+        return 1;
+    }
+
+    std::vector<Branch> branches = {
+        {"Nominal",          nullptr},
+        {"Engine Failure",   nullptr, 0.0},
+        {"Half Thrust",      nullptr, 0.5},
+        {"Drag Area +20%",   [](FlightDynamics& fd) { fd.setDragArea(fd.getState().dragArea * 1.2); }},
+    };
+
+    BranchRunner runner(checkpoint, Scheduler::CYCLE_DT);
+    BranchRunner::printSummary(runner.run(branches, duration));
+    return 0;
+}
+
+
+int main(int argc, char* argv[]) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--branch") == 0) {
+            double duration = (i + 2 < argc) ? std::atof(argv[i + 2]) : 120.0;
+            return runBranches(argv[i + 1], duration);
+        }
+    }
+
+    // Packed telemetry log -> CSV on stdout: --decode-telemetry [path]
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--decode-telemetry") == 0) {
+            const char* path = (i + 1 < argc && argv[i + 1][0] != '-') ? argv[i + 1] : Telemetry::FRAME_LOG_PATH;
+            return Telemetry::decodeLog(path, std::cout) ? 0 : 1;
+        }
+    }
+
+    // Batch scaling benchmark: --bench-batch [runs] (120 s missions with wind and turbulence)
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bench-batch") == 0) {
+            std::size_t runs = (i + 1 < argc) ? std::strtoul(argv[i + 1], nullptr, 10) : 0;
+            MissionConfig config;
+            config.duration = 120.0;
+            config.loadWeather("scripts/api_data/weather_conditions.json");
+            BatchRunner::benchmark(config, runs ? runs : 256);
+            return 0;
+        }
+    }
+
+    // Closed-loop landing guidance benchmark: --bench-landing [runs] (single-engine landing burn, sea-level Isp)
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bench-landing") == 0) {
+            int runs = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+            MissionConfig config;
+            config.loadRocketSpecs("scripts/api_data/rocket_specs.json");
+            LandingVehicle vehicle;
+            vehicle.isp = config.isp;
+            LandingGuidance::benchmark(vehicle, config.dragArea, runs > 0 ? runs : 50);
+            return 0;
+        }
+    }
+
+    // Reentry integrator benchmark: --bench-reentry (deorbit to touchdown, Euler / RK4 / ROS2 against a fine reference)
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bench-reentry") == 0) {
+            ReentryVehicle capsule;
+            DeorbitScenario scenario;
+            if (!capsule.loadConfig("program_configuration.json") || !scenario.loadConfig("program_configuration.json")) return 1;
+            ReentryModel::benchmark(capsule, scenario);
+            return 0;
+        }
+    }
+
+    // Offline ascent optimization: --optimize-ascent [threads] writes ascent_profile.json for the flight loop
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--optimize-ascent") == 0) {
+            unsigned threads = (i + 1 < argc && argv[i + 1][0] != '-') ? std::atoi(argv[i + 1]) : 0;
+            AscentVehicle vehicle;
+            AscentTarget target;
+            if (!vehicle.loadRocketSpecs("scripts/api_data/rocket_specs.json") ||
+                !vehicle.loadStages("program_configuration.json") || !target.loadConfig("program_configuration.json")) {
+                return 1;
+            }
+            AscentOptimizer optimizer(vehicle, target);
+            AscentProfile profile = optimizer.optimize(threads);
+            optimizer.report();
+            if (!profile.save("ascent_profile.json")) return 1;
+            std::cout << "[ASCENT] Profile written to ascent_profile.json (loaded by the flight loop at boot)\n";
+            return 0;
+        }
+    }
+
+    // Sweep worker process, started by the coordinator: --sweep-worker <socket> <id>
+    for (int i = 1; i + 2 < argc; ++i) {
+        if (std::strcmp(argv[i], "--sweep-worker") == 0) {
+            return SweepCoordinator::workerMain(argv[i + 1], static_cast<uint32_t>(std::strtoul(argv[i + 2], nullptr, 10)));
+        }
+    }
+
+    // Multi-process parameter sweep: --sweep [workers], --bench-sweep (worker scaling)
+    // Crash test: --sweep-fault <run> makes the worker that reaches that run exit
+    for (int i = 1; i < argc; ++i) {
+        bool bench = std::strcmp(argv[i], "--bench-sweep") == 0;
+        if (bench || std::strcmp(argv[i], "--sweep") == 0) {
+            SweepSpec spec;
+            if (!spec.load("program_configuration.json", "scripts/api_data/rocket_specs.json",
+                           "scripts/api_data/weather_conditions.json")) {
+                return 1;
+            }
+            for (int j = 1; j + 1 < argc; ++j) {
+                if (std::strcmp(argv[j], "--sweep-fault") == 0) spec.faultRun = std::atoll(argv[j + 1]);
+            }
+
+#ifdef __linux__
+            SweepCoordinator coordinator(spec, "/proc/self/exe");
+#else
+            SweepCoordinator coordinator(spec, argv[0]);
+#endif
+            if (bench) {
+                coordinator.benchmark();
+                return 0;
+            }
+            unsigned workers = (i + 1 < argc && argv[i + 1][0] != '-') ? std::atoi(argv[i + 1]) : 0;
+            SweepCoordinator::Result result = coordinator.run(workers);
+            coordinator.printReport(result);
+            return result.complete ? 0 : 1;
+        }
+    }
 
-int main() {
     std::cout << "========================================" << std::endl;
     std::cout << "    OpenSpaceFSW Flight Software Boot   " << std::endl;
     std::cout << "========================================\n" << std::endl;
@@ -13,8 +154,48 @@ int main() {
     Scheduler scheduler(&cdh);  // Then we create the Scheduler are giving it a valid CDH
     cdh.setScheduler(&scheduler);  // Finally we set the scheduler reference inside the CDH software
 
-    // Execute mission command
+
+    // Optional command uplink: --uplink-socket <path> or --uplink-file <path>
+    // Optional resume point:    --restore <checkpoint file>
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--restore") == 0) {
+            SimulationCheckpoint checkpoint;
+            if (checkpoint.loadFromFile(argv[++i])) {
+                scheduler.restoreCheckpoint(checkpoint);
+                std::cout << "[INFO] Resuming from checkpoint at T+" << checkpoint.elapsedTime << "s\n";
+            }
+        } else if (std::strcmp(argv[i], "--uplink-socket") == 0) {
+            cdh.startUplink(CommandUplink::Source::SOCKET, argv[++i]);
+        } else if (std::strcmp(argv[i], "--uplink-file") == 0) {
+            cdh.startUplink(CommandUplink::Source::FILE, argv[++i]);
+        }
+    }
+
+    // Optional live dashboard: --dashboard [port] (localhost only, default 8080)
+    TelemetryServer dashboard;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--dashboard") == 0) {
+            int port = (i + 1 < argc && argv[i + 1][0] != '-') ? std::atoi(argv[i + 1]) : 8080;
+            if (dashboard.start(static_cast<uint16_t>(port))) {
+                cdh.getTelemetry().attachServer(&dashboard);
+            }
+        }
+    }
+
+    // Optional stress test: --stress <ms> [seconds] runs a competing thread on the flight loop's CPU, busy for
+    // <ms> of every ~100 ms (default 10 s); the run ends once full service is back and exits non-zero on any
+    // CRITICAL deadline miss or a failed recovery
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--stress") == 0) {
+            double seconds = (i + 2 < argc && argv[i + 2][0] != '-') ? std::atof(argv[i + 2]) : 10.0;
+            scheduler.setStress(std::atof(argv[i + 1]), seconds);
+            std::cout << "[INFO] Stress test: " << argv[i + 1] << " ms of CPU contention per cycle for " << seconds << " s\n";
+        }
+    }
+
+    // Execute mission command, then run the loop it armed
     cdh.executeCommand("START_MISSION");
+    cdh.runMission();
 
-    return 0;
+    return scheduler.stressFailed() ? 1 : 0;
 }
@@ -0,0 +1,35 @@
+#ifndef SENSOR_DATA_H
+#define SENSOR_DATA_H
+
+#include "spsc_queue.h"
+
+
+// ===== Timestamped sensor samples (time = mission elapsed time of the measurement, s) =====
+
+// Body axes: x along the vehicle's long axis (up at launch), y/z lateral
+struct ImuSample {
+    double time;
+    double gyro[3];       // angular rate (rad/s)
+    double accel[3];      // specific force (m/s²)
+};
+
+struct GpsFix {
+    double time;          // measurement epoch
+    double available;     // epoch + receiver latency - when flight software may see the fix
+    double altitude;      // m
+    double verticalVelocity;  // m/s
+};
+
+struct BaroSample {
+    double time;
+    double pressure;      // Pa
+    double altitude;      // pressure altitude (m)
+};
+
+
+// ===== Streams: one producer (sensor layer), one consumer (ADCS or GNC) =====
+using ImuStream = SpscQueue<ImuSample, 2048>;     // ~2 cycles of 1 kHz data
+using GpsStream = SpscQueue<GpsFix, 16>;
+using BaroStream = SpscQueue<BaroSample, 128>;
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <array>
+#include <cstddef>
+
+
+/**
+==========================================
+    Bounded Lock-Free Single-Producer / Single-Consumer Queue
+==========================================
+
+- Fixed capacity ring buffer (Capacity must be a power of two), no heap allocation after construction.
+- One thread pushes (e.g. the uplink reader), one thread pops (e.g. the flight loop).
+- push() never blocks: it returns false when the queue is full so the producer can count the drop.
+*/
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+private:
+    static constexpr std::size_t MASK = Capacity - 1;
+
+    std::array<T, Capacity> slots;
+    alignas(64) std::atomic<std::size_t> head{0};  // next slot to pop (owned by the consumer)
+    alignas(64) std::atomic<std::size_t> tail{0};  // next slot to push (owned by the producer)
+
+public:
+    bool push(const T& item) {
+        const std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) >= Capacity) {
+            return false;  // full
+        }
+        slots[t & MASK] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) {
+        const std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;  // empty
+        }
+        item = slots[h & MASK];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t size() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+};
+
+#endif
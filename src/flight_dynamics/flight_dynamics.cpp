@@ -13,6 +13,9 @@ const double ATMOSPHERIC_PRESSURE_SEA_LEVEL = 101325;  // Pascals (Pa)
 const double AIR_DENSITY_SEA_LEVEL = 1.225;  // kg/m^3
 const double DRAG_COEFFICIENT = 0.5;  // Assumed coefficient for streamlined bodies
 const double REF_AREA = 10.0;  // References the cross-sectional area of rocket (m²) - This adjusts per rocket specs though
+const double SCALE_HEIGHT = 8500.0;  // Atmospheric scale height (m)
+const double EVENT_TIME_TOLERANCE = 1e-9;  // Event time resolution inside a step (s)
+const double SIMULTANEOUS_EVENT_WINDOW = 1e-6;  // Events closer than this fire in the same stop (s)
 
 
 // ==========================================
@@ -34,66 +37,253 @@ update() - Computes new altitude, velocity, and fuel consumption per timestep.
     - Efficiently handles the real-time adjustments to the mass and drag force.
  */
 void FlightDynamics::update(double dt) {
+    bool engineWasOn = thrust != 0;
+    setState(stepFrom(getState(), dt));
 
-    // PLACEHOLDR CALCULATIONS - Refactoring and optimization needed
+    if (engineWasOn && thrust == 0 && fuel <= FUEL_CUTOFF && consoleWarnings) {
+        std::cout << "[WARNING] Out of Fuel! Engine Shutdown.\n";
+    }
+}
+
+
+
+/**
+==========================================
+   Single Integration Step From A Given State
+==========================================
+
+stepFrom() is a pure function of (state, dt). Stepping by any fraction of dt from the same start
+state traces a continuous path, which is what the event root-finder in advance() relies on.
+ */
+FlightDynamics::State FlightDynamics::stepFrom(const State& start, double dt) const {
 
+    // PLACEHOLDR CALCULATIONS - Refactoring and optimization needed
+    State s = start;
 
     // Prevent calculations if fuel is depleted
-    if (fuel == 0) {
-        std::cout << "[WARNING] Out of Fuel! Engine Shutdown.\n";
-        thrust = 0;  // Thrust terminates when fuel runs out
+    if (s.fuel <= FUEL_CUTOFF) {
+        s.thrust = 0;  // Thrust terminates when fuel runs out
     }
 
     /* 
         Compute Dynamic Mass Change (Rocket Mass Reduces Over Time)
-        Formula: M = M_initial - (burnRate * dt)
-    */
-    double massCurrent = std::max(mass - (burnRate * dt), mass * 0.1);  // Prevents division by zero
-
-    /* 
-        Compute Atmospheric Drag (Quadratic Drag Model)
-        Drag = 0.5 * ρ * v² * Cd * A
-    */
-    double airDensity = AIR_DENSITY_SEA_LEVEL * exp(-altitude / 8500);  // Exponential decay with altitude
-    double drag = 0.5 * airDensity * velocity * velocity * DRAG_COEFFICIENT * dragArea;
-
-    /* 
-        Computes the Net Force on Rocket
-        Net Force = Thrust - Drag - (Mass * Gravity)
+        Formula: M = M_initial - (burnRate * dt), limited to the propellant left
     */
-    double netForce = thrust - drag - (massCurrent * gravity);
+    double burned = std::min(s.burnRate * dt, s.fuel);
+    double massCurrent = std::max(s.mass - burned, s.mass * 0.1);  // Prevents division by zero
 
     /* 
-        Computes the Acceleration
-        a = F_net / m
+        Computes the Acceleration (Net Force = Thrust - Drag - (Mass * Gravity), a = F_net / m)
+        Drag is computed against the relative wind when a wind model is attached
     */
-    double acceleration = netForce / massCurrent;
+    double acceleration = accelerationOf(s, massCurrent);
+    s.dragForce = dragOf(s, nullptr, nullptr);
 
     /* 
         Updates the Velocity (v = v0 + a * dt)
     */
-    velocity += acceleration * dt;
+    s.velocity += acceleration * dt;
 
     /* 
         Updates the Altitude (h = h0 + vΔt + ½ a(Δt)^2)
     */
-    altitude += velocity * dt + 0.5 * acceleration * dt * dt;
+    s.altitude += s.velocity * dt + 0.5 * acceleration * dt * dt;
 
     /* 
         Computes the Delta-V using the Tsiolkovsky Rocket Equation
         ΔV = ISP * g * ln(M_initial / M_final)
     */
-   if (massCurrent > 0 && mass > massCurrent) {
-        deltaV = isp * EARTH_GRAVITY * log(mass / massCurrent);  // ✅ Store computed value
+   if (massCurrent > 0 && s.mass > massCurrent) {
+        s.deltaV = s.isp * EARTH_GRAVITY * log(s.mass / massCurrent);  // ✅ Store computed value
     } else {
-        deltaV = 0.0;  // Prevents NaN in log function
+        s.deltaV = 0.0;  // Prevents NaN in log function
     }
 
     /* 
         Fuel Consumption - Prevents negative
     */
-    fuel = std::max(fuel - burnRate * dt, 0.0);
+    s.fuel = std::max(s.fuel - s.burnRate * dt, 0.0);
+    s.mass = massCurrent;   // the burned propellant has left the vehicle
+
+    return s;
+}
+
+
+
+/**
+ * Aerodynamic drag against the relative wind (air-relative velocity = vehicle velocity - wind)
+ *     Drag = 0.5 * ρ * |v_air|² * Cd * A    (ρ decays exponentially with altitude)
+ * The vehicle moves vertically only, so its air-relative velocity is (v - w_gust) vertically and
+ * -(horizontal wind) sideways. Returns the drag magnitude; `vertical` / `horizontal` receive the
+ * components of the drag force along the vertical axis and across it.
+ */
+double FlightDynamics::dragOf(const State& s, double* vertical, double* horizontal) const {
+    double airDensity = AIR_DENSITY_SEA_LEVEL * exp(-s.altitude / SCALE_HEIGHT);
+
+    double airVertical = s.velocity;
+    double airHorizontal = 0.0;
+    if (windModel) {
+        WindSample wind = windModel->sample(s.altitude);
+        airVertical -= wind.vertical;
+        airHorizontal = -std::hypot(wind.horizontal, wind.lateral);
+    }
+
+    double airspeed = std::hypot(airVertical, airHorizontal);
+    double drag = 0.5 * airDensity * airspeed * airspeed * DRAG_COEFFICIENT * s.dragArea;
+
+    // Drag opposes the air-relative velocity: F = -0.5 ρ |v_air| v_air Cd A
+    double perAirspeed = 0.5 * airDensity * airspeed * DRAG_COEFFICIENT * s.dragArea;
+    if (vertical) *vertical = -perAirspeed * airVertical;
+    if (horizontal) *horizontal = -perAirspeed * airHorizontal;
+    return drag;
+}
+
+
+/**
+ * Net vertical acceleration for a state at the given instantaneous mass
+ *     Net Force = Thrust + Drag_vertical - (Mass * Gravity)
+ */
+double FlightDynamics::accelerationOf(const State& s, double massCurrent) const {
+    double dragVertical = 0.0;
+    dragOf(s, &dragVertical, nullptr);
+
+    double thrustNow = (s.fuel <= FUEL_CUTOFF) ? 0.0 : s.thrust;
+    double netForce = thrustNow + dragVertical - (massCurrent * s.gravity);
+    return netForce / massCurrent;
+}
+
+
+double FlightDynamics::getCrossWindForce() const {
+    double horizontal = 0.0;
+    dragOf(getState(), nullptr, &horizontal);
+    return horizontal;
+}
+
+
+
+/**
+==========================================
+   Event-Aware Advance (Zero-Crossing Detection)
+==========================================
 
+Takes one step of dt and checks every armed event of the active phase for a sign change. If any crossed,
+the crossing time inside the step is located with the Illinois variant of regula falsi on
+f(τ) = g(stepFrom(start, τ)), and the state is advanced only to the earliest crossing.
+
+The returned state sits on the far side of the threshold (the end of the final bracket), so the
+crossing is visible to whoever reads the state next and is not detected a second time.
+
+Returns the time actually advanced (<= dt).
+ */
+double FlightDynamics::advance(double dt, EventRecord* hit) {
+    const State start = getState();
+    const State end = stepFrom(start, dt);
+
+    // Crossing time of every event that fired in this step (negative = no crossing)
+    std::array<double, MAX_EVENTS> crossing;
+    crossing.fill(-1.0);
+    double firstTime = dt;
+    bool anyFired = false;
+
+    for (int i = 0; i < eventCount; ++i) {
+        const FlightEvent& event = events[i];
+        if (!event.armed || (event.phases & activePhases) == 0) continue;
+
+        double g0 = event.function(start);
+        double g1 = event.function(end);
+        if (!crosses(event.direction, g0, g1)) continue;
+
+        // Illinois: keep a sign-changing bracket [a, b], halve the stale endpoint's weight
+        double a = 0.0, fa = g0;
+        double b = dt, fb = g1;
+        int side = 0;
+
+        for (int iteration = 0; iteration < 60 && (b - a) > EVENT_TIME_TOLERANCE; ++iteration) {
+            double c = (a * fb - b * fa) / (fb - fa);
+            if (!(c > a && c < b)) c = 0.5 * (a + b);  // numerical safety
+
+            double fc = event.function(stepFrom(start, c));
+
+            if ((fc > 0) == (fb > 0) && fc != 0) {
+                b = c; fb = fc;
+                if (side == -1) fa *= 0.5;
+                side = -1;
+            } else {
+                a = c; fa = fc;
+                if (side == +1) fb *= 0.5;
+                side = +1;
+            }
+        }
+
+        crossing[i] = b;
+        firstTime = anyFired ? std::min(firstTime, b) : b;
+        anyFired = true;
+    }
+
+    if (!anyFired) {
+        bool engineWasOn = thrust != 0;
+        setState(end);
+        if (engineWasOn && thrust == 0 && fuel <= FUEL_CUTOFF && consoleWarnings) {
+            std::cout << "[WARNING] Out of Fuel! Engine Shutdown.\n";
+        }
+        return dt;
+    }
+
+    setState(stepFrom(start, firstTime));
+
+    // Events that cross at the same instant (e.g. burnout is also max-Q) all fire together,
+    // otherwise the later ones would start the next step already past their threshold
+    if (hit) {
+        hit->names.clear();
+        hit->offset = firstTime;
+        hit->state = getState();
+    }
+    for (int i = 0; i < eventCount; ++i) {
+        if (crossing[i] < 0 || crossing[i] > firstTime + SIMULTANEOUS_EVENT_WINDOW) continue;
+
+        if (events[i].oneShot) events[i].armed = false;
+        if (hit) hit->names.push_back(events[i].name);
+    }
+    return firstTime;
+}
+
+
+
+bool FlightDynamics::crosses(int direction, double g0, double g1) {
+    bool rising = g0 < 0 && g1 >= 0;
+    bool falling = g0 > 0 && g1 <= 0;
+
+    if (direction > 0) return rising;
+    if (direction < 0) return falling;
+    return rising || falling;
+}
+
+
+
+int FlightDynamics::addEvent(const char* name, EventFunction function, int direction, bool oneShot, uint32_t phases) {
+    if (eventCount == MAX_EVENTS) {
+        std::cerr << "[FLIGHT DYNAMICS ERROR] Event table full, \"" << name << "\" not registered.\n";
+        return -1;
+    }
+    FlightEvent& event = events[eventCount];
+    event.name = name;
+    event.function = std::move(function);
+    event.direction = direction;
+    event.oneShot = oneShot;
+    event.armed = true;
+    event.phases = phases;
+    return eventCount++;
+}
+
+
+void FlightDynamics::addVehicleEvents() {
+    addEvent("Fuel Depletion", [](const State& s) { return s.fuel - FUEL_CUTOFF; }, -1, true);
+    addEvent("Max-Q", [this](const State& s) {
+        // dq/dt = ρ v (a - v|v| / 2H) for q = ½ρv² with ρ ∝ exp(-h/H); its sign flips + to - at max-Q
+        return accelerationOf(s) - s.velocity * std::fabs(s.velocity) / (2.0 * SCALE_HEIGHT);
+    }, -1, true);
+    addEvent("Apogee", [](const State& s) { return s.velocity; }, -1);
+    addEvent("Touchdown", [](const State& s) { return s.altitude; }, -1);
 }
 
 
@@ -123,4 +313,41 @@ double FlightDynamics::getDeltaV() const {
 
 double FlightDynamics::getDragForce() const {
     return dragForce;
-}
\ No newline at end of file
+}
+
+
+
+// ==========================================
+//    State Snapshot (Checkpoint / Restore)
+// ==========================================
+FlightDynamics::State FlightDynamics::getState() const {
+    return State{mass, thrust, burnRate, isp, velocity, altitude, fuel, deltaV, dragForce, dragArea, gravity};
+}
+
+void FlightDynamics::setState(const State& state) {
+    mass = state.mass;
+    thrust = state.thrust;
+    burnRate = state.burnRate;
+    isp = state.isp;
+    velocity = state.velocity;
+    altitude = state.altitude;
+    fuel = state.fuel;
+    deltaV = state.deltaV;
+    dragForce = state.dragForce;
+    dragArea = state.dragArea;
+    gravity = state.gravity;
+}
+
+uint32_t FlightDynamics::getArmedEvents() const {
+    uint32_t mask = 0;
+    for (int i = 0; i < eventCount; ++i) {
+        if (events[i].armed) mask |= 1u << i;
+    }
+    return mask;
+}
+
+void FlightDynamics::setArmedEvents(uint32_t mask) {
+    for (int i = 0; i < eventCount; ++i) {
+        events[i].armed = (mask >> i) & 1u;
+    }
+}
@@ -1,10 +1,47 @@
 #ifndef FLIGHT_DYNAMICS_H
 #define FLIGHT_DYNAMICS_H
 
+#include "wind_model.h"
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
 
 class FlightDynamics {
 public:
+    /**
+     * @brief Complete dynamic state (plain data) - used for checkpoints and branch cloning
+     */
+    struct State {
+        double mass;
+        double thrust;
+        double burnRate;
+        double isp;
+        double velocity;
+        double altitude;
+        double fuel;
+        double deltaV;
+        double dragForce;
+        double dragArea;
+        double gravity;
+    };
+
+    // Event function g(state): an event fires where g changes sign inside a step
+    using EventFunction = std::function<double(const State&)>;
+
+    // Details of the event(s) that ended an advance() early
+    struct EventRecord {
+        std::vector<std::string> names;  // every event that crossed at this instant
+        double offset = 0;   // time into the step at which the event occurred (s)
+        State state{};
+    };
+
+    static constexpr double FUEL_CUTOFF = 1e-6;  // Engine shuts down at or below this much fuel (kg)
+    static constexpr int MAX_EVENTS = 16;        // Fixed event table: registering and advancing never allocate
+    static constexpr uint32_t ALL_PHASES = 0xFFFFFFFFu;   // Event phase mask: checked in every phase
+
     /**
      * @brief Constructor that initializes the flight dynamics properties (critical for simulation)
      * @param mass The Initial mass of the rocket (kg) - (PENDING CHANGES)
@@ -21,6 +58,39 @@ public:
      */
     void update(double dt);
 
+    /**
+     * @brief Like update(), but stops exactly on the first registered event crossing inside the step
+     * @param dt Maximum time step in seconds
+     * @param hit Filled in when an event ended the step early (may be nullptr)
+     * @return The time actually advanced (dt when no event fired)
+     */
+    double advance(double dt, EventRecord* hit);
+
+    // Plain step for headless batch runs: no event checks, no console output
+    void integrate(double dt) { setState(stepFrom(getState(), dt)); }
+
+    /**
+     * @brief Registers an event function
+     * @param name Static string (string literal) - stored by pointer
+     * @param direction +1 fires on rising crossings (- to +), -1 on falling, 0 on both
+     * @param oneShot Disarms the event after it fires once
+     * @param phases Bit i set = checked while phase i is active (see setActivePhase)
+     * @return Event id, -1 when the table is full
+     */
+    int addEvent(const char* name, EventFunction function, int direction, bool oneShot = false,
+                 uint32_t phases = ALL_PHASES);
+
+    // Phase the flight loop is in (its own numbering, < 32): events registered for other phases are skipped.
+    // Until it is set every event is checked.
+    void setActivePhase(int phase) { activePhases = 1u << phase; }
+
+    // Vehicle events every flight loop stops on: fuel depletion, max-Q, apogee, touchdown
+    // (max-Q reads this object's wind model, so register them on the instance that flies)
+    void addVehicleEvents();
+
+    // Net acceleration (m/s²) for a state - exposed for event functions such as max-Q
+    double accelerationOf(const State& s) const { return accelerationOf(s, s.mass); }
+
     // Getters for key parameters
     double getAltitude() const;
     double getVelocity() const;
@@ -29,7 +99,52 @@ public:
     double getDeltaV() const;
     double getDragForce() const;
 
+    // Setters for commanded parameter updates (CDH uplink)
+    void setThrust(double t) { thrust = t; }
+    void setBurnRate(double br) { burnRate = br; }
+    void setIsp(double i) { isp = i; }
+    void setDragArea(double area) { dragArea = area; }
+    void setConsoleWarnings(bool enabled) { consoleWarnings = enabled; }   // off for headless batch runs
+
+    /**
+     * @brief Attaches a wind model - drag is then computed against the relative wind
+     * @param wind Shared, immutable model owned by the caller (nullptr = still air)
+     */
+    void setWindModel(const WindModel* wind) { windModel = wind; }
+
+    // Side force from the cross wind (N) - input for attitude disturbance models
+    double getCrossWindForce() const;
+
+    // Checkpoint / restore of the full state
+    State getState() const;
+    void setState(const State& state);
+
+    // Armed flags of the event table (bit i = event id i), so one-shot events that already fired stay
+    // disarmed across a checkpoint; ids follow registration order, the same in every loop
+    uint32_t getArmedEvents() const;
+    void setArmedEvents(uint32_t mask);
+
 private:
+    struct FlightEvent {
+        const char* name = "";
+        EventFunction function;
+        int direction = 0;
+        bool oneShot = false;
+        bool armed = false;
+        uint32_t phases = ALL_PHASES;
+    };
+    std::array<FlightEvent, MAX_EVENTS> events;
+    static_assert(MAX_EVENTS <= 32, "armed flags are checkpointed as a 32-bit mask");
+    int eventCount = 0;
+    uint32_t activePhases = ALL_PHASES;
+    const WindModel* windModel = nullptr;
+    bool consoleWarnings = true;
+
+    State stepFrom(const State& start, double dt) const;
+    double accelerationOf(const State& s, double massCurrent) const;
+    double dragOf(const State& s, double* vertical, double* horizontal) const;
+    static bool crosses(int direction, double g0, double g1);
+
     double mass;         // The current mass of the rocket (kg) - dynamically updated
     double thrust;       // The thrust force in Newtons (N)
     double burnRate;     // The fuel consumption rate in kg/s
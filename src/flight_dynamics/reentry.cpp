@@ -0,0 +1,608 @@
+/*
+Reentry aerothermal model and stiff-aware integration.
+
+Research:
+
+1. Sutton, Graves, "A General Stagnation-Point Convective-Heating Equation for Arbitrary Gas Mixtures",
+NASA TR R-376, 1971
+https://ntrs.nasa.gov/citations/19720003329
+
+2. Verwer, Spee, Blom, Hundsdorfer, "A Second-Order Rosenbrock Method Applied to Photochemical Dispersion
+Problems", SIAM Journal on Scientific Computing 20(4), 1999
+https://doi.org/10.1137/S1064827597326651
+
+3. U.S. Standard Atmosphere, 1976 (NOAA-S/T 76-1562)
+*/
+
+#include "reentry.h"
+#include "orbital_mechanics.h"
+#include <json/json.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+
+namespace {
+
+constexpr double STANDARD_GRAVITY = 9.80665;          // m/s²
+constexpr double DEG = M_PI / 180.0;
+constexpr double GAS_CONSTANT = 287.053;              // J/(kg K), dry air
+constexpr double HEAT_RATIO = 1.4;
+constexpr double ROS2_GAMMA = 1.0 + 1.0 / M_SQRT2;    // L-stable choice
+constexpr double MAX_FLIGHT_TIME = 4.0 * 3600.0;      // s, safety stop (one orbit is ~1.5 h)
+constexpr int TOUCHDOWN_ITERATIONS = 60;
+
+// Absolute error scale per state (x tolerance): altitude, downrange, speed, flight-path angle, heat load
+constexpr double ERROR_SCALE[] = {1e5, 1e5, 1e3, 1.0, 1e6};
+
+// U.S. Standard Atmosphere 1976 below 86 km (altitude taken as geopotential): base altitude (m),
+// base temperature (K), lapse rate (K/m), base pressure (Pa)
+struct AtmosphereLayer {
+    double altitude, temperature, lapse, pressure;
+};
+constexpr AtmosphereLayer LAYERS[] = {
+    {0.0,     288.15, -0.0065, 101325.0},
+    {11000.0, 216.65,  0.0,    22632.1},
+    {20000.0, 216.65,  0.001,  5474.89},
+    {32000.0, 228.65,  0.0028, 868.019},
+    {47000.0, 270.65,  0.0,    110.906},
+    {51000.0, 270.65, -0.0028, 66.9389},
+    {71000.0, 214.65, -0.002,  3.95642},
+};
+constexpr double LAYER_TOP = 86000.0;                 // m, exponential thermosphere above
+constexpr double THERMOSPHERE_SCALE_HEIGHT = 5900.0;  // m, fits 86-120 km density
+
+struct Air {
+    double density;        // kg/m³
+    double speedOfSound;   // m/s
+};
+
+Air layeredAtmosphere(double altitude) {
+    std::size_t k = 0;
+    while (k + 1 < std::size(LAYERS) && altitude >= LAYERS[k + 1].altitude) ++k;
+    const AtmosphereLayer& layer = LAYERS[k];
+
+    double dh = altitude - layer.altitude;
+    double temperature = layer.temperature + layer.lapse * dh;
+    double pressure = layer.lapse == 0.0
+        ? layer.pressure * std::exp(-STANDARD_GRAVITY * dh / (GAS_CONSTANT * layer.temperature))
+        : layer.pressure * std::pow(temperature / layer.temperature, -STANDARD_GRAVITY / (GAS_CONSTANT * layer.lapse));
+    return Air{pressure / (GAS_CONSTANT * temperature), std::sqrt(HEAT_RATIO * GAS_CONSTANT * temperature)};
+}
+
+Air atmosphere(double altitude) {
+    altitude = std::max(altitude, 0.0);
+    if (altitude < LAYER_TOP) return layeredAtmosphere(altitude);
+
+    static const Air top = layeredAtmosphere(LAYER_TOP);
+    return Air{top.density * std::exp(-(altitude - LAYER_TOP) / THERMOSPHERE_SCALE_HEIGHT), top.speedOfSound};
+}
+
+// Index k with x[k] <= value < x[k + 1] (clamped) and the weight of x[k + 1]
+void bracket(const std::vector<double>& x, double value, std::size_t& k, double& weight) {
+    if (x.size() == 1 || value <= x.front()) { k = 0; weight = 0.0; return; }
+    if (value >= x.back()) { k = x.size() - 2; weight = 1.0; return; }
+    k = static_cast<std::size_t>(std::upper_bound(x.begin(), x.end(), value) - x.begin()) - 1;
+    weight = (value - x[k]) / (x[k + 1] - x[k]);
+}
+
+bool readJson(const std::string& path, Json::Value& root) {
+    std::ifstream file(path);
+    if (!file.is_open() || !Json::parseFromStream(Json::CharReaderBuilder(), file, &root, nullptr)) {
+        std::cerr << "[REENTRY ERROR] Could not read " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+std::vector<double> readArray(const Json::Value& array) {
+    std::vector<double> values;
+    for (const Json::Value& v : array) values.push_back(v.asDouble());
+    return values;
+}
+
+std::vector<double> readGrid(const Json::Value& rows) {
+    std::vector<double> values;
+    for (const Json::Value& row : rows) {
+        for (const Json::Value& v : row) values.push_back(v.asDouble());
+    }
+    return values;
+}
+
+// Dense 5x5 LU with partial pivoting (in place); false if singular
+template<std::size_t N>
+bool factor(std::array<std::array<double, N>, N>& a, std::array<std::size_t, N>& pivot) {
+    for (std::size_t col = 0; col < N; ++col) {
+        std::size_t best = col;
+        for (std::size_t row = col + 1; row < N; ++row) {
+            if (std::fabs(a[row][col]) > std::fabs(a[best][col])) best = row;
+        }
+        if (a[best][col] == 0.0) return false;
+        std::swap(a[col], a[best]);
+        pivot[col] = best;
+        for (std::size_t row = col + 1; row < N; ++row) {
+            a[row][col] /= a[col][col];
+            for (std::size_t j = col + 1; j < N; ++j) a[row][j] -= a[row][col] * a[col][j];
+        }
+    }
+    return true;
+}
+
+template<std::size_t N>
+void solve(const std::array<std::array<double, N>, N>& lu, const std::array<std::size_t, N>& pivot, std::array<double, N>& b) {
+    for (std::size_t col = 0; col < N; ++col) std::swap(b[col], b[pivot[col]]);   // rows were swapped whole
+    for (std::size_t row = 1; row < N; ++row) {
+        for (std::size_t j = 0; j < row; ++j) b[row] -= lu[row][j] * b[j];
+    }
+    for (std::size_t row = N; row-- > 0;) {
+        for (std::size_t j = row + 1; j < N; ++j) b[row] -= lu[row][j] * b[j];
+        b[row] /= lu[row][row];
+    }
+}
+
+} // namespace
+
+
+
+/**
+==========================================
+    Aerodynamic Tables & Configuration
+==========================================
+*/
+bool AeroTable::set(std::vector<double> machPoints, std::vector<double> alphaPoints, std::vector<double> dragGrid, std::vector<double> liftGrid) {
+    const std::size_t cells = machPoints.size() * alphaPoints.size();
+    if (machPoints.empty() || alphaPoints.empty() || dragGrid.size() != cells || liftGrid.size() != cells ||
+        !std::is_sorted(machPoints.begin(), machPoints.end()) || !std::is_sorted(alphaPoints.begin(), alphaPoints.end()) ||
+        std::adjacent_find(machPoints.begin(), machPoints.end()) != machPoints.end() ||
+        std::adjacent_find(alphaPoints.begin(), alphaPoints.end()) != alphaPoints.end()) {
+        std::cerr << "[REENTRY ERROR] Aero table needs ascending, distinct Mach / alpha breakpoints and "
+                  << "alpha x Mach coefficient grids\n";
+        return false;
+    }
+    mach = std::move(machPoints);
+    alpha = std::move(alphaPoints);
+    drag = std::move(dragGrid);
+    lift = std::move(liftGrid);
+    return true;
+}
+
+
+AeroTable::Coefficients AeroTable::at(double machNumber, double alphaDeg) const {
+    if (mach.empty()) return Coefficients{};
+    std::size_t i, j;
+    double wm, wa;
+    bracket(mach, machNumber, i, wm);
+    bracket(alpha, alphaDeg, j, wa);
+    const std::size_t i1 = std::min(i + 1, mach.size() - 1), j1 = std::min(j + 1, alpha.size() - 1);
+    const std::size_t columns = mach.size();
+
+    auto blend = [&](const std::vector<double>& grid) {
+        double low = grid[j * columns + i] + wm * (grid[j * columns + i1] - grid[j * columns + i]);
+        double high = grid[j1 * columns + i] + wm * (grid[j1 * columns + i1] - grid[j1 * columns + i]);
+        return low + wa * (high - low);
+    };
+    return Coefficients{blend(drag), blend(lift)};
+}
+
+
+bool ReentryVehicle::loadConfig(const std::string& path) {
+    Json::Value config;
+    if (!readJson(path, config)) return false;
+    const Json::Value& reentry = config["reentry"];
+
+    mass = reentry.get("mass_kg", mass).asDouble();
+    referenceArea = reentry.get("reference_area_m2", referenceArea).asDouble();
+    noseRadius = reentry.get("nose_radius_m", noseRadius).asDouble();
+    trimAngle = reentry.get("trim_alpha_deg", trimAngle).asDouble();
+    bankAngle = reentry.get("bank_deg", bankAngle).asDouble();
+    if (mass <= 0.0 || referenceArea <= 0.0 || noseRadius <= 0.0) {
+        std::cerr << "[REENTRY ERROR] Mass, reference area and nose radius must be positive\n";
+        return false;
+    }
+
+    const Json::Value& table = reentry["aero"];
+    if (!table.isObject()) {
+        std::cerr << "[REENTRY ERROR] No \"reentry.aero\" table in " << path << "\n";
+        return false;
+    }
+    return aero.set(readArray(table["mach"]), readArray(table["alpha_deg"]), readGrid(table["cd"]), readGrid(table["cl"]));
+}
+
+
+bool DeorbitScenario::loadConfig(const std::string& path) {
+    Json::Value config;
+    if (!readJson(path, config)) return false;
+    const Json::Value& reentry = config["reentry"];
+
+    orbitAltitude = reentry.get("orbit_altitude_km", orbitAltitude / 1000.0).asDouble() * 1000.0;
+    deltaV = reentry.get("deorbit_dv_mps", deltaV).asDouble();
+    return true;
+}
+
+
+
+/**
+==========================================
+    Equations Of Motion
+==========================================
+
+With r = R + h, g = mu / r², D = q S Cd(M, alpha), L = q S Cl(M, alpha) and bank angle sigma:
+    dh/dt = V sin(gamma)
+    ds/dt = V cos(gamma) R / r
+    dV/dt = -D / m - g sin(gamma)
+    dgamma/dt = L cos(sigma) / (m V) - (g / V - V / r) cos(gamma)
+    dQ/dt = k sqrt(rho / Rn) V³
+*/
+ReentryModel::ReentryModel(const ReentryVehicle& config) : vehicle(config) {}
+
+
+ReentryConditions ReentryModel::conditionsAt(const ReentryState& s) const {
+    ReentryConditions c;
+    Air air = atmosphere(s.altitude);
+    double speed = std::fabs(s.velocity);
+
+    c.density = air.density;
+    c.mach = speed / air.speedOfSound;
+    c.dynamicPressure = 0.5 * air.density * speed * speed;
+    c.coefficients = vehicle.aero.at(c.mach, vehicle.trimAngle);
+    c.dragForce = c.dynamicPressure * vehicle.referenceArea * c.coefficients.drag;
+    c.heatFlux = SUTTON_GRAVES_K * std::sqrt(air.density / vehicle.noseRadius) * speed * speed * speed;
+    c.deceleration = c.dynamicPressure * vehicle.referenceArea * std::hypot(c.coefficients.drag, c.coefficients.lift)
+                   / (vehicle.mass * STANDARD_GRAVITY);
+    return c;
+}
+
+
+void ReentryModel::derivatives(const Vector& y, Vector& dy) const {
+    const double altitude = y[0], speed = std::max(y[2], 1e-3), gamma = y[3];
+    const double radius = R_EARTH + altitude;
+    const double gravity = MU_EARTH / (radius * radius);
+
+    ReentryConditions c = conditionsAt(ReentryState{0.0, altitude, y[1], speed, gamma, y[4]});
+    const double drag = c.dragForce / vehicle.mass;
+    const double lift = c.dynamicPressure * vehicle.referenceArea * c.coefficients.lift / vehicle.mass;
+
+    dy[0] = speed * std::sin(gamma);
+    dy[1] = speed * std::cos(gamma) * R_EARTH / radius;
+    dy[2] = -drag - gravity * std::sin(gamma);
+    dy[3] = lift * std::cos(vehicle.bankAngle * DEG) / speed - (gravity / speed - speed / radius) * std::cos(gamma);
+    dy[4] = c.heatFlux;
+}
+
+
+ReentryModel::Vector ReentryModel::pack(const ReentryState& s) {
+    return Vector{s.altitude, s.downrange, s.velocity, s.flightPathAngle, s.heatLoad};
+}
+
+
+ReentryState ReentryModel::unpack(const Vector& y, double time) {
+    return ReentryState{time, y[0], y[1], y[2], y[3], y[4]};
+}
+
+
+
+/**
+==========================================
+    One Step (Euler / RK4 / ROS2)
+==========================================
+
+ROS2 with W = I - gamma h J (J by forward differences, one 5x5 LU per step):
+    W k1 = h f(y)
+    W k2 = h f(y + k1) - 2 k1
+    y+ = y + 3/2 k1 + 1/2 k2
+The first stage alone, y + k1, is the linearly implicit Euler solution; `error` is the scaled RMS of
+y+ - (y + k1) = (k1 + k2) / 2, weighted by tolerance x (ERROR_SCALE + |y|).
+*/
+ReentryModel::Vector ReentryModel::stepWith(Method method, const Vector& y, double h, double* error) {
+    Vector f0, next;
+    derivatives(y, f0);
+    evaluations++;
+
+    if (method == Method::EULER) {
+        for (std::size_t i = 0; i < N; ++i) next[i] = y[i] + h * f0[i];
+        return next;
+    }
+
+    if (method == Method::RK4) {
+        Vector k2, k3, k4, probe;
+        for (std::size_t i = 0; i < N; ++i) probe[i] = y[i] + 0.5 * h * f0[i];
+        derivatives(probe, k2);
+        for (std::size_t i = 0; i < N; ++i) probe[i] = y[i] + 0.5 * h * k2[i];
+        derivatives(probe, k3);
+        for (std::size_t i = 0; i < N; ++i) probe[i] = y[i] + h * k3[i];
+        derivatives(probe, k4);
+        evaluations += 3;
+        for (std::size_t i = 0; i < N; ++i) next[i] = y[i] + h / 6.0 * (f0[i] + 2.0 * k2[i] + 2.0 * k3[i] + k4[i]);
+        return next;
+    }
+
+    // ROS2 is a W-method (order 2 with any approximate Jacobian), so J is refreshed only every
+    // JACOBIAN_REUSE steps or after a rejected step
+    if (jacobianAge < 0 || jacobianAge >= JACOBIAN_REUSE) {
+        for (std::size_t j = 0; j < N; ++j) {
+            Vector probe = y, fj;
+            double delta = std::sqrt(std::numeric_limits<double>::epsilon()) * std::max(std::fabs(y[j]), 1e-3 * ERROR_SCALE[j]);
+            probe[j] += delta;
+            derivatives(probe, fj);
+            for (std::size_t i = 0; i < N; ++i) jacobian[i][j] = (fj[i] - f0[i]) / delta;
+        }
+        evaluations += N;
+        jacobianAge = 0;
+    }
+    jacobianAge++;
+
+    std::array<std::array<double, N>, N> w;
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j < N; ++j) w[i][j] = (i == j ? 1.0 : 0.0) - ROS2_GAMMA * h * jacobian[i][j];
+    }
+
+    std::array<std::size_t, N> pivot;
+    Vector k1, k2, f1, probe;
+    if (!factor(w, pivot)) {
+        if (error) *error = std::numeric_limits<double>::infinity();
+        return y;
+    }
+    for (std::size_t i = 0; i < N; ++i) k1[i] = h * f0[i];
+    solve(w, pivot, k1);
+
+    for (std::size_t i = 0; i < N; ++i) probe[i] = y[i] + k1[i];
+    derivatives(probe, f1);
+    evaluations++;
+    for (std::size_t i = 0; i < N; ++i) k2[i] = h * f1[i] - 2.0 * k1[i];
+    solve(w, pivot, k2);
+
+    double sum = 0.0;
+    for (std::size_t i = 0; i < N; ++i) {
+        next[i] = y[i] + 1.5 * k1[i] + 0.5 * k2[i];
+        double weight = tolerance * (ERROR_SCALE[i] + std::max(std::fabs(y[i]), std::fabs(next[i])));
+        double e = 0.5 * (k1[i] + k2[i]) / weight;
+        sum += e * e;
+    }
+    if (error) *error = std::isfinite(sum) ? std::sqrt(sum / N) : std::numeric_limits<double>::infinity();
+    return next;
+}
+
+
+// Step length that ends exactly on the ground: Illinois regula falsi on the altitude after a step of tau
+double ReentryModel::touchdownWithin(Method method, const Vector& y, double h) {
+    double a = 0.0, fa = y[0];
+    double b = h, fb = stepWith(method, y, h, nullptr)[0];
+    int side = 0;
+
+    for (int iteration = 0; iteration < TOUCHDOWN_ITERATIONS && (b - a) > TOUCHDOWN_TOLERANCE; ++iteration) {
+        double c = (a * fb - b * fa) / (fb - fa);
+        if (!(c > a && c < b)) c = 0.5 * (a + b);
+        double fc = stepWith(method, y, c, nullptr)[0];
+
+        if ((fc > 0) == (fb > 0) && fc != 0) {
+            b = c; fb = fc;
+            if (side == -1) fa *= 0.5;
+            side = -1;
+        } else {
+            a = c; fa = fc;
+            if (side == +1) fb *= 0.5;
+            side = +1;
+        }
+    }
+    return b;
+}
+
+
+void ReentryModel::track(const ReentryState& s) {
+    ReentryConditions c = conditionsAt(s);
+    peakHeatFlux = std::max(peakHeatFlux, c.heatFlux);
+    peakDeceleration = std::max(peakDeceleration, c.deceleration);
+    peakDynamicPressure = std::max(peakDynamicPressure, c.dynamicPressure);
+}
+
+
+
+/**
+==========================================
+    Adaptive Integration
+==========================================
+*/
+void ReentryModel::reset(const ReentryState& start) {
+    state = start;
+    stepSize = 1.0;
+    landed = false;
+    peakHeatFlux = peakDeceleration = peakDynamicPressure = 0.0;
+    steps = rejected = evaluations = 0;
+    jacobianAge = -1;
+    track(state);
+}
+
+
+ReentryModel::Snapshot ReentryModel::snapshot() const {
+    return Snapshot{state, stepSize, landed, peakHeatFlux, peakDeceleration, peakDynamicPressure,
+                    steps, rejected, evaluations, jacobian, jacobianAge};
+}
+
+
+void ReentryModel::restore(const Snapshot& snapshot) {
+    state = snapshot.state;
+    stepSize = snapshot.stepSize;
+    landed = snapshot.landed;
+    peakHeatFlux = snapshot.peakHeatFlux;
+    peakDeceleration = snapshot.peakDeceleration;
+    peakDynamicPressure = snapshot.peakDynamicPressure;
+    steps = snapshot.steps;
+    rejected = snapshot.rejected;
+    evaluations = snapshot.evaluations;
+    jacobian = snapshot.jacobian;
+    jacobianAge = snapshot.jacobianAge;
+}
+
+
+double ReentryModel::advance(double dt) {
+    Vector y = pack(state);
+    double elapsed = 0.0;
+
+    while (!landed && elapsed < dt) {
+        const double h = std::min(stepSize, dt - elapsed);
+        double error = 0.0;
+        Vector next = stepWith(Method::ROS2, y, h, &error);
+
+        // Local error ~ h², so the step scales with error^(-1/2)
+        double growth = std::clamp(0.9 / std::sqrt(std::max(error, 1e-12)), 0.2, 5.0);
+        if (error > 1.0 && h > MIN_STEP) {
+            stepSize = std::max(h * growth, MIN_STEP);
+            jacobianAge = -1;
+            rejected++;
+            continue;
+        }
+
+        double taken = h;
+        if (next[0] <= 0.0) {
+            taken = touchdownWithin(Method::ROS2, y, h);
+            next = stepWith(Method::ROS2, y, taken, nullptr);
+            next[0] = 0.0;
+            landed = true;
+        }
+
+        y = next;
+        elapsed += taken;
+        steps++;
+        track(unpack(y, state.time + elapsed));
+        // A step cut short by the end of dt says nothing about the step size that would pass
+        stepSize = std::clamp(h < stepSize ? std::max(stepSize, h * growth) : h * growth, MIN_STEP, MAX_STEP);
+    }
+
+    state = unpack(y, state.time + elapsed);
+    return elapsed;
+}
+
+
+
+/**
+==========================================
+    Integrator Benchmark (--bench-reentry)
+==========================================
+
+Every run starts on the same circular orbit right after the retrograde burn and flies to touchdown:
+about half an orbit of coast, entry interface, the deceleration pulse and the subsonic descent.
+Peaks are sampled at step ends, so coarse fixed steps also miss some of the peak.
+*/
+ReentryModel::Flight ReentryModel::fly(Method method, double h, bool adaptive) {
+    auto start = std::chrono::steady_clock::now();
+    Flight flight;
+
+    if (adaptive) {
+        while (!landed && state.time < MAX_FLIGHT_TIME && std::isfinite(state.altitude)) advance(MAX_FLIGHT_TIME);
+    } else {
+        Vector y = pack(state);
+        double time = state.time;
+        while (!landed && time < MAX_FLIGHT_TIME) {
+            Vector next = stepWith(method, y, h, nullptr);
+            double taken = h;
+            if (!std::isfinite(next[0]) || !std::isfinite(next[2])) break;
+            if (next[0] <= 0.0) {
+                taken = touchdownWithin(method, y, h);
+                next = stepWith(method, y, taken, nullptr);
+                next[0] = 0.0;
+                landed = true;
+            }
+            y = next;
+            time += taken;
+            steps++;
+            track(unpack(y, time));
+        }
+        state = unpack(y, time);
+    }
+
+    flight.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    flight.landed = landed;
+    flight.final = state;
+    flight.peakHeatFlux = peakHeatFlux;
+    flight.peakDeceleration = peakDeceleration;
+    flight.steps = steps;
+    flight.evaluations = evaluations;
+    return flight;
+}
+
+
+void ReentryModel::benchmark(const ReentryVehicle& vehicle, const DeorbitScenario& scenario) {
+    const double radius = R_EARTH + scenario.orbitAltitude;
+    ReentryState start;
+    start.altitude = scenario.orbitAltitude;
+    start.velocity = std::sqrt(MU_EARTH / radius) - scenario.deltaV;
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "        Reentry Integrator Bench        " << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::fixed << std::setprecision(1)
+              << "[BENCH] " << scenario.orbitAltitude / 1000.0 << " km circular orbit, " << scenario.deltaV
+              << " m/s retrograde | " << vehicle.mass << " kg, " << vehicle.referenceArea << " m², nose radius "
+              << vehicle.noseRadius << " m | alpha " << vehicle.trimAngle << " deg, bank " << vehicle.bankAngle << " deg\n";
+
+    struct Case {
+        const char* name;
+        Method method;
+        double parameter;          // step (s), or tolerance for the adaptive runs
+        bool adaptive;
+    };
+    const Case reference{"RK4 reference", Method::RK4, 0.01, false};
+    const Case cases[] = {
+        {"Euler (flight loop)", Method::EULER, 0.1, false},
+        {"Euler", Method::EULER, 1.0, false},
+        {"RK4", Method::RK4, 0.1, false},
+        {"RK4", Method::RK4, 1.0, false},
+        {"RK4", Method::RK4, 5.0, false},
+        {"RK4", Method::RK4, 20.0, false},
+        {"ROS2 fixed", Method::ROS2, 5.0, false},
+        {"ROS2 fixed", Method::ROS2, 20.0, false},
+        {"ROS2 adaptive", Method::ROS2, 1e-4, true},
+        {"ROS2 adaptive", Method::ROS2, 1e-6, true},
+        {"ROS2 adaptive", Method::ROS2, 1e-8, true},
+    };
+
+    auto run = [&](const Case& c) {
+        ReentryModel model(vehicle);
+        if (c.adaptive) model.setTolerance(c.parameter);
+        model.reset(start);
+        return model.fly(c.method, c.parameter, c.adaptive);
+    };
+
+    Flight truth = run(reference);
+    if (!truth.landed) {
+        std::cerr << "[BENCH ERROR] Reference run did not reach the ground (orbit not decaying?)\n";
+        return;
+    }
+    std::cout << std::setprecision(2)
+              << "[BENCH] Reference (RK4, 0.01 s): touchdown T+" << truth.final.time << " s, " << truth.final.downrange / 1000.0
+              << " km downrange at " << truth.final.velocity << " m/s | Peak heat flux " << truth.peakHeatFlux / 1e4
+              << " W/cm² | Heat load " << truth.final.heatLoad / 1e7 << " kJ/cm² | Peak " << truth.peakDeceleration
+              << " g | " << truth.steps << " steps in " << truth.seconds * 1000.0 << " ms\n";
+
+    std::cout << "[BENCH] " << std::left << std::setw(20) << "Method" << std::right << std::setw(10) << "Step/Tol"
+              << std::setw(9) << "Steps" << std::setw(10) << "f-evals" << std::setw(10) << "ms"
+              << std::setw(11) << "dT (s)" << std::setw(13) << "dRange (km)" << std::setw(11) << "dPeak q %"
+              << std::setw(11) << "dLoad %" << std::setw(11) << "dPeak g %" << "\n";
+
+    auto percent = [](double value, double exact) { return 100.0 * (value - exact) / exact; };
+    for (const Case& c : cases) {
+        Flight f = run(c);
+        std::ostringstream parameter;
+        if (c.adaptive) parameter << std::scientific << std::setprecision(0) << c.parameter;
+        else parameter << std::fixed << std::setprecision(c.parameter < 1.0 ? 2 : 1) << c.parameter << " s";
+
+        std::cout << "[BENCH] " << std::left << std::setw(20) << c.name << std::right << std::setw(10) << parameter.str()
+                  << std::setw(9) << f.steps << std::setw(10) << f.evaluations << std::setw(10) << std::setprecision(2)
+                  << f.seconds * 1000.0;
+        if (!f.landed) {
+            std::cout << "   diverged / no touchdown\n";
+            continue;
+        }
+        std::cout << std::setprecision(3) << std::setw(11) << f.final.time - truth.final.time
+                  << std::setw(13) << (f.final.downrange - truth.final.downrange) / 1000.0
+                  << std::setw(11) << percent(f.peakHeatFlux, truth.peakHeatFlux)
+                  << std::setw(11) << percent(f.final.heatLoad, truth.final.heatLoad)
+                  << std::setw(11) << percent(f.peakDeceleration, truth.peakDeceleration) << "\n";
+    }
+    std::cout << std::defaultfloat;
+}
@@ -0,0 +1,184 @@
+#ifndef REENTRY_H
+#define REENTRY_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+
+/**
+ * @brief Aerodynamic coefficients tabulated over Mach x angle of attack
+ * - Loaded once from the "reentry" block of program_configuration.json; at() interpolates bilinearly and
+ *   holds the edge values outside the table.
+ */
+class AeroTable {
+public:
+    struct Coefficients {
+        double drag = 0.0;
+        double lift = 0.0;
+    };
+
+    // mach / alpha ascending; drag / lift row-major [alpha][mach]
+    bool set(std::vector<double> mach, std::vector<double> alpha, std::vector<double> drag, std::vector<double> lift);
+    Coefficients at(double mach, double alphaDeg) const;
+    bool isEmpty() const { return mach.empty(); }
+
+private:
+    std::vector<double> mach, alpha;        // breakpoints (-, deg)
+    std::vector<double> drag, lift;         // alpha.size() x mach.size()
+};
+
+
+// Entry vehicle ("reentry" block of program_configuration.json; defaults: Apollo-class capsule)
+struct ReentryVehicle {
+    double mass = 5500.0;                   // kg
+    double referenceArea = 12.0;            // m²
+    double noseRadius = 4.7;                // m, heat-shield radius of curvature (stagnation point)
+    double trimAngle = 20.0;                // deg, angle of attack held through entry
+    double bankAngle = 55.0;                // deg, lift vector from vertical (0 = full lift up)
+    AeroTable aero;
+
+    bool loadConfig(const std::string& path);
+};
+
+
+// Deorbit scenario for --bench-reentry: circular orbit and an impulsive retrograde burn
+struct DeorbitScenario {
+    double orbitAltitude = 200000.0;        // m
+    double deltaV = 75.0;                   // m/s
+
+    bool loadConfig(const std::string& path);
+};
+
+
+// Planar flight over a spherical, non-rotating Earth
+struct ReentryState {
+    double time = 0.0;                      // s
+    double altitude = 0.0;                  // m
+    double downrange = 0.0;                 // m, along the surface
+    double velocity = 0.0;                  // m/s
+    double flightPathAngle = 0.0;           // rad, negative descending
+    double heatLoad = 0.0;                  // J/m², integrated stagnation-point heat flux
+};
+
+
+// Air data and loads at one state
+struct ReentryConditions {
+    double density = 0.0;                   // kg/m³
+    double mach = 0.0;
+    double dynamicPressure = 0.0;           // Pa
+    double heatFlux = 0.0;                  // W/m², Sutton-Graves stagnation point
+    double deceleration = 0.0;              // g, aerodynamic (drag and lift)
+    double dragForce = 0.0;                 // N
+    AeroTable::Coefficients coefficients;
+};
+
+
+
+/**
+==========================================
+    Reentry Aerothermal Model
+==========================================
+
+- Entry equations of motion for (altitude, downrange, speed, flight-path angle) at the trim angle of attack
+  and a constant bank angle; drag and lift from the Mach x alpha tables, US Standard Atmosphere 1976 for
+  density and speed of sound. The heat load is a fifth state, so it is integrated to the same accuracy.
+- Heating: Sutton-Graves, q = k sqrt(rho / Rn) V³ with k = 1.7415e-4 (Earth air, SI).
+- Integration: ROS2 (2-stage, L-stable Rosenbrock W-method, order 2): one LU factorization per step, the
+  finite-difference Jacobian reused for JACOBIAN_REUSE steps. The embedded first-order solution drives
+  the step size, so the coast before entry interface takes steps of tens of seconds and the deceleration
+  pulse takes what accuracy needs; L-stability keeps large steps from going unstable where the drag terms get stiff.
+- advance() integrates up to dt with as many adaptive steps as needed and stops exactly at touchdown.
+- benchmark() flies deorbit-to-touchdown with explicit Euler (the flight loop's fixed-step scheme), RK4 and
+  ROS2 against a fine RK4 reference and reports accuracy and cost per method.
+*/
+class ReentryModel {
+private:
+    static constexpr std::size_t N = 5;                  // altitude, downrange, speed, flight-path angle, heat load
+
+public:
+    static constexpr double ENTRY_INTERFACE = 120000.0;  // m
+    static constexpr double SUTTON_GRAVES_K = 1.7415e-4; // kg^0.5 / m, Earth air
+    static constexpr double TOLERANCE = 1e-6;            // relative local error per step
+    static constexpr double MIN_STEP = 1e-4;             // s
+    static constexpr double MAX_STEP = 60.0;             // s
+    static constexpr double TOUCHDOWN_TOLERANCE = 1e-6;  // s
+    static constexpr int JACOBIAN_REUSE = 10;            // ROS2 steps per finite-difference Jacobian
+
+    // Everything advance() depends on besides the vehicle (checkpoints)
+    struct Snapshot {
+        ReentryState state;
+        double stepSize = 1.0;
+        bool landed = false;
+        double peakHeatFlux = 0.0, peakDeceleration = 0.0, peakDynamicPressure = 0.0;
+        uint64_t steps = 0, rejected = 0, evaluations = 0;
+        std::array<std::array<double, N>, N> jacobian{};
+        int jacobianAge = -1;
+    };
+
+    explicit ReentryModel(const ReentryVehicle& vehicle);
+
+    void setVehicle(const ReentryVehicle& config) { vehicle = config; }
+    void setTolerance(double relative) { tolerance = relative; }
+    void reset(const ReentryState& state);
+
+    /**
+     * @brief Integrates up to dt (adaptive ROS2 steps); stops at touchdown
+     * @return The time actually advanced
+     */
+    double advance(double dt);
+
+    Snapshot snapshot() const;
+    void restore(const Snapshot& snapshot);
+
+    const ReentryState& getState() const { return state; }
+    ReentryConditions conditions() const { return conditionsAt(state); }
+    bool hasLanded() const { return landed; }
+
+    // Peaks since reset()
+    double getPeakHeatFlux() const { return peakHeatFlux; }
+    double getPeakDeceleration() const { return peakDeceleration; }
+    double getPeakDynamicPressure() const { return peakDynamicPressure; }
+    uint64_t getSteps() const { return steps; }
+    uint64_t getRejectedSteps() const { return rejected; }
+
+    // Circular orbit + retrograde burn, flown to touchdown by each integrator; prints error and cost
+    static void benchmark(const ReentryVehicle& vehicle, const DeorbitScenario& scenario);
+
+private:
+    using Vector = std::array<double, N>;
+    enum class Method { EULER, RK4, ROS2 };
+
+    // One benchmark run
+    struct Flight {
+        bool landed = false;
+        ReentryState final;
+        double peakHeatFlux = 0.0, peakDeceleration = 0.0;
+        uint64_t steps = 0, evaluations = 0;
+        double seconds = 0.0;
+    };
+
+    ReentryVehicle vehicle;
+    ReentryState state;
+    double tolerance = TOLERANCE;
+    double stepSize = 1.0;                               // s, carried between advance() calls
+    std::array<std::array<double, N>, N> jacobian{};
+    int jacobianAge = -1;                                // steps since the Jacobian was formed (< 0: stale)
+    bool landed = false;
+    double peakHeatFlux = 0.0, peakDeceleration = 0.0, peakDynamicPressure = 0.0;
+    uint64_t steps = 0, rejected = 0, evaluations = 0;
+
+    ReentryConditions conditionsAt(const ReentryState& s) const;
+    void derivatives(const Vector& y, Vector& dy) const;
+    Vector stepWith(Method method, const Vector& y, double h, double* error);
+    double touchdownWithin(Method method, const Vector& y, double h);
+    void track(const ReentryState& s);
+    Flight fly(Method method, double h, bool adaptive);   // from the current state to touchdown
+
+    static Vector pack(const ReentryState& s);
+    static ReentryState unpack(const Vector& y, double time);
+};
+
+#endif
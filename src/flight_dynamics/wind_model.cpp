@@ -0,0 +1,215 @@
+/*
+Wind environment for the flight dynamics: a mean wind profile built from the surface observation and
+a Dryden-style turbulence field that is generated ahead of the run.
+
+Research:
+
+1. MIL-F-8785C, Flying Qualities of Piloted Airplanes - Dryden turbulence scales and intensities
+2. NASA TM-2008-215304, Terrestrial Environment (Climatic) Criteria Guidelines for Use in Aerospace Vehicle Development
+https://ntrs.nasa.gov/citations/20080034896
+*/
+
+#include "wind_model.h"
+#include "counter_rng.h"
+#include <json/json.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+
+namespace {
+
+constexpr double FEET_PER_METER = 3.28084;
+constexpr double LOW_ALTITUDE_TOP_FT = 1000.0;     // Dryden low-altitude model below this
+constexpr double MEDIUM_ALTITUDE_BASE_FT = 2000.0; // Medium/high-altitude model above this
+constexpr double HIGH_ALTITUDE_SCALE_FT = 1750.0;
+constexpr double HIGH_ALTITUDE_SIGMA = 1.5;        // Light turbulence intensity aloft (m/s)
+constexpr double TURBULENCE_CEILING = 30000.0;     // Intensity tapers to zero here (m)
+
+struct DrydenParameters {
+    double lengthU, lengthW;   // Scale lengths (m)
+    double sigmaU, sigmaW;     // Intensities (m/s)
+};
+
+/**
+ * MIL-F-8785C scale lengths / intensities at altitude h, with W20 the mean wind at 20 ft.
+ * The 1000-2000 ft band blends the low- and medium-altitude models linearly.
+ */
+DrydenParameters drydenAt(double altitude, double w20) {
+    double hFt = std::max(altitude * FEET_PER_METER, 10.0);
+
+    auto lowAltitude = [w20](double h) {
+        double k = 0.177 + 0.000823 * h;
+        DrydenParameters p;
+        p.lengthW = h / FEET_PER_METER;
+        p.lengthU = h / std::pow(k, 1.2) / FEET_PER_METER;
+        p.sigmaW = 0.1 * w20;
+        p.sigmaU = p.sigmaW / std::pow(k, 0.4);
+        return p;
+    };
+
+    double taper = std::clamp(1.0 - altitude / TURBULENCE_CEILING, 0.0, 1.0);
+    DrydenParameters high{HIGH_ALTITUDE_SCALE_FT / FEET_PER_METER, HIGH_ALTITUDE_SCALE_FT / FEET_PER_METER,
+                          HIGH_ALTITUDE_SIGMA * taper, HIGH_ALTITUDE_SIGMA * taper};
+
+    if (hFt <= LOW_ALTITUDE_TOP_FT) return lowAltitude(hFt);
+    if (hFt >= MEDIUM_ALTITUDE_BASE_FT) return high;
+
+    DrydenParameters low = lowAltitude(LOW_ALTITUDE_TOP_FT);
+    double f = (hFt - LOW_ALTITUDE_TOP_FT) / (MEDIUM_ALTITUDE_BASE_FT - LOW_ALTITUDE_TOP_FT);
+    return DrydenParameters{
+        low.lengthU + f * (high.lengthU - low.lengthU),
+        low.lengthW + f * (high.lengthW - low.lengthW),
+        low.sigmaU + f * (high.sigmaU - low.sigmaU),
+        low.sigmaW + f * (high.sigmaW - low.sigmaW),
+    };
+}
+
+}  // namespace
+
+
+
+// Default upper-level layers: a generic mid-latitude profile with a jet stream near the tropopause
+WindModel::WindModel(std::pmr::memory_resource* memory)
+    : upperLayers({{5000.0, 20.0}, {11000.0, 40.0}, {20000.0, 10.0}, {30000.0, 5.0}}, memory),
+      gustU(memory), gustV(memory), gustW(memory) {}
+
+
+
+/**
+==========================================
+    Load The Surface Observation
+==========================================
+*/
+bool WindModel::loadWeather(const std::string& path) {
+    std::ifstream file(path);
+    Json::Value weather;
+
+    if (!file.is_open() || !Json::parseFromStream(Json::CharReaderBuilder(), file, &weather, nullptr)) {
+        std::cerr << "[WIND WARNING] Could not read " << path << " - assuming calm winds.\n";
+        return false;
+    }
+
+    surfaceSpeed = std::max(weather.get("wind_speed_mps", 0.0).asDouble(), 0.0);
+
+    if (weather.isMember("upper_wind_layers") && weather["upper_wind_layers"].isArray()) {
+        std::vector<WindLayer> layers;
+        for (const auto& layer : weather["upper_wind_layers"]) {
+            layers.push_back({layer.get("altitude_m", 0.0).asDouble(), layer.get("speed_mps", 0.0).asDouble()});
+        }
+        setUpperLayers(layers);
+    }
+
+    return true;
+}
+
+
+void WindModel::setUpperLayers(const std::vector<WindLayer>& layers) {
+    upperLayers.assign(layers.begin(), layers.end());
+    std::sort(upperLayers.begin(), upperLayers.end(),
+              [](const WindLayer& a, const WindLayer& b) { return a.altitude < b.altitude; });
+}
+
+
+
+/**
+==========================================
+    Mean Wind Profile
+==========================================
+
+    h < 10 m          log law:    V10 * ln(h / z0) / ln(10 / z0)
+    10 m .. top       power law:  V10 * (h / 10)^(1/7)
+    above top         linear interpolation through the upper layers, constant above the last one
+*/
+double WindModel::meanWind(double altitude) const {
+    if (altitude <= ROUGHNESS_LENGTH) return 0.0;
+
+    if (altitude < REFERENCE_HEIGHT) {
+        return surfaceSpeed * std::log(altitude / ROUGHNESS_LENGTH) / std::log(REFERENCE_HEIGHT / ROUGHNESS_LENGTH);
+    }
+    if (altitude <= surfaceLayerTop || upperLayers.empty()) {
+        double h = std::min(altitude, surfaceLayerTop);
+        return surfaceSpeed * std::pow(h / REFERENCE_HEIGHT, POWER_LAW_EXPONENT);
+    }
+
+    double lowerAltitude = surfaceLayerTop;
+    double lowerSpeed = surfaceSpeed * std::pow(surfaceLayerTop / REFERENCE_HEIGHT, POWER_LAW_EXPONENT);
+
+    for (const WindLayer& layer : upperLayers) {
+        if (layer.altitude <= lowerAltitude) continue;
+        if (altitude <= layer.altitude) {
+            double f = (altitude - lowerAltitude) / (layer.altitude - lowerAltitude);
+            return lowerSpeed + f * (layer.speed - lowerSpeed);
+        }
+        lowerAltitude = layer.altitude;
+        lowerSpeed = layer.speed;
+    }
+    return lowerSpeed;
+}
+
+
+
+/**
+==========================================
+    Precompute The Turbulence Field (once per run)
+==========================================
+
+Frozen turbulence along the altitude axis. Each component is an Ornstein-Uhlenbeck (first-order
+Dryden) process in distance, discretized exactly:
+    x[k+1] = φ x[k] + σ sqrt(1 - φ²) n[k],    φ = exp(-Δh / L)
+All normals n[k] come from one bulk fill; only the cheap recursion is sequential.
+*/
+void WindModel::generateTurbulence(uint64_t seed, double maxAltitude, double gridSpacing) {
+    spacing = gridSpacing;
+    const std::size_t count = static_cast<std::size_t>(maxAltitude / spacing) + 2;
+
+    std::pmr::vector<double> normals(3 * count, gustU.get_allocator());
+    CounterRng rng(seed);
+    rng.fillNormal(normals.data(), normals.size(), 0);
+
+    gustU.assign(count, 0.0);
+    gustV.assign(count, 0.0);
+    gustW.assign(count, 0.0);
+
+    const double w20 = meanWind(20.0 / FEET_PER_METER);
+    const double* nu = normals.data();
+    const double* nv = nu + count;
+    const double* nw = nv + count;
+
+    DrydenParameters p0 = drydenAt(0.0, w20);
+    gustU[0] = p0.sigmaU * nu[0];
+    gustV[0] = p0.sigmaU * nv[0];
+    gustW[0] = p0.sigmaW * nw[0];
+
+    for (std::size_t k = 1; k < count; ++k) {
+        DrydenParameters p = drydenAt(k * spacing, w20);
+        double phiU = std::exp(-spacing / p.lengthU);
+        double phiW = std::exp(-spacing / p.lengthW);
+        double gainU = p.sigmaU * std::sqrt(1.0 - phiU * phiU);
+        double gainW = p.sigmaW * std::sqrt(1.0 - phiW * phiW);
+
+        gustU[k] = phiU * gustU[k - 1] + gainU * nu[k];
+        gustV[k] = phiU * gustV[k - 1] + gainU * nv[k];   // lateral shares the longitudinal scale (L_v = L_u)
+        gustW[k] = phiW * gustW[k - 1] + gainW * nw[k];
+    }
+}
+
+
+
+// Indexed lookup with linear interpolation between grid points
+WindSample WindModel::sample(double altitude) const {
+    WindSample wind{meanWind(altitude), 0.0, 0.0};
+
+    if (gustU.empty() || altitude < 0.0) return wind;
+
+    double position = altitude / spacing;
+    std::size_t k = static_cast<std::size_t>(position);
+    if (k + 1 >= gustU.size()) return wind;
+
+    double f = position - static_cast<double>(k);
+    wind.horizontal += gustU[k] + f * (gustU[k + 1] - gustU[k]);
+    wind.lateral = gustV[k] + f * (gustV[k + 1] - gustV[k]);
+    wind.vertical = gustW[k] + f * (gustW[k + 1] - gustW[k]);
+    return wind;
+}
@@ -0,0 +1,77 @@
+#ifndef WIND_MODEL_H
+#define WIND_MODEL_H
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+
+// Wind relative to the ground at one altitude (m/s)
+struct WindSample {
+    double horizontal;   // Along the mean wind direction (mean + longitudinal gust)
+    double lateral;      // Cross-wind gust component
+    double vertical;     // Vertical gust (positive up)
+};
+
+
+// Upper-level wind layer - speeds are interpolated linearly between layers
+struct WindLayer {
+    double altitude;     // m
+    double speed;        // m/s
+};
+
+
+
+/**
+==========================================
+    Wind Model (Mean Profile + Precomputed Turbulence)
+==========================================
+
+- Mean profile from the surface observation in weather_conditions.json:
+    log law below 10 m, power law (α = 1/7) up to the surface layer top, then configurable upper layers.
+- Dryden-style turbulence (MIL-F-8785C scales and intensities) is generated in bulk once per run
+  as a frozen field over altitude: a batch of normals from the counter-based RNG, then a first-order
+  spatial filter per component. During flight each step only does an indexed lookup.
+- Immutable after generateTurbulence(), so branch/batch runs can share one instance across threads.
+- All buffers come from the given memory resource, so a batch worker can build its per-run model in its arena.
+*/
+class WindModel {
+private:
+    double surfaceSpeed = 0.0;                 // 10 m reference wind (m/s)
+    double surfaceLayerTop = 300.0;            // m
+    std::pmr::vector<WindLayer> upperLayers;
+
+    // Turbulence buffers, sampled every `spacing` metres from the ground up
+    double spacing = 10.0;
+    std::pmr::vector<double> gustU, gustV, gustW;
+
+public:
+    static constexpr double REFERENCE_HEIGHT = 10.0;      // Anemometer height (m)
+    static constexpr double POWER_LAW_EXPONENT = 1.0 / 7.0;
+    static constexpr double ROUGHNESS_LENGTH = 0.03;      // Open terrain (m)
+
+    explicit WindModel(std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+    /**
+     * @brief Loads the surface wind (wind_speed_mps) and optional "upper_wind_layers"
+     * @return false if the file is missing or malformed (the model then stays calm)
+     */
+    bool loadWeather(const std::string& path);
+
+    void setSurfaceSpeed(double speed) { surfaceSpeed = speed; }
+    void setUpperLayers(const std::vector<WindLayer>& layers);
+
+    /**
+     * @brief Precomputes the turbulence field for one run
+     * @param seed Run seed - the same seed gives the same field
+     * @param maxAltitude Top of the field (m); above it the gusts are zero
+     * @param gridSpacing Altitude resolution (m)
+     */
+    void generateTurbulence(uint64_t seed, double maxAltitude = 100000.0, double gridSpacing = 10.0);
+
+    double meanWind(double altitude) const;
+    WindSample sample(double altitude) const;
+};
+
+#endif
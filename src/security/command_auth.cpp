@@ -0,0 +1,189 @@
+#include "command_auth.h"
+#include <openssl/core_names.h>
+#include <openssl/crypto.h>
+#include <openssl/params.h>
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+
+CommandAuthenticator::~CommandAuthenticator() {
+    EVP_MAC_CTX_free(ctx);
+    EVP_MAC_free(mac);
+}
+
+
+
+/**
+==========================================
+    Key the HMAC Context (once)
+==========================================
+*/
+bool CommandAuthenticator::initialize(const uint8_t* key, std::size_t length) {
+    if (!mac) {
+        mac = EVP_MAC_fetch(NULL, "HMAC", NULL);
+    }
+    if (!mac) {
+        std::cerr << "[SECURITY ERROR] HMAC implementation unavailable." << std::endl;
+        return false;
+    }
+
+    EVP_MAC_CTX_free(ctx);
+    ctx = EVP_MAC_CTX_new(mac);
+    if (!ctx) {
+        std::cerr << "[SECURITY ERROR] HMAC context allocation failed." << std::endl;
+        return false;
+    }
+
+    char digest[] = "SHA256";
+    OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest, 0),
+        OSSL_PARAM_construct_end()
+    };
+
+    if (EVP_MAC_init(ctx, key, length, params) != 1) {
+        std::cerr << "[SECURITY ERROR] HMAC key setup failed." << std::endl;
+        EVP_MAC_CTX_free(ctx);
+        ctx = nullptr;
+        return false;
+    }
+
+    lastSequence = 0;
+    anyAccepted = false;
+    return true;
+}
+
+
+
+bool CommandAuthenticator::initializeFromEnvironment() {
+    const char* hex = std::getenv("OPENSPACE_UPLINK_KEY");
+    if (!hex || std::strlen(hex) < 2 || std::strlen(hex) % 2 != 0) {
+        std::cerr << "[SECURITY WARNING] OPENSPACE_UPLINK_KEY is not set (hex string expected). Uplink disabled.\n";
+        return false;
+    }
+
+    std::vector<uint8_t> key(std::strlen(hex) / 2);
+    for (std::size_t i = 0; i < key.size(); ++i) {
+        char byte[3] = { hex[2 * i], hex[2 * i + 1], '\0' };
+        char* end = nullptr;
+        key[i] = static_cast<uint8_t>(std::strtoul(byte, &end, 16));
+        if (*end != '\0') {
+            std::cerr << "[SECURITY WARNING] OPENSPACE_UPLINK_KEY is not valid hex. Uplink disabled.\n";
+            return false;
+        }
+    }
+
+    bool ok = initialize(key.data(), key.size());
+    OPENSSL_cleanse(key.data(), key.size());
+    return ok;
+}
+
+
+
+/**
+==========================================
+    HMAC Computation - Reuses the Keyed Context
+==========================================
+
+EVP_MAC_init() with a NULL key restarts the MAC with the key that is already loaded,
+so every packet costs one SHA-256 pass instead of a fresh context + key schedule.
+*/
+bool CommandAuthenticator::compute(const uint8_t* data, std::size_t length, uint8_t out[32]) {
+    if (!ctx) return false;
+
+    std::size_t outLength = 0;
+    if (EVP_MAC_init(ctx, NULL, 0, NULL) != 1 ||
+        EVP_MAC_update(ctx, data, length) != 1 ||
+        EVP_MAC_final(ctx, out, &outLength, 32) != 1 ||
+        outLength != 32) {
+        return false;
+    }
+    return true;
+}
+
+
+
+bool CommandAuthenticator::sign(const uint8_t* data, std::size_t length, uint8_t tag[32]) {
+    return compute(data, length, tag);
+}
+
+
+
+bool CommandAuthenticator::verify(const uint8_t* data, std::size_t length, const uint8_t tag[32], uint32_t sequence) {
+    uint8_t expected[32];
+    if (!compute(data, length, expected)) {
+        return false;
+    }
+
+    if (CRYPTO_memcmp(expected, tag, sizeof(expected)) != 0) {
+        return false;  // forged or corrupted
+    }
+
+    if (anyAccepted && sequence <= lastSequence) {
+        return false;  // replayed or out of order
+    }
+
+    if (!sequencePath.empty() && !storeSequence(sequence)) {
+        return false;  // an acceptance that is not on disk could be replayed after a restart
+    }
+
+    lastSequence = sequence;
+    anyAccepted = true;
+    return true;
+}
+
+
+
+/**
+==========================================
+    Persistent Replay Window
+==========================================
+
+The file holds the last accepted sequence as decimal text. Each update is written to a temporary file,
+fsync'd and renamed over the old one, so a crash leaves either the old or the new value - never a torn one.
+*/
+bool CommandAuthenticator::persistSequence(const std::string& path) {
+    sequencePath = path;
+
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return true;  // first boot: no packet accepted yet
+    }
+
+    unsigned long long stored = 0;
+    if (!(file >> stored) || stored > UINT32_MAX) {
+        std::cerr << "[SECURITY ERROR] Uplink sequence file " << path << " is corrupt.\n";
+        return false;
+    }
+
+    lastSequence = static_cast<uint32_t>(stored);
+    anyAccepted = true;
+    return true;
+}
+
+
+
+bool CommandAuthenticator::storeSequence(uint32_t sequence) const {
+    const std::string temporary = sequencePath + ".tmp";
+    const std::string text = std::to_string(sequence) + "\n";
+
+    int fd = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        std::cerr << "[SECURITY ERROR] Could not write uplink sequence file " << temporary << "\n";
+        return false;
+    }
+    bool ok = write(fd, text.data(), text.size()) == static_cast<ssize_t>(text.size()) && fsync(fd) == 0;
+    ok = close(fd) == 0 && ok;
+
+    if (!ok || std::rename(temporary.c_str(), sequencePath.c_str()) != 0) {
+        std::cerr << "[SECURITY ERROR] Could not update uplink sequence file " << sequencePath << "\n";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,67 @@
+#ifndef COMMAND_AUTH_H
+#define COMMAND_AUTH_H
+
+#include <openssl/evp.h>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+
+/**
+==========================================
+    Command Authenticator (HMAC-SHA256)
+==========================================
+
+- Keys a single EVP_MAC context once and re-initializes it per packet, so no per-command allocation or key schedule.
+- Rejects packets whose MAC does not match (constant-time compare) or whose sequence number is not newer than the last accepted one.
+- With persistSequence(), the last accepted sequence is written through to a file before a packet is accepted and reloaded at
+  start-up, so packets from before a restart cannot be replayed (fails closed if the file cannot be written).
+- Not thread-safe: owned by the uplink reader thread.
+*/
+class CommandAuthenticator {
+private:
+    EVP_MAC* mac = nullptr;
+    EVP_MAC_CTX* ctx = nullptr;
+    uint32_t lastSequence = 0;
+    bool anyAccepted = false;
+    std::string sequencePath;   // empty: replay window kept in memory only
+
+    bool compute(const uint8_t* data, std::size_t length, uint8_t out[32]);
+    bool storeSequence(uint32_t sequence) const;
+
+public:
+    CommandAuthenticator() = default;
+    ~CommandAuthenticator();
+    CommandAuthenticator(const CommandAuthenticator&) = delete;
+    CommandAuthenticator& operator=(const CommandAuthenticator&) = delete;
+
+    /**
+     * @brief Keys the HMAC context
+     * @param key Raw key bytes
+     * @param length Key length in bytes (32 recommended)
+     * @return false if OpenSSL could not set up the context
+     */
+    bool initialize(const uint8_t* key, std::size_t length);
+
+    /**
+     * @brief Loads a hex key from the OPENSPACE_UPLINK_KEY environment variable
+     */
+    bool initializeFromEnvironment();
+
+    /**
+     * @brief Keeps the replay window in `path` across restarts
+     * - Loads the last accepted sequence if the file exists; every later acceptance is written through first.
+     * @return false if the file exists but is unreadable or corrupt
+     */
+    bool persistSequence(const std::string& path);
+
+    bool isReady() const { return ctx != nullptr; }
+
+    // Computes the tag for an outgoing packet (ground tooling / loopback tests)
+    bool sign(const uint8_t* data, std::size_t length, uint8_t tag[32]);
+
+    // Verifies the tag and the replay window; updates the window on success
+    bool verify(const uint8_t* data, std::size_t length, const uint8_t tag[32], uint32_t sequence);
+};
+
+#endif
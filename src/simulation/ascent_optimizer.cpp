@@ -0,0 +1,1030 @@
+/*
+Offline ascent trajectory optimization by direct shooting.
+
+Research:
+
+1. Betts, "Survey of Numerical Methods for Trajectory Optimization",
+Journal of Guidance, Control, and Dynamics 21(2), 1998
+https://doi.org/10.2514/2.4231
+
+2. Nocedal, Wright, "Numerical Optimization", 2nd ed., Springer, 2006 - Ch. 6 (BFGS), Ch. 8 (finite-difference gradients),
+Ch. 17 (quadratic penalty continuation)
+*/
+
+#include "ascent_optimizer.h"
+#include "orbital_mechanics.h"
+#include <json/json.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+
+namespace {
+
+constexpr double STANDARD_GRAVITY = 9.80665;          // m/s², Isp -> exhaust velocity
+constexpr double EARTH_ROTATION = 7.2921159e-5;       // rad/s
+constexpr double AIR_DENSITY_SEA_LEVEL = 1.225;       // kg/m³
+constexpr double SCALE_HEIGHT = 8500.0;               // m, same atmosphere as FlightDynamics
+constexpr double DRAG_COEFFICIENT = 0.5;
+constexpr double DEG = M_PI / 180.0;
+constexpr double MAX_FLIGHT_TIME = 1500.0;            // s, safety stop for a trajectory that never reaches orbit
+constexpr double EVENT_TOLERANCE = 1e-9;              // s, insertion / depletion location inside a step
+constexpr int EVENT_ITERATIONS = 60;
+
+// Knot times: stage-1 pitch and throttle from liftoff, upper-stage pitch from its ignition (s)
+constexpr double PITCH1_TIMES[] = {25.0, 50.0, 75.0, 100.0, 125.0, 150.0};
+constexpr double THROTTLE_TIMES[] = {0.0, 30.0, 60.0, 90.0, 120.0};
+constexpr double PITCH2_OFFSETS[] = {0.0, 75.0, 150.0, 225.0, 300.0};
+
+// Parameter layout
+constexpr std::size_t PITCH1_FIRST = 0;
+constexpr std::size_t THROTTLE_FIRST = PITCH1_FIRST + AscentOptimizer::PITCH1_KNOTS;
+constexpr std::size_t MECO_INDEX = THROTTLE_FIRST + AscentOptimizer::THROTTLE_KNOTS;
+constexpr std::size_t COAST_INDEX = MECO_INDEX + 1;
+constexpr std::size_t PITCH2_FIRST = COAST_INDEX + 1;
+constexpr std::size_t PAYLOAD_INDEX = PITCH2_FIRST + AscentOptimizer::PITCH2_KNOTS;
+
+// Constraint and penalty scales: one unit per scale of violation
+constexpr double ALTITUDE_SCALE = 1000.0;             // m
+constexpr double ANGLE_SCALE = 0.2 * DEG;             // rad
+constexpr double PROPELLANT_SCALE = 1000.0;           // kg
+constexpr double PRESSURE_SCALE = 1000.0;             // Pa
+constexpr double ACCELERATION_SCALE = 0.1 * STANDARD_GRAVITY;
+
+bool readJson(const std::string& path, Json::Value& root) {
+    std::ifstream file(path);
+    if (!file.is_open() || !Json::parseFromStream(Json::CharReaderBuilder(), file, &root, nullptr)) {
+        std::cerr << "[ASCENT ERROR] Could not read " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+// Piecewise linear through (times[k], values[k]), held before the first and after the last knot
+template<std::size_t N>
+double interpolate(const double (&times)[N], const std::array<double, N>& values, double t) {
+    if (t <= times[0]) return values[0];
+    for (std::size_t k = 1; k < N; ++k) {
+        if (t < times[k]) {
+            double f = (t - times[k - 1]) / (times[k] - times[k - 1]);
+            return values[k - 1] + f * (values[k] - values[k - 1]);
+        }
+    }
+    return values[N - 1];
+}
+
+double interpolate(const std::vector<std::pair<double, double>>& knots, double t) {
+    if (knots.empty()) return 0.0;
+    if (t <= knots.front().first) return knots.front().second;
+    for (std::size_t k = 1; k < knots.size(); ++k) {
+        if (t < knots[k].first) {
+            double f = (t - knots[k - 1].first) / (knots[k].first - knots[k - 1].first);
+            return knots[k - 1].second + f * (knots[k].second - knots[k - 1].second);
+        }
+    }
+    return knots.back().second;
+}
+
+// Solves M z = rhs in place (Gaussian elimination, partial pivoting); M is n x n, row-major
+bool solveDense(std::vector<double>& M, std::vector<double>& rhs, std::size_t n) {
+    for (std::size_t col = 0; col < n; ++col) {
+        std::size_t pivot = col;
+        for (std::size_t row = col + 1; row < n; ++row) {
+            if (std::fabs(M[row * n + col]) > std::fabs(M[pivot * n + col])) pivot = row;
+        }
+        if (std::fabs(M[pivot * n + col]) < 1e-14) return false;
+        if (pivot != col) {
+            for (std::size_t k = 0; k < n; ++k) std::swap(M[col * n + k], M[pivot * n + k]);
+            std::swap(rhs[col], rhs[pivot]);
+        }
+        for (std::size_t row = col + 1; row < n; ++row) {
+            double factor = M[row * n + col] / M[col * n + col];
+            if (factor == 0.0) continue;
+            for (std::size_t k = col; k < n; ++k) M[row * n + k] -= factor * M[col * n + k];
+            rhs[row] -= factor * rhs[col];
+        }
+    }
+    for (std::size_t col = n; col-- > 0;) {
+        for (std::size_t k = col + 1; k < n; ++k) rhs[col] -= M[col * n + k] * rhs[k];
+        rhs[col] /= M[col * n + col];
+    }
+    return true;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+
+
+/**
+==========================================
+    Vehicle / Target From The Configuration Files
+==========================================
+*/
+bool AscentVehicle::loadRocketSpecs(const std::string& path) {
+    Json::Value specs;
+    if (!readJson(path, specs)) return false;
+
+    int engines = std::max(specs.get("engine_count", 1).asInt(), 1);
+    double diameter = specs.get("diameter_m", 0.0).asDouble();
+
+    name = specs.get("name", name).asString();
+    maxLiftoffMass = specs.get("mass_kg", maxLiftoffMass).asDouble();
+    stage1Thrust = specs.get("thrust_N", stage1Thrust / engines).asDouble() * engines;
+    stage1VacuumThrust = specs.get("thrust_vacuum_N", stage1VacuumThrust / engines).asDouble() * engines;
+    stage1Isp = specs.get("ISP_sea_level", stage1Isp).asDouble();
+    stage1VacuumIsp = specs.get("ISP_vacuum", stage1VacuumIsp).asDouble();
+    stage1Propellant = specs.get("fuel_kg", stage1Propellant).asDouble();
+    if (diameter > 0.0) {
+        dragArea = M_PI * 0.25 * diameter * diameter;
+    }
+    return true;
+}
+
+
+bool AscentVehicle::loadStages(const std::string& configPath) {
+    Json::Value config;
+    if (!readJson(configPath, config)) return false;
+    const Json::Value& ascent = config["ascent"];
+
+    stage1Dry = ascent.get("first_stage_dry_kg", stage1Dry).asDouble();
+    const Json::Value& upper = ascent["upper_stage"];
+    stage2Thrust = upper.get("thrust_N", stage2Thrust).asDouble();
+    stage2Isp = upper.get("isp_s", stage2Isp).asDouble();
+    stage2Propellant = upper.get("propellant_kg", stage2Propellant).asDouble();
+    stage2Dry = upper.get("dry_kg", stage2Dry).asDouble();
+
+    if (maxLiftoffMass <= stage1Dry + stage1Propellant + stage2Dry + stage2Propellant) {
+        std::cerr << "[ASCENT ERROR] Liftoff mass " << maxLiftoffMass << " kg leaves nothing above the two stages\n";
+        return false;
+    }
+    return true;
+}
+
+
+bool AscentTarget::loadConfig(const std::string& path) {
+    Json::Value config;
+    if (!readJson(path, config)) return false;
+    const Json::Value& ascent = config["ascent"];
+
+    latitude = config.get("latitude", latitude).asDouble();
+    altitude = ascent.get("target_altitude_km", altitude / 1000.0).asDouble() * 1000.0;
+    maxDynamicPressure = ascent.get("max_q_kpa", maxDynamicPressure / 1000.0).asDouble() * 1000.0;
+    maxAcceleration = ascent.get("max_acceleration_g", maxAcceleration).asDouble();
+    minThrottle = std::clamp(ascent.get("min_throttle", minThrottle).asDouble(), 0.1, 1.0);
+    return true;
+}
+
+
+
+/**
+==========================================
+    Ascent Profile File (ascent_profile.json)
+==========================================
+*/
+double AscentProfile::throttleAt(double time) const {
+    return interpolate(throttle, time);
+}
+
+
+double AscentProfile::pitchAt(double time) const {
+    return interpolate(pitch, time);
+}
+
+
+bool AscentProfile::save(const std::string& path) const {
+    Json::Value root;
+    root["rocket_name"] = rocketName;
+    root["liftoff_mass_kg"] = liftoffMass;
+    root["thrust_N"] = thrust;
+    root["burn_rate_kg_s"] = burnRate;
+    root["isp_s"] = isp;
+    root["propellant_kg"] = propellant;
+    root["first_stage_dry_kg"] = stage1Dry;
+    root["drag_area_m2"] = dragArea;
+    root["meco_s"] = meco;
+    root["stage2_ignition_s"] = stage2Ignition;
+    root["insertion_s"] = insertion;
+    root["payload_kg"] = payload;
+    root["target_altitude_m"] = targetAltitude;
+    root["max_q_pa"] = maxDynamicPressure;
+    root["max_acceleration_g"] = maxAcceleration;
+
+    auto knots = [](const std::vector<std::pair<double, double>>& list) {
+        Json::Value array(Json::arrayValue);
+        for (const auto& knot : list) {
+            Json::Value pair(Json::arrayValue);
+            pair.append(knot.first);
+            pair.append(knot.second);
+            array.append(pair);
+        }
+        return array;
+    };
+    root["pitch_program_deg"] = knots(pitch);
+    root["throttle_schedule"] = knots(throttle);
+
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "[ASCENT ERROR] Could not write " << path << "\n";
+        return false;
+    }
+    Json::StreamWriterBuilder writer;
+    writer["indentation"] = "    ";
+    file << Json::writeString(writer, root) << "\n";
+    return static_cast<bool>(file);
+}
+
+
+// A missing file is not an error (the flight loop then keeps its defaults); a malformed one is
+bool AscentProfile::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+
+    Json::Value root;
+    if (!Json::parseFromStream(Json::CharReaderBuilder(), file, &root, nullptr) || !root.isMember("thrust_N")) {
+        std::cerr << "[ASCENT ERROR] Malformed ascent profile " << path << "\n";
+        return false;
+    }
+
+    rocketName = root.get("rocket_name", "").asString();
+    liftoffMass = root.get("liftoff_mass_kg", 0.0).asDouble();
+    thrust = root.get("thrust_N", 0.0).asDouble();
+    burnRate = root.get("burn_rate_kg_s", 0.0).asDouble();
+    isp = root.get("isp_s", 0.0).asDouble();
+    propellant = root.get("propellant_kg", 0.0).asDouble();
+    stage1Dry = root.get("first_stage_dry_kg", liftoffMass - propellant).asDouble();   // older profiles: no separation
+    dragArea = root.get("drag_area_m2", 0.0).asDouble();
+    meco = root.get("meco_s", 0.0).asDouble();
+    stage2Ignition = root.get("stage2_ignition_s", 0.0).asDouble();
+    insertion = root.get("insertion_s", 0.0).asDouble();
+    payload = root.get("payload_kg", 0.0).asDouble();
+    targetAltitude = root.get("target_altitude_m", 0.0).asDouble();
+    maxDynamicPressure = root.get("max_q_pa", 0.0).asDouble();
+    maxAcceleration = root.get("max_acceleration_g", 0.0).asDouble();
+
+    auto knots = [](const Json::Value& array, std::vector<std::pair<double, double>>& list) {
+        list.clear();
+        for (const Json::Value& pair : array) {
+            if (pair.isArray() && pair.size() == 2) list.emplace_back(pair[0].asDouble(), pair[1].asDouble());
+        }
+    };
+    knots(root["pitch_program_deg"], pitch);
+    knots(root["throttle_schedule"], throttle);
+
+    if (liftoffMass <= 0.0 || thrust <= 0.0 || burnRate <= 0.0 || meco <= 0.0) {
+        std::cerr << "[ASCENT ERROR] Ascent profile " << path << " is missing the vehicle or MECO time\n";
+        return false;
+    }
+    return true;
+}
+
+
+
+// ==========================================
+// Constructor: Bounds And Derived Constants
+// ==========================================
+AscentOptimizer::AscentOptimizer(const AscentVehicle& v, const AscentTarget& t) : vehicle(v), target(t) {
+    stage1Flow = vehicle.stage1VacuumThrust / (vehicle.stage1VacuumIsp * STANDARD_GRAVITY);
+    stage2Flow = vehicle.stage2Thrust / (vehicle.stage2Isp * STANDARD_GRAVITY);
+    targetRadius = R_EARTH + target.altitude;
+    targetEnergy = -MU_EARTH / (2.0 * targetRadius);
+    atmosphereRotation = EARTH_ROTATION * std::cos(target.latitude * DEG);
+
+    for (std::size_t k = 0; k < PITCH1_KNOTS; ++k) {
+        lower[PITCH1_FIRST + k] = 0.0;
+        upper[PITCH1_FIRST + k] = 85.0 * DEG;
+    }
+    for (std::size_t k = 0; k < THROTTLE_KNOTS; ++k) {
+        lower[THROTTLE_FIRST + k] = target.minThrottle;
+        upper[THROTTLE_FIRST + k] = 1.0;
+    }
+    // MECO can be scheduled up to depletion at the deepest throttle; depletion cuts it short otherwise
+    lower[MECO_INDEX] = 0.5 * vehicle.stage1Propellant / stage1Flow;
+    upper[MECO_INDEX] = vehicle.stage1Propellant / (target.minThrottle * stage1Flow);
+    lower[COAST_INDEX] = 2.0;
+    upper[COAST_INDEX] = 12.0;
+    for (std::size_t k = 0; k < PITCH2_KNOTS; ++k) {
+        lower[PITCH2_FIRST + k] = 20.0 * DEG;
+        upper[PITCH2_FIRST + k] = 120.0 * DEG;
+    }
+    lower[PAYLOAD_INDEX] = 0.0;
+    upper[PAYLOAD_INDEX] = vehicle.maxLiftoffMass - vehicle.stage1Dry - vehicle.stage1Propellant
+                         - vehicle.stage2Dry - vehicle.stage2Propellant;
+}
+
+
+AscentOptimizer::Controls AscentOptimizer::decode(const Parameters& x) const {
+    auto value = [&](std::size_t i) { return lower[i] + std::clamp(x[i], 0.0, 1.0) * (upper[i] - lower[i]); };
+
+    Controls c;
+    for (std::size_t k = 0; k < PITCH1_KNOTS; ++k) c.pitch1[k] = value(PITCH1_FIRST + k);
+    for (std::size_t k = 0; k < THROTTLE_KNOTS; ++k) c.throttle[k] = value(THROTTLE_FIRST + k);
+    c.meco = value(MECO_INDEX);
+    c.coast = value(COAST_INDEX);
+    for (std::size_t k = 0; k < PITCH2_KNOTS; ++k) c.pitch2[k] = value(PITCH2_FIRST + k);
+    c.payload = value(PAYLOAD_INDEX);
+    return c;
+}
+
+
+// On the pad: co-rotating with the launch site, both stages fueled plus the payload, first stage burning
+AscentOptimizer::FlightState AscentOptimizer::launchState(const Controls& c) const {
+    FlightState s;
+    s.radius = R_EARTH;
+    s.tangential = atmosphereRotation * R_EARTH;
+    s.mass = vehicle.stage1Dry + vehicle.stage1Propellant + vehicle.stage2Dry + vehicle.stage2Propellant + c.payload;
+    s.propellant = vehicle.stage1Propellant;
+    s.phase = Phase::STAGE1;
+    return s;
+}
+
+
+
+/**
+==========================================
+    Equations Of Motion (Planar, Polar Coordinates)
+==========================================
+
+    ṙ = v_r,  θ̇ = v_t / r
+    v̇_r = v_t² / r - μ / r² + (T cos ψ + D_r) / m
+    v̇_t = -v_r v_t / r + (T sin ψ + D_t) / m
+    ṁ = -ṁ_engine
+
+ψ is the pitch angle from the local vertical. Drag acts against the velocity relative to an atmosphere
+co-rotating with the Earth.
+*/
+double AscentOptimizer::pitchAt(const Controls& c, const FlightState& s, double time) const {
+    if (s.phase == Phase::STAGE2) {
+        return interpolate(PITCH2_OFFSETS, c.pitch2, time - s.ignitionTime);
+    }
+    if (time <= VERTICAL_RISE) return 0.0;
+    if (time < PITCH1_TIMES[0]) {
+        return c.pitch1[0] * (time - VERTICAL_RISE) / (PITCH1_TIMES[0] - VERTICAL_RISE);
+    }
+    return interpolate(PITCH1_TIMES, c.pitch1, time);
+}
+
+
+// Scheduled throttle, capped so the sensed acceleration from thrust stays within the limit
+double AscentOptimizer::throttleAt(const Controls& c, const FlightState& s, double time) const {
+    double pressureRatio = std::exp(-(s.radius - R_EARTH) / SCALE_HEIGHT);
+    double limit = target.maxAcceleration * STANDARD_GRAVITY * s.mass;
+
+    if (s.phase == Phase::STAGE1) {
+        double isp = vehicle.stage1VacuumIsp - (vehicle.stage1VacuumIsp - vehicle.stage1Isp) * pressureRatio;
+        double full = stage1Flow * STANDARD_GRAVITY * isp;
+        return std::max(std::min(interpolate(THROTTLE_TIMES, c.throttle, time), limit / full), target.minThrottle);
+    }
+    if (s.phase == Phase::STAGE2) {
+        return std::max(std::min(1.0, limit / vehicle.stage2Thrust), target.minThrottle);
+    }
+    return 0.0;
+}
+
+
+void AscentOptimizer::derivatives(const Controls& c, const FlightState& s, double time,
+                                  double* out, double* q, double* accel) const {
+    double altitude = s.radius - R_EARTH;
+    double densityRatio = std::exp(-altitude / SCALE_HEIGHT);
+    double density = AIR_DENSITY_SEA_LEVEL * densityRatio;
+
+    double airRadial = s.radial;
+    double airTangential = s.tangential - atmosphereRotation * s.radius;
+    double airspeed = std::hypot(airRadial, airTangential);
+
+    double flow = 0.0, thrust = 0.0;
+    double throttle = throttleAt(c, s, time);
+    if (s.phase == Phase::STAGE1) {
+        double isp = vehicle.stage1VacuumIsp - (vehicle.stage1VacuumIsp - vehicle.stage1Isp) * densityRatio;
+        flow = throttle * stage1Flow;
+        thrust = flow * STANDARD_GRAVITY * isp;
+    } else if (s.phase == Phase::STAGE2) {
+        flow = throttle * stage2Flow;
+        thrust = flow * STANDARD_GRAVITY * vehicle.stage2Isp;
+    }
+
+    double pitch = pitchAt(c, s, time);
+    double perAirspeed = 0.5 * density * airspeed * DRAG_COEFFICIENT * vehicle.dragArea / s.mass;
+    double forceRadial = thrust * std::cos(pitch) / s.mass - perAirspeed * airRadial;
+    double forceTangential = thrust * std::sin(pitch) / s.mass - perAirspeed * airTangential;
+
+    out[0] = s.radial;
+    out[1] = s.tangential / s.radius;
+    out[2] = s.tangential * s.tangential / s.radius - MU_EARTH / (s.radius * s.radius) + forceRadial;
+    out[3] = -s.radial * s.tangential / s.radius + forceTangential;
+    out[4] = -flow;
+
+    if (q) *q = 0.5 * density * airspeed * airspeed;
+    if (accel) *accel = std::hypot(forceRadial, forceTangential);
+}
+
+
+// One RK4 step of length h inside the current phase. Max-Q / max acceleration are sampled at the step start.
+AscentOptimizer::FlightState AscentOptimizer::step(const Controls& c, const FlightState& s, double h) const {
+    auto offset = [&s](const double* k, double scale) {
+        FlightState t = s;
+        t.radius += scale * k[0];
+        t.downrange += scale * k[1];
+        t.radial += scale * k[2];
+        t.tangential += scale * k[3];
+        t.mass += scale * k[4];
+        return t;
+    };
+
+    double k1[5], k2[5], k3[5], k4[5], q, accel;
+    derivatives(c, s, s.time, k1, &q, &accel);
+    derivatives(c, offset(k1, 0.5 * h), s.time + 0.5 * h, k2, nullptr, nullptr);
+    derivatives(c, offset(k2, 0.5 * h), s.time + 0.5 * h, k3, nullptr, nullptr);
+    derivatives(c, offset(k3, h), s.time + h, k4, nullptr, nullptr);
+
+    FlightState n = s;
+    n.time = s.time + h;
+    n.radius += h / 6.0 * (k1[0] + 2.0 * k2[0] + 2.0 * k3[0] + k4[0]);
+    n.downrange += h / 6.0 * (k1[1] + 2.0 * k2[1] + 2.0 * k3[1] + k4[1]);
+    n.radial += h / 6.0 * (k1[2] + 2.0 * k2[2] + 2.0 * k3[2] + k4[2]);
+    n.tangential += h / 6.0 * (k1[3] + 2.0 * k2[3] + 2.0 * k3[3] + k4[3]);
+    n.mass += h / 6.0 * (k1[4] + 2.0 * k2[4] + 2.0 * k3[4] + k4[4]);
+    n.propellant -= s.mass - n.mass;
+    n.maxQ = std::max(s.maxQ, q);
+    n.maxAcceleration = std::max(s.maxAcceleration, accel);
+    return n;
+}
+
+
+
+/**
+==========================================
+    Shooting: One Trajectory From A Start State
+==========================================
+
+Steps end on the fixed grid (k x DT) or on a staging time, whichever comes first, so a run resumed from
+a grid checkpoint takes exactly the steps a run from liftoff would. Insertion (orbit energy reached) and
+propellant depletion are located inside their step by regula falsi on the step length.
+*/
+AscentOptimizer::Outcome AscentOptimizer::simulate(const Parameters& x, const FlightState& start,
+                                                   std::vector<FlightState>* record) const {
+    const Controls c = decode(x);
+    Outcome outcome;
+    FlightState s = start;
+    if (record) {
+        record->clear();
+        record->push_back(s);
+    }
+
+    auto energy = [](const FlightState& f) {
+        return 0.5 * (f.radial * f.radial + f.tangential * f.tangential) - MU_EARTH / f.radius;
+    };
+
+    // Shortest h in (0, full] with event(step(s, h)) >= 0, given event(s) < 0 <= event(step(s, full))
+    auto locate = [&](const auto& event, double full) {
+        double a = 0.0, b = full;
+        double fa = event(s), fb = event(step(c, s, full));
+        int side = 0;
+        for (int i = 0; i < EVENT_ITERATIONS && b - a > EVENT_TOLERANCE; ++i) {
+            double h = (fb != fa) ? std::clamp(b - fb * (b - a) / (fb - fa), a, b) : 0.5 * (a + b);
+            double fh = event(step(c, s, h));
+            outcome.steps++;
+            if (fh >= 0.0) {
+                b = h;
+                fb = fh;
+                if (side == 1) fa *= 0.5;   // Illinois: halve the stale end so the bracket closes from both sides
+                side = 1;
+            } else {
+                a = h;
+                fa = fh;
+                if (side == -1) fb *= 0.5;
+                side = -1;
+            }
+        }
+        return step(c, s, b);
+    };
+
+    while (s.phase != Phase::DONE) {
+        double gridEnd = static_cast<double>(s.step + 1) * DT;
+        double phaseEnd = std::numeric_limits<double>::infinity();
+        if (s.phase == Phase::STAGE1) phaseEnd = c.meco;
+        if (s.phase == Phase::COAST) phaseEnd = s.mecoTime + c.coast;
+
+        double end = std::min(gridEnd, phaseEnd);
+        FlightState n = s;
+        bool stopped = false;   // an in-step event ended the phase before `end`
+        if (end > s.time) {
+            n = step(c, s, end - s.time);
+            outcome.steps++;
+
+            if (s.phase == Phase::STAGE1 && n.propellant <= 0.0) {
+                n = locate([](const FlightState& f) { return -f.propellant; }, end - s.time);
+                n.propellant = 0.0;
+                stopped = true;
+            } else if (s.phase == Phase::STAGE2 && (energy(n) >= targetEnergy || n.propellant <= 0.0)) {
+                bool inserted = energy(n) >= targetEnergy;
+                n = inserted ? locate([&](const FlightState& f) { return energy(f) - targetEnergy; }, end - s.time)
+                             : locate([](const FlightState& f) { return -f.propellant; }, end - s.time);
+                if (!inserted) n.propellant = 0.0;
+                stopped = true;
+            }
+        }
+        if (!stopped && end == gridEnd) n.step = s.step + 1;
+
+        // Staging
+        if (s.phase == Phase::STAGE1 && (stopped || end == phaseEnd)) {
+            n.phase = Phase::COAST;
+            n.mecoTime = n.time;
+            n.mass -= vehicle.stage1Dry + n.propellant;
+            n.propellant = vehicle.stage2Propellant;
+        } else if (s.phase == Phase::COAST && end == phaseEnd) {
+            n.phase = Phase::STAGE2;
+            n.ignitionTime = n.time;
+        } else if (s.phase == Phase::STAGE2 && stopped) {
+            n.phase = Phase::DONE;
+        }
+
+        if (n.radius < R_EARTH && n.time > VERTICAL_RISE) {
+            outcome.crashed = true;
+            n.phase = Phase::DONE;
+        } else if (n.time > MAX_FLIGHT_TIME) {
+            n.phase = Phase::DONE;
+        }
+
+        s = n;
+        if (record && !stopped && end == gridEnd && s.step % CHECKPOINT_STEPS == 0) {
+            record->push_back(s);
+        }
+    }
+
+    outcome.final = s;
+    score(outcome, c);
+    return outcome;
+}
+
+
+// Payload in tonnes minus the path-limit penalties; the insertion conditions go to the constraints.
+// A stage that runs dry short of orbit has a negative propellant balance: the extra propellant the
+// rocket equation needs for the missing Δv, so the balance is continuous through zero.
+void AscentOptimizer::score(Outcome& outcome, const Controls& c) const {
+    const FlightState& f = outcome.final;
+    double speed = std::hypot(f.radial, f.tangential);
+    double energy = 0.5 * speed * speed - MU_EARTH / f.radius;
+    double shortfall = std::max(targetEnergy - energy, 0.0) / std::max(speed, 1.0);
+
+    outcome.payload = c.payload;
+    outcome.residual = (f.mass - vehicle.stage2Dry - c.payload)
+                     - f.mass * std::expm1(shortfall / (vehicle.stage2Isp * STANDARD_GRAVITY));
+    outcome.altitudeError = f.radius - targetRadius;
+    outcome.flightPathAngle = std::atan2(f.radial, f.tangential);
+    outcome.constraints = {outcome.altitudeError / ALTITUDE_SCALE,
+                           outcome.flightPathAngle / ANGLE_SCALE,
+                           outcome.residual / PROPELLANT_SCALE};
+
+    double qExcess = std::max(f.maxQ - target.maxDynamicPressure, 0.0) / PRESSURE_SCALE;
+    double accelExcess = std::max(f.maxAcceleration - target.maxAcceleration * STANDARD_GRAVITY, 0.0) / ACCELERATION_SCALE;
+    outcome.objective = outcome.payload / 1000.0 - PATH_PENALTY * (qExcess * qExcess + accelExcess * accelExcess);
+}
+
+
+
+/**
+==========================================
+    Prefix Reuse And Parallel Evaluation
+==========================================
+*/
+
+// Earliest time at which changing parameter i can alter the flight (the trajectory before it is unchanged)
+double AscentOptimizer::influenceStart(std::size_t i, const Parameters& x, const Parameters& perturbed,
+                                       const Outcome& base) const {
+    if (i < THROTTLE_FIRST) {
+        std::size_t k = i - PITCH1_FIRST;
+        return k == 0 ? VERTICAL_RISE : PITCH1_TIMES[k - 1];
+    }
+    if (i < MECO_INDEX) {
+        std::size_t k = i - THROTTLE_FIRST;
+        return k == 0 ? 0.0 : THROTTLE_TIMES[k - 1];
+    }
+    Controls a = decode(x), b = decode(perturbed);
+    if (i == MECO_INDEX) return std::min(a.meco, b.meco);
+    if (i == COAST_INDEX) return base.final.mecoTime + std::min(a.coast, b.coast);
+
+    if (i == PAYLOAD_INDEX) return -1.0;   // changes the liftoff mass: nothing to reuse
+
+    std::size_t k = i - PITCH2_FIRST;
+    return base.final.ignitionTime + (k == 0 ? 0.0 : PITCH2_OFFSETS[k - 1]);
+}
+
+
+// Workers pull jobs off a shared index (the calling thread works too); resumed jobs start from the
+// latest base checkpoint at or before their resumeBefore time
+void AscentOptimizer::runJobs(std::vector<Job>& jobs, bool resume) {
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        for (std::size_t i = next++; i < jobs.size(); i = next++) {
+            Job& job = jobs[i];
+            const FlightState launch = launchState(decode(job.x));
+            const FlightState* start = &launch;
+            if (resume && job.resumeBefore >= 0.0 && !checkpoints.empty()) {
+                auto after = std::upper_bound(checkpoints.begin(), checkpoints.end(), job.resumeBefore,
+                                              [](double t, const FlightState& s) { return t < s.time; });
+                if (after != checkpoints.begin()) start = &*(after - 1);
+            }
+            job.reusedSteps = static_cast<uint64_t>(start->step);
+            job.outcome = simulate(job.x, *start, nullptr);
+        }
+    };
+
+    unsigned count = std::min<unsigned>(threads, static_cast<unsigned>(jobs.size()));
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < count; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    for (const Job& job : jobs) {
+        simulations++;
+        stepsIntegrated += job.outcome.steps;
+        stepsFullEquivalent += job.outcome.steps + job.reusedSteps;
+        if (resume) {
+            perturbedIntegrated += job.outcome.steps;
+            perturbedFullEquivalent += job.outcome.steps + job.reusedSteps;
+        }
+    }
+}
+
+
+// Forward differences (backward at the upper bound) of the objective and every constraint from the same
+// perturbed runs; the base run refreshes the checkpoint cache
+AscentOptimizer::Outcome AscentOptimizer::gradient(const Parameters& x, Parameters& g,
+                                                   std::array<Parameters, CONSTRAINTS>& jacobian) {
+    const auto start = std::chrono::steady_clock::now();
+
+    Outcome base = simulate(x, launchState(decode(x)), &checkpoints);
+    simulations++;
+    stepsIntegrated += base.steps;
+    stepsFullEquivalent += base.steps;
+
+    std::vector<Job> jobs(PARAMETERS);
+    for (std::size_t i = 0; i < PARAMETERS; ++i) {
+        jobs[i].x = x;
+        jobs[i].x[i] += (x[i] + FD_STEP <= 1.0) ? FD_STEP : -FD_STEP;
+        jobs[i].resumeBefore = influenceStart(i, x, jobs[i].x, base);
+    }
+    runJobs(jobs, true);
+
+    for (std::size_t i = 0; i < PARAMETERS; ++i) {
+        double h = jobs[i].x[i] - x[i];
+        g[i] = (jobs[i].outcome.objective - base.objective) / h;
+        for (std::size_t j = 0; j < CONSTRAINTS; ++j) {
+            jacobian[j][i] = (jobs[i].outcome.constraints[j] - base.constraints[j]) / h;
+        }
+    }
+    gradientSeconds += secondsSince(start);
+    return base;
+}
+
+
+
+/**
+==========================================
+    Optimization Loop (SQP, l1 Merit)
+==========================================
+
+Each iteration solves the equality-constrained QP over the free parameters
+    [ B   Aᵀ ] [ d ]   [ ∇J ]
+    [ A   0  ] [ λ ] = [ -c ]
+(B approximates the Hessian of the Lagrangian of -J), drops parameters whose step would leave the box
+and re-solves, then takes the longest of LINE_SEARCH_POINTS halvings that decreases -J + μ|c|₁.
+*/
+AscentProfile AscentOptimizer::optimize(unsigned threadCount) {
+    const auto start = std::chrono::steady_clock::now();
+    threads = threadCount ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+    constexpr std::size_t N = PARAMETERS;
+
+    // Initial guess: gentle gravity turn, full throttle, burn to depletion, short coast, flat upper stage
+    Parameters x{};
+    auto set = [&](std::size_t i, double value) { x[i] = std::clamp((value - lower[i]) / (upper[i] - lower[i]), 0.0, 1.0); };
+    const double pitch1Guess[PITCH1_KNOTS] = {8.0, 20.0, 32.0, 44.0, 54.0, 62.0};
+    const double pitch2Guess[PITCH2_KNOTS] = {70.0, 78.0, 85.0, 90.0, 93.0};
+    for (std::size_t k = 0; k < PITCH1_KNOTS; ++k) set(PITCH1_FIRST + k, pitch1Guess[k] * DEG);
+    for (std::size_t k = 0; k < THROTTLE_KNOTS; ++k) set(THROTTLE_FIRST + k, 1.0);
+    set(MECO_INDEX, vehicle.stage1Propellant / stage1Flow);
+    set(COAST_INDEX, 3.0);
+    for (std::size_t k = 0; k < PITCH2_KNOTS; ++k) set(PITCH2_FIRST + k, pitch2Guess[k] * DEG);
+    set(PAYLOAD_INDEX, 10000.0);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "        Ascent Trajectory Optimizer      " << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "[ASCENT] " << vehicle.name << " to " << target.altitude / 1000.0 << " km circular | max-Q "
+              << target.maxDynamicPressure / 1000.0 << " kPa | max " << target.maxAcceleration << " g | "
+              << PARAMETERS << " parameters | " << threads << " thread(s)\n";
+
+    Parameters g;
+    std::array<Parameters, CONSTRAINTS> A;
+    Outcome current = gradient(x, g, A);
+
+    std::vector<double> B(N * N);
+    Constraints lambda{};
+    double mu = MIN_MERIT_WEIGHT;   // merit weight on |c|₁, 1.5x the largest multiplier of the current step
+    bool fresh = true;          // B is the scaled identity
+    double radius = INITIAL_RADIUS;   // cap on the largest parameter change of a step, follows the accepted steps
+    auto resetHessian = [&]() {
+        double largest = 1.0;
+        for (double gi : g) largest = std::max(largest, std::fabs(gi));
+        std::fill(B.begin(), B.end(), 0.0);
+        for (std::size_t i = 0; i < N; ++i) B[i * N + i] = largest / 0.05;   // first steps move a parameter ~5 %
+        fresh = true;
+    };
+    resetHessian();
+
+    auto infeasibility = [](const Outcome& o) {
+        double worst = 0.0;
+        for (double c : o.constraints) worst = std::max(worst, std::fabs(c));
+        return worst;
+    };
+    auto merit = [&mu](const Outcome& o) {
+        double value = -o.objective;
+        for (double c : o.constraints) value += mu * std::fabs(c);
+        return value;
+    };
+
+    iterations = 0;
+    termination = Termination::ITERATION_CAP;
+    while (iterations < MAX_ITERATIONS) {
+        // QP step; parameters pinned at a bound the step would cross are removed and the system re-solved
+        Parameters d{};
+        std::array<bool, N> fixed{};
+        bool solved = false;
+        for (std::size_t pass = 0; pass <= N && !solved; ++pass) {
+            std::vector<std::size_t> free;
+            for (std::size_t i = 0; i < N; ++i) {
+                if (!fixed[i]) free.push_back(i);
+            }
+            const std::size_t n = free.size(), size = n + CONSTRAINTS;
+            std::vector<double> M(size * size, 0.0), rhs(size, 0.0);
+            for (std::size_t r = 0; r < n; ++r) {
+                for (std::size_t k = 0; k < n; ++k) M[r * size + k] = B[free[r] * N + free[k]];
+                for (std::size_t j = 0; j < CONSTRAINTS; ++j) {
+                    M[r * size + n + j] = A[j][free[r]];
+                    M[(n + j) * size + r] = A[j][free[r]];
+                }
+                rhs[r] = g[free[r]];
+            }
+            for (std::size_t j = 0; j < CONSTRAINTS; ++j) {
+                M[(n + j) * size + n + j] = -1e-9;    // keeps the system solvable if the free columns lose rank
+                rhs[n + j] = -current.constraints[j];
+            }
+            if (!solveDense(M, rhs, size)) break;
+
+            d = Parameters{};
+            for (std::size_t r = 0; r < n; ++r) d[free[r]] = rhs[r];
+            for (std::size_t j = 0; j < CONSTRAINTS; ++j) lambda[j] = rhs[n + j];
+
+            solved = true;
+            for (std::size_t i : free) {
+                if ((x[i] <= 0.0 && d[i] < 0.0) || (x[i] >= 1.0 && d[i] > 0.0)) {
+                    fixed[i] = true;
+                    solved = false;
+                }
+            }
+        }
+        if (!solved) {
+            if (fresh) {
+                termination = Termination::NO_DESCENT;
+                break;
+            }
+            resetHessian();
+            continue;
+        }
+
+        double stepSize = 0.0, slope = 0.0, violation = 0.0;
+        for (std::size_t i = 0; i < N; ++i) {
+            stepSize = std::max(stepSize, std::fabs(d[i]));
+            slope -= g[i] * d[i];
+        }
+        mu = MIN_MERIT_WEIGHT;
+        for (std::size_t j = 0; j < CONSTRAINTS; ++j) {
+            mu = std::max(mu, 1.5 * std::fabs(lambda[j]));
+            violation += std::fabs(current.constraints[j]);
+        }
+        lastStep = stepSize;
+        if (stepSize < 1e-7 && infeasibility(current) < FEASIBILITY_TOLERANCE) {
+            termination = Termination::KKT_POINT;
+            break;
+        }
+
+        double cap = std::min(1.0, radius / stepSize);
+        for (double& di : d) di *= cap;
+        stepSize *= cap;
+        double directional = cap * (slope - mu * violation);   // merit derivative along d
+
+        // Parallel line search over step lengths 1, 1/2, ..., then the longest with enough merit decrease
+        std::vector<Job> candidates(LINE_SEARCH_POINTS);
+        for (int k = 0; k < LINE_SEARCH_POINTS; ++k) {
+            double alpha = std::ldexp(1.0, -k);
+            for (std::size_t i = 0; i < N; ++i) {
+                candidates[k].x[i] = std::clamp(x[i] + alpha * d[i], 0.0, 1.0);
+            }
+        }
+        runJobs(candidates, false);
+
+        const double base = merit(current);
+        auto acceptable = [&](const std::vector<Job>& jobs) -> const Job* {
+            for (int k = 0; k < LINE_SEARCH_POINTS; ++k) {
+                if (merit(jobs[k].outcome) <= base + 1e-4 * std::ldexp(1.0, -k) * std::min(directional, 0.0)) return &jobs[k];
+            }
+            return nullptr;
+        };
+        const Job* accepted = acceptable(candidates);
+
+        // Second-order correction: when the full step is rejected (constraint curvature - the Maratos effect),
+        // pull every candidate back onto the constraints with a minimum-norm step built from its own violation
+        std::vector<Job> corrected;
+        if (accepted != &candidates[0]) {
+            std::vector<double> AAt(CONSTRAINTS * CONSTRAINTS, 0.0);
+            for (std::size_t a = 0; a < CONSTRAINTS; ++a) {
+                for (std::size_t b = 0; b < CONSTRAINTS; ++b) {
+                    for (std::size_t i = 0; i < N; ++i) {
+                        if (!fixed[i]) AAt[a * CONSTRAINTS + b] += A[a][i] * A[b][i];
+                    }
+                }
+                AAt[a * CONSTRAINTS + a] += 1e-12;
+            }
+            corrected = candidates;
+            for (Job& job : corrected) {
+                std::vector<double> M = AAt, w(job.outcome.constraints.begin(), job.outcome.constraints.end());
+                if (!solveDense(M, w, CONSTRAINTS)) break;
+                for (std::size_t i = 0; i < N; ++i) {
+                    double correction = 0.0;
+                    for (std::size_t j = 0; j < CONSTRAINTS; ++j) correction -= A[j][i] * w[j];
+                    if (!fixed[i]) job.x[i] = std::clamp(job.x[i] + correction, 0.0, 1.0);
+                }
+            }
+            runJobs(corrected, false);
+            const Job* better = acceptable(corrected);
+            if (better && (!accepted || merit(better->outcome) < merit(accepted->outcome))) accepted = better;
+        }
+        if (!accepted || merit(accepted->outcome) >= base) {
+            // Nothing in the window: retry below it, and fall back to the identity once the window gets tiny
+            radius = std::ldexp(stepSize, -LINE_SEARCH_POINTS);
+            if (radius < MIN_RADIUS) {
+                if (fresh) {   // not even a tiny scaled-gradient step helps: converged
+                    termination = Termination::NO_DESCENT;
+                    break;
+                }
+                resetHessian();
+                radius = INITIAL_RADIUS;
+            }
+            continue;
+        }
+        // Next cap: the step just taken, doubled when the full step was good enough
+        double taken = 0.0;
+        for (std::size_t i = 0; i < PARAMETERS; ++i) taken = std::max(taken, std::abs(accepted->x[i] - x[i]));
+        const bool full = accepted == &candidates[0] || (!corrected.empty() && accepted == &corrected[0]);
+        radius = std::max(full ? 2.0 * taken : taken, MIN_RADIUS);
+
+        Parameters xNew = accepted->x, gNew;
+        std::array<Parameters, CONSTRAINTS> ANew;
+        Outcome next = gradient(xNew, gNew, ANew);
+        iterations++;
+
+        // Damped BFGS (Powell) on ∇L = -∇J + Aᵀλ
+        Parameters sv, yv, Bs{};
+        double sy = 0.0, sBs = 0.0;
+        for (std::size_t i = 0; i < N; ++i) {
+            sv[i] = xNew[i] - x[i];
+            yv[i] = g[i] - gNew[i];
+            for (std::size_t j = 0; j < CONSTRAINTS; ++j) yv[i] += (ANew[j][i] - A[j][i]) * lambda[j];
+        }
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t k = 0; k < N; ++k) Bs[i] += B[i * N + k] * sv[k];
+            sy += sv[i] * yv[i];
+            sBs += sv[i] * Bs[i];
+        }
+        if (sBs > 1e-16) {
+            if (sy < 0.2 * sBs) {
+                double theta = 0.8 * sBs / (sBs - sy);
+                for (std::size_t i = 0; i < N; ++i) yv[i] = theta * yv[i] + (1.0 - theta) * Bs[i];
+                sy = 0.2 * sBs;
+            }
+            for (std::size_t i = 0; i < N; ++i) {
+                for (std::size_t k = 0; k < N; ++k) {
+                    B[i * N + k] += yv[i] * yv[k] / sy - Bs[i] * Bs[k] / sBs;
+                }
+            }
+            fresh = false;
+        }
+
+        x = xNew;
+        g = gNew;
+        A = ANew;
+        current = next;
+
+        if (iterations % 20 == 0) {
+            std::cout << std::fixed << std::setprecision(1)
+                      << "[ASCENT] Iteration " << std::setw(3) << iterations << ": payload " << current.payload << " kg"
+                      << " | insertion error " << current.altitudeError << " m, " << std::setprecision(3)
+                      << current.flightPathAngle / DEG << " deg | propellant balance " << std::setprecision(1)
+                      << current.residual << " kg\n" << std::defaultfloat;
+        }
+    }
+
+    best = simulate(x, launchState(decode(x)), &checkpoints);
+    seconds = secondsSince(start);
+    if (termination == Termination::ITERATION_CAP) {
+        std::cerr << "[ASCENT WARNING] Stopped at the " << MAX_ITERATIONS << "-iteration cap before a KKT point (last step "
+                  << lastStep << ", constraint violation " << infeasibility(best) << ") - the profile may not be optimal\n";
+    }
+    if (infeasibility(best) > FEASIBILITY_TOLERANCE) {
+        std::cerr << "[ASCENT WARNING] Best profile still misses the target orbit - check the vehicle and limits\n";
+    }
+    return profileFor(x, best);
+}
+
+
+
+// The flown throttle (schedule under the g-limit) is sampled from the final run's checkpoints
+AscentProfile AscentOptimizer::profileFor(const Parameters& x, const Outcome& outcome) const {
+    const Controls c = decode(x);
+    const FlightState& f = outcome.final;
+
+    AscentProfile profile;
+    profile.rocketName = vehicle.name;
+    profile.liftoffMass = launchState(c).mass;
+    profile.thrust = vehicle.stage1Thrust;
+    profile.burnRate = vehicle.stage1Thrust / (vehicle.stage1Isp * STANDARD_GRAVITY);
+    profile.isp = vehicle.stage1Isp;
+    profile.propellant = vehicle.stage1Propellant;
+    profile.stage1Dry = vehicle.stage1Dry;
+    profile.dragArea = vehicle.dragArea;
+    profile.meco = f.mecoTime;
+    profile.stage2Ignition = f.ignitionTime;
+    profile.insertion = f.time;
+    profile.payload = outcome.payload;
+    profile.targetAltitude = target.altitude;
+    profile.maxDynamicPressure = f.maxQ;
+    profile.maxAcceleration = f.maxAcceleration / STANDARD_GRAVITY;
+
+    FlightState stage1 = launchState(c);
+    profile.pitch.emplace_back(0.0, 0.0);
+    profile.pitch.emplace_back(VERTICAL_RISE, 0.0);
+    for (std::size_t k = 0; k < PITCH1_KNOTS && PITCH1_TIMES[k] < f.mecoTime; ++k) {
+        profile.pitch.emplace_back(PITCH1_TIMES[k], c.pitch1[k] / DEG);
+    }
+    profile.pitch.emplace_back(f.mecoTime, pitchAt(c, stage1, f.mecoTime) / DEG);
+    FlightState stage2 = f;
+    stage2.phase = Phase::STAGE2;
+    for (std::size_t k = 0; k < PITCH2_KNOTS && f.ignitionTime + PITCH2_OFFSETS[k] < f.time; ++k) {
+        profile.pitch.emplace_back(f.ignitionTime + PITCH2_OFFSETS[k], c.pitch2[k] / DEG);
+    }
+    profile.pitch.emplace_back(f.time, pitchAt(c, stage2, f.time) / DEG);
+
+    // Every 5th checkpoint (10 s) during the first-stage burn, then the throttle at MECO
+    for (std::size_t i = 0; i < checkpoints.size(); i += 5) {
+        const FlightState& s = checkpoints[i];
+        if (s.phase != Phase::STAGE1) break;
+        profile.throttle.emplace_back(s.time, throttleAt(c, s, s.time));
+    }
+    profile.throttle.emplace_back(f.mecoTime, profile.throttle.empty() ? 1.0 : profile.throttle.back().second);
+    return profile;
+}
+
+
+
+// Reuse is quoted for the finite-difference runs (the only ones that resume; line-search candidates and
+// base runs change every parameter and start at liftoff) and for all runs together
+void AscentOptimizer::report() const {
+    auto saved = [](uint64_t integrated, uint64_t full) {
+        return full ? 100.0 * (1.0 - static_cast<double>(integrated) / full) : 0.0;
+    };
+    const char* stopped = termination == Termination::KKT_POINT  ? "converged: KKT point"
+                        : termination == Termination::NO_DESCENT ? "stopped: no merit decrease along the scaled gradient"
+                                                                 : "stopped at the iteration cap, not a KKT point";
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "[ASCENT] Payload to " << target.altitude / 1000.0 << " km: " << best.payload << " kg"
+              << " | MECO T+" << best.final.mecoTime << " s | Stage 2 ignition T+" << best.final.ignitionTime
+              << " s | Insertion T+" << best.final.time << " s\n"
+              << "[ASCENT] Insertion altitude error " << best.altitudeError << " m | flight path "
+              << std::setprecision(3) << best.flightPathAngle / DEG << " deg | upper-stage propellant left "
+              << std::setprecision(1) << best.residual << " kg\n"
+              << "[ASCENT] Max-Q " << best.final.maxQ / 1000.0 << " kPa (limit " << target.maxDynamicPressure / 1000.0
+              << ") | Max acceleration " << std::setprecision(2) << best.final.maxAcceleration / STANDARD_GRAVITY
+              << " g (limit " << target.maxAcceleration << ")\n"
+              << "[ASCENT] " << iterations << " iterations (" << stopped << ") | " << simulations << " trajectories in "
+              << std::setprecision(2) << seconds << " s (" << gradientSeconds << " s in gradients) on "
+              << threads << " thread(s)\n"
+              << "[ASCENT] Prefix reuse: finite-difference runs integrated " << perturbedIntegrated << " of "
+              << perturbedFullEquivalent << " RK4 steps (" << std::setprecision(1)
+              << saved(perturbedIntegrated, perturbedFullEquivalent) << " % resumed from checkpoints) | all runs "
+              << saved(stepsIntegrated, stepsFullEquivalent) << " %\n" << std::defaultfloat;
+}
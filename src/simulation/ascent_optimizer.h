@@ -0,0 +1,225 @@
+#ifndef ASCENT_OPTIMIZER_H
+#define ASCENT_OPTIMIZER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+
+/**
+ * @brief Two-stage vehicle for the ascent optimizer
+ * - First stage from scripts/api_data/rocket_specs.json (total thrust = thrust_N x engine_count,
+ *   sea-level / vacuum Isp, propellant = fuel_kg). The specs have no upper-stage or dry-mass data, so
+ *   those come from the "ascent" block of program_configuration.json (defaults: Falcon 9).
+ * - mass_kg caps the gross liftoff mass: whatever it leaves above both stages is the largest payload
+ *   the optimizer may try. The payload itself is one of the optimized parameters.
+ */
+struct AscentVehicle {
+    std::string name = "Falcon 9";
+    double maxLiftoffMass = 549054.0;       // kg, full stack at the largest payload
+    double stage1Thrust = 7605000.0;        // N, sea level, all engines
+    double stage1VacuumThrust = 8226000.0;  // N, vacuum, all engines
+    double stage1Isp = 288.0;               // s, sea level
+    double stage1VacuumIsp = 312.0;         // s
+    double stage1Propellant = 385000.0;     // kg
+    double stage1Dry = 25600.0;             // kg
+    double stage2Thrust = 981000.0;         // N, vacuum
+    double stage2Isp = 348.0;               // s
+    double stage2Propellant = 92670.0;      // kg
+    double stage2Dry = 4000.0;              // kg
+    double dragArea = 10.75;                // m² (from diameter_m)
+
+    bool loadRocketSpecs(const std::string& path);
+    // Upper stage and first-stage dry mass from the "ascent" block of program_configuration.json
+    bool loadStages(const std::string& configPath);
+};
+
+
+// Target orbit and path limits ("ascent" block of program_configuration.json)
+struct AscentTarget {
+    double altitude = 200000.0;             // m, circular insertion
+    double maxDynamicPressure = 35000.0;    // Pa
+    double maxAcceleration = 4.0;           // g, sensed (thrust + drag)
+    double minThrottle = 0.57;              // first-stage deep throttle limit
+    double latitude = 28.5721;              // deg, launch site (Earth rotation assist for a due-east launch)
+
+    bool loadConfig(const std::string& path);
+};
+
+
+
+/**
+ * @brief Optimized ascent written by --optimize-ascent and loaded by the Scheduler
+ * - Pitch program in degrees from the local vertical, throttle as a fraction of rated stage-1 thrust;
+ *   both piecewise linear between (time, value) knots and held past the last knot.
+ */
+struct AscentProfile {
+    std::string rocketName;
+    double liftoffMass = 0.0;               // kg
+    double thrust = 0.0;                    // N, stage 1 sea level at full throttle
+    double burnRate = 0.0;                  // kg/s at full throttle
+    double isp = 0.0;                       // s, stage 1 sea level
+    double propellant = 0.0;                // kg, stage 1
+    double stage1Dry = 0.0;                 // kg, the booster that flies back after MECO
+    double dragArea = 0.0;                  // m²
+    double meco = 0.0;                      // s, main engine cutoff
+    double stage2Ignition = 0.0;            // s
+    double insertion = 0.0;                 // s, upper-stage cutoff
+    double payload = 0.0;                   // kg above upper-stage dry mass at insertion
+    double targetAltitude = 0.0;            // m
+    double maxDynamicPressure = 0.0;        // Pa, flown
+    double maxAcceleration = 0.0;           // g, flown
+    std::vector<std::pair<double, double>> pitch;      // (s, deg from vertical)
+    std::vector<std::pair<double, double>> throttle;   // (s, fraction), stage 1
+
+    double throttleAt(double time) const;
+    double pitchAt(double time) const;
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+};
+
+
+
+/**
+==========================================
+    Ascent Trajectory Optimizer (Direct Shooting)
+==========================================
+
+- Planar point mass over a round, rotating Earth (exponential atmosphere, vacuum / sea-level Isp blend),
+  integrated by RK4 on a fixed time grid that is split exactly at staging; insertion and propellant
+  depletion are located inside their step, so the objective is smooth in the parameters.
+- Parameters (normalized to [0, 1] between their bounds): stage-1 pitch knots, stage-1 throttle knots,
+  MECO time, staging coast, upper-stage pitch knots (timed from ignition) and the payload mass. The
+  throttle is also capped by the acceleration limit, so the g-limit is flown rather than only penalized.
+- Objective: payload, minus quadratic penalties on max-Q and acceleration excess. The upper stage cuts
+  off on reaching the target orbit energy; insertion altitude, flight-path angle and the upper-stage
+  propellant balance (left over, or short of orbit) are equality constraints.
+- SQP: damped BFGS on the Lagrangian, equality-constrained QP steps over the free parameters (bounds
+  by projection), l1 merit line search with a second-order correction. Objective and constraint gradients come from one set of
+  forward differences; the perturbed trajectories run in parallel, and each resumes from the base
+  trajectory's checkpoint just before the earliest time its parameter can act - a knot only changes
+  the flight after the previous knot. Only the upper-stage knots, MECO and the coast skip much of the
+  flight; early knots, the first throttle knot and the payload (liftoff mass) rerun nearly all of it.
+- The line search also evaluates all of its candidate steps in parallel (every parameter moves, so
+  candidates start at liftoff).
+*/
+class AscentOptimizer {
+public:
+    static constexpr double DT = 0.2;                    // s, integration grid
+    static constexpr int CHECKPOINT_STEPS = 10;          // grid steps between cached states
+    static constexpr double VERTICAL_RISE = 10.0;        // s before the pitch program starts
+    static constexpr std::size_t PITCH1_KNOTS = 6;
+    static constexpr std::size_t THROTTLE_KNOTS = 5;
+    static constexpr std::size_t PITCH2_KNOTS = 5;
+    static constexpr std::size_t PARAMETERS = PITCH1_KNOTS + THROTTLE_KNOTS + 2 + PITCH2_KNOTS + 1;
+    static constexpr std::size_t CONSTRAINTS = 3;        // insertion altitude, flight-path angle, propellant balance
+    static constexpr double FD_STEP = 1e-5;              // normalized units
+    static constexpr int LINE_SEARCH_POINTS = 8;         // step lengths 1, 1/2, ... 1/128, evaluated together
+    static constexpr int MAX_ITERATIONS = 200;
+    static constexpr double INITIAL_RADIUS = 0.05;       // largest parameter change of a step, normalized units
+    static constexpr double MIN_RADIUS = 1e-9;
+    static constexpr double MIN_MERIT_WEIGHT = 0.1;
+    static constexpr double PATH_PENALTY = 10.0;         // weight on squared max-Q / acceleration excess
+    static constexpr double FEASIBILITY_TOLERANCE = 1e-3;   // scaled constraints (1 m, 0.0002 deg, 1 kg)
+
+    using Parameters = std::array<double, PARAMETERS>;
+    using Constraints = std::array<double, CONSTRAINTS>;
+
+    AscentOptimizer(const AscentVehicle& vehicle, const AscentTarget& target);
+
+    /**
+     * @brief Runs the optimization and returns the best profile found
+     * @param threads Worker count for gradients and line searches (0 = hardware concurrency)
+     */
+    AscentProfile optimize(unsigned threads);
+
+    // Prints iterations, why the loop stopped, constraint residuals and how much integration the prefix cache saved
+    void report() const;
+
+private:
+    enum class Phase : uint8_t { STAGE1, COAST, STAGE2, DONE };
+    enum class Termination : uint8_t { KKT_POINT, NO_DESCENT, ITERATION_CAP };
+
+    // Physical controls decoded from one parameter vector
+    struct Controls {
+        std::array<double, PITCH1_KNOTS> pitch1;        // rad
+        std::array<double, THROTTLE_KNOTS> throttle;
+        double meco;                                    // s (propellant depletion may come first)
+        double coast;                                   // s
+        std::array<double, PITCH2_KNOTS> pitch2;        // rad
+        double payload;                                 // kg
+    };
+
+    // Integration state; also what a checkpoint holds
+    struct FlightState {
+        double time = 0.0;
+        double radius = 0.0, downrange = 0.0;           // m, rad
+        double radial = 0.0, tangential = 0.0;          // inertial velocity components (m/s)
+        double mass = 0.0;                              // kg
+        double propellant = 0.0;                        // kg, current stage
+        double mecoTime = 0.0, ignitionTime = 0.0;      // s, once reached
+        double maxQ = 0.0, maxAcceleration = 0.0;       // Pa, m/s²
+        int64_t step = 0;                               // grid points passed
+        Phase phase = Phase::STAGE1;
+    };
+
+    struct Outcome {
+        double objective = 0.0;                         // payload (t) - path penalties
+        Constraints constraints{};                      // scaled; all zero at a feasible insertion
+        double payload = 0.0;                           // kg
+        double residual = 0.0;                          // kg, upper-stage propellant left (< 0: equivalent shortfall)
+        double altitudeError = 0.0;                     // m
+        double flightPathAngle = 0.0;                   // rad
+        FlightState final;
+        uint64_t steps = 0;                             // RK4 steps integrated
+        bool crashed = false;
+    };
+
+    // One simulation for the worker pool
+    struct Job {
+        Parameters x{};
+        double resumeBefore = 0.0;                      // latest time the cached prefix may reach (< 0: from liftoff)
+        Outcome outcome;
+        uint64_t reusedSteps = 0;                       // grid steps taken from the cache instead of integrated
+    };
+
+    AscentVehicle vehicle;
+    AscentTarget target;
+    Parameters lower{}, upper{};                        // physical bounds per parameter
+    double stage1Flow = 0.0, stage2Flow = 0.0;          // kg/s at full throttle
+    double targetRadius = 0.0, targetEnergy = 0.0;
+    double atmosphereRotation = 0.0;                    // rad/s about the launch-site axis, times cos(latitude)
+    unsigned threads = 1;
+
+    // Base trajectory checkpoints (every CHECKPOINT_STEPS grid steps) for the current iterate
+    std::vector<FlightState> checkpoints;
+
+    // Bookkeeping for report()
+    int iterations = 0;
+    Termination termination = Termination::ITERATION_CAP;
+    double lastStep = 0.0;                              // largest parameter change of the last QP step
+    uint64_t simulations = 0, stepsIntegrated = 0, stepsFullEquivalent = 0;
+    uint64_t perturbedIntegrated = 0, perturbedFullEquivalent = 0;   // finite-difference runs (the only ones resumed)
+    double seconds = 0.0, gradientSeconds = 0.0;
+    Outcome best;
+
+    Controls decode(const Parameters& x) const;
+    FlightState launchState(const Controls& c) const;
+    Outcome simulate(const Parameters& x, const FlightState& start, std::vector<FlightState>* record) const;
+    FlightState step(const Controls& c, const FlightState& s, double h) const;
+    void derivatives(const Controls& c, const FlightState& s, double time, double* out, double* q, double* accel) const;
+    double pitchAt(const Controls& c, const FlightState& s, double time) const;
+    double throttleAt(const Controls& c, const FlightState& s, double time) const;
+    double influenceStart(std::size_t parameter, const Parameters& x, const Parameters& perturbed, const Outcome& base) const;
+    void score(Outcome& outcome, const Controls& c) const;
+
+    void runJobs(std::vector<Job>& jobs, bool resume);
+    Outcome gradient(const Parameters& x, Parameters& g, std::array<Parameters, CONSTRAINTS>& jacobian);
+    AscentProfile profileFor(const Parameters& x, const Outcome& outcome) const;
+};
+
+#endif
@@ -0,0 +1,321 @@
+#include "batch_runner.h"
+#include "cdh.h"
+#include "flight_dynamics.h"
+#include "wind_model.h"
+#include "arena.h"
+#include "alloc_stats.h"
+#include <json/json.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <thread>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+namespace {
+
+constexpr double STANDARD_GRAVITY = 9.80665;   // m/s², Isp -> exhaust velocity
+
+bool readJson(const std::string& path, Json::Value& root) {
+    std::ifstream file(path);
+    if (!file.is_open() || !Json::parseFromStream(Json::CharReaderBuilder(), file, &root, nullptr)) {
+        std::cerr << "[BATCH ERROR] Could not read " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+
+// Binds the calling thread to one CPU (no-op where affinity is not supported)
+void pinToCpu(unsigned cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % std::max(1u, std::thread::hardware_concurrency()), &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        std::cerr << "[BATCH WARNING] Could not pin worker to CPU " << cpu << "\n";
+    }
+#else
+    (void)cpu;
+#endif
+}
+
+}  // namespace
+
+
+
+/**
+==========================================
+    Mission Configuration From The API Data
+==========================================
+*/
+bool MissionConfig::loadRocketSpecs(const std::string& path) {
+    Json::Value specs;
+    if (!readJson(path, specs)) return false;
+
+    int engines = std::max(specs.get("engine_count", 1).asInt(), 1);
+    double diameter = specs.get("diameter_m", 0.0).asDouble();
+
+    mass = specs.get("mass_kg", mass).asDouble();
+    thrust = specs.get("thrust_N", thrust / engines).asDouble() * engines;
+    isp = specs.get("ISP_sea_level", isp).asDouble();
+    fuel = specs.get("fuel_kg", fuel).asDouble();
+    burnRate = thrust / (isp * STANDARD_GRAVITY);      // mass flow that produces the rated thrust
+    if (diameter > 0.0) {
+        dragArea = M_PI * 0.25 * diameter * diameter;
+    }
+    return true;
+}
+
+
+bool MissionConfig::loadWeather(const std::string& path) {
+    Json::Value weather;
+    if (!readJson(path, weather)) return false;
+
+    windSpeed = std::max(weather.get("wind_speed_mps", 0.0).asDouble(), 0.0);
+    return true;
+}
+
+
+// Somigliana's closed form: γ(φ) = γe (1 + k sin²φ) / sqrt(1 - e² sin²φ)
+void MissionConfig::setLaunchLatitude(double degrees) {
+    constexpr double EQUATORIAL_GRAVITY = 9.7803253359;     // m/s²
+    constexpr double SOMIGLIANA_K = 1.931852652458e-3;
+    constexpr double ECCENTRICITY_SQUARED = 6.69437999013e-3;
+
+    double s = std::sin(degrees * M_PI / 180.0);
+    gravity = EQUATORIAL_GRAVITY * (1.0 + SOMIGLIANA_K * s * s) / std::sqrt(1.0 - ECCENTRICITY_SQUARED * s * s);
+}
+
+
+
+// Channels are sized here without being value-initialized (resize through UninitializedAllocator writes
+// nothing): each worker initializes its own rows, so their pages are first touched - and on NUMA systems
+// placed - by the thread that writes them.
+void BatchResults::allocate(std::size_t runCount, std::size_t samplesPerRun) {
+    const std::size_t total = runCount * samplesPerRun;
+
+    runs = runCount;
+    capacity = samplesPerRun;
+    time.resize(total);
+    altitude.resize(total);
+    velocity.resize(total);
+    fuel.resize(total);
+    dragForce.resize(total);
+    phase.resize(total);
+    summary.assign(runCount, RunSummary{});
+}
+
+
+
+/**
+==========================================
+    One Mission (optionally writes row `run` of every channel)
+==========================================
+*/
+RunSummary BatchRunner::simulate(const MissionConfig& config, BumpArena& arena, BatchResults* results, std::size_t run) {
+    const AllocStats::Snapshot before = AllocStats::thread();
+
+    FlightDynamics dynamics(config.mass, config.thrust, config.burnRate, config.isp, config.dragArea);
+    FlightDynamics::State initial = dynamics.getState();
+    initial.fuel = config.fuel;
+    initial.gravity = config.gravity;
+    dynamics.setState(initial);
+    dynamics.setConsoleWarnings(false);
+    dynamics.addVehicleEvents();
+    CDH::registerPhaseEvents(dynamics);
+
+    WindModel wind(&arena);
+    if (config.windSpeed > 0.0) {
+        wind.setSurfaceSpeed(config.windSpeed);
+        if (config.turbulenceSeed != 0) {
+            wind.generateTurbulence(config.turbulenceSeed);
+        }
+        dynamics.setWindModel(&wind);
+    }
+
+    const std::size_t capacity = results ? results->capacity : std::numeric_limits<std::size_t>::max();
+    const std::size_t offset = results ? run * capacity : 0;
+    const std::size_t steps = (config.dt > 0.0)
+        ? std::min(capacity, static_cast<std::size_t>(config.duration / config.dt + 0.5))
+        : 0;  // invalid step: the row is just padded
+    RunSummary summary;
+    MissionPhase phase = MissionPhase::PRE_LAUNCH;
+    double time = 0.0;
+    double previousVelocity = 0.0;
+
+    TelemetryData data{};
+
+    std::size_t i = 0;
+    for (; i < steps && phase != MissionPhase::POST_FLIGHT; ++i) {
+        // Like the live loop, a flight event ends the step exactly on its threshold and the phase rules
+        // see that state; the rest of the sample interval is flown before the sample is stored
+        double remaining = config.dt;
+        while (remaining > 1e-12 && phase != MissionPhase::POST_FLIGHT) {
+            dynamics.setActivePhase(static_cast<int>(phase));
+            double step = dynamics.advance(remaining, nullptr);
+            remaining -= step;
+            time += step;
+
+            data.altitude = dynamics.getAltitude();
+            data.velocity = dynamics.getVelocity();
+            data.fuel = dynamics.getFuel();
+            data.thrust = dynamics.getThrust();
+            data.dragForce = dynamics.getDragForce();
+            phase = CDH::evaluatePhase(phase, data);
+
+            // Burnout, max-Q and apogee land on their event stops, so the peaks and times are exact
+            summary.maxAltitude = std::max(summary.maxAltitude, data.altitude);
+            summary.maxVelocity = std::max(summary.maxVelocity, std::abs(data.velocity));
+            summary.maxDragForce = std::max(summary.maxDragForce, data.dragForce);
+            if (summary.burnoutTime < 0.0 && data.fuel <= FlightDynamics::FUEL_CUTOFF) summary.burnoutTime = time;
+            if (summary.apogeeTime < 0.0 && previousVelocity > 0.0 && data.velocity <= 0.0) summary.apogeeTime = time;
+            previousVelocity = data.velocity;
+        }
+
+        if (results) {
+            results->time[offset + i] = time;
+            results->altitude[offset + i] = data.altitude;
+            results->velocity[offset + i] = data.velocity;
+            results->fuel[offset + i] = data.fuel;
+            results->dragForce[offset + i] = data.dragForce;
+            results->phase[offset + i] = static_cast<int32_t>(phase);
+        }
+    }
+
+    // Pad the rest of the row
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (std::size_t k = i; results && k < capacity; ++k) {
+        results->time[offset + k] = nan;
+        results->altitude[offset + k] = nan;
+        results->velocity[offset + k] = nan;
+        results->fuel[offset + k] = nan;
+        results->dragForce[offset + k] = nan;
+        results->phase[offset + k] = -1;
+    }
+
+    summary.finalPhase = phase;
+    summary.samples = static_cast<uint32_t>(i);
+    summary.arenaBytes = static_cast<uint32_t>(arena.used());
+    summary.heapAllocations = static_cast<uint32_t>(AllocStats::thread().allocations - before.allocations);
+    if (results) results->summary[run] = summary;
+    return summary;
+}
+
+
+
+/**
+==========================================
+    Run The Batch In Parallel
+==========================================
+*/
+BatchResults BatchRunner::run(const std::vector<MissionConfig>& configs, unsigned threads, bool pinThreads) {
+    BatchResults results;
+    const auto start = std::chrono::steady_clock::now();
+
+    std::size_t capacity = 0;
+    for (const MissionConfig& config : configs) {
+        if (config.dt > 0.0) {
+            capacity = std::max(capacity, static_cast<std::size_t>(config.duration / config.dt + 0.5));
+        }
+    }
+    results.allocate(configs.size(), capacity);
+    if (configs.empty()) return results;
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min<unsigned>(threads, static_cast<unsigned>(configs.size()));
+    results.threads = threads;
+
+    std::atomic<std::size_t> next{0};
+    std::atomic<uint64_t> overflows{0};
+    auto worker = [&](unsigned index) {
+        if (pinThreads) pinToCpu(index);
+        BumpArena arena(WORKER_ARENA_BYTES);   // built after pinning: NUMA-local pages
+
+        for (std::size_t i = next++; i < configs.size(); i = next++) {
+            simulate(configs[i], arena, &results, i);
+            arena.reset();
+        }
+        overflows += arena.overflowCount();
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) {
+        pool.emplace_back(worker, t);
+    }
+    worker(0);  // the calling thread works too
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    results.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    results.peakRssKb = AllocStats::peakRssKb();
+    results.arenaOverflows = overflows;
+    return results;
+}
+
+
+
+/**
+==========================================
+    Scaling Benchmark (--bench-batch)
+==========================================
+
+Worker arenas are built before the first run, so every run should report zero heap allocations
+(counted only in builds that link the allocation hooks - ALLOC_STATS=1 ./FULL_EXECUTE.sh).
+*/
+void BatchRunner::benchmark(const MissionConfig& config, std::size_t runs) {
+    std::vector<MissionConfig> configs(runs, config);
+    for (std::size_t i = 0; i < runs; ++i) {
+        configs[i].turbulenceSeed = i + 1;   // distinct turbulence field per run
+    }
+
+    const unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    double baseline = 0.0;
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "        Batch Throughput Scaling        " << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "[BENCH] " << runs << " runs x " << config.duration << " s at dt " << config.dt
+              << " s, wind " << config.windSpeed << " m/s with turbulence\n";
+
+    for (unsigned threads = 1;; threads = std::min(threads * 2, maxThreads)) {
+        BatchResults results = run(configs, threads, true);
+
+        uint64_t allocations = 0;
+        std::size_t arenaPeak = 0;
+        for (std::size_t i = 0; i < results.runs; ++i) {
+            allocations += results.summary[i].heapAllocations;
+            arenaPeak = std::max<std::size_t>(arenaPeak, results.summary[i].arenaBytes);
+        }
+
+        double rate = runs / results.seconds;
+        if (threads == 1) baseline = rate;
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << "[BENCH] Threads: " << std::setw(3) << threads
+                  << " | " << std::setw(9) << rate << " runs/s"
+                  << " | Speedup: " << std::setw(5) << rate / baseline << "x"
+                  << " | Heap allocs/run: ";
+        if (AllocStats::counting()) {
+            std::cout << static_cast<double>(allocations) / runs;
+        } else {
+            std::cout << "n/a";
+        }
+        std::cout << " | Arena peak: " << arenaPeak / 1024 << " KiB"
+                  << " | Arena overflows: " << results.arenaOverflows
+                  << " | Peak RSS: " << results.peakRssKb / 1024.0 << " MiB\n" << std::defaultfloat;
+
+        if (threads == maxThreads) break;
+    }
+}
@@ -0,0 +1,137 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include "mission_phase.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+
+/**
+ * @brief Vehicle + environment for one batch run
+ * - Defaults are the Scheduler's vehicle, so a default batch run matches the live loop without wind.
+ */
+struct MissionConfig {
+    double mass = 500000.0;         // kg
+    double thrust = 7600000.0;      // N
+    double burnRate = 100.0;        // kg/s
+    double isp = 311.0;             // s
+    double dragArea = 5.0;          // m²
+    double fuel = 1000.0;           // kg
+    double windSpeed = 0.0;         // 10 m surface wind (m/s); 0 = still air
+    uint64_t turbulenceSeed = 0;    // 0 = mean wind only
+    double duration = 600.0;        // s
+    double dt = 0.1;                // s
+    double gravity = 9.80665;       // surface gravity (m/s²); standard gravity unless a launch site sets it
+
+    // Vehicle from scripts/api_data/rocket_specs.json (total thrust = thrust_N x engine_count)
+    bool loadRocketSpecs(const std::string& path);
+    // Surface wind from scripts/api_data/weather_conditions.json
+    bool loadWeather(const std::string& path);
+    // Surface gravity at a launch site's geodetic latitude (WGS-84 normal gravity)
+    void setLaunchLatitude(double degrees);
+};
+
+
+// Per-run scalars
+struct RunSummary {
+    double maxAltitude = 0.0;
+    double maxVelocity = 0.0;
+    double maxDragForce = 0.0;
+    double apogeeTime = -1.0;       // s, -1 if not reached
+    double burnoutTime = -1.0;      // s, -1 if fuel remained
+    MissionPhase finalPhase = MissionPhase::PRE_LAUNCH;
+    uint32_t samples = 0;
+    uint32_t heapAllocations = 0;   // operator new calls made by the worker during this run (hooked builds)
+    uint32_t arenaBytes = 0;        // worker arena use for this run
+};
+
+
+// Allocator that leaves new elements uninitialized, so a channel's pages are first touched by the worker that writes them
+template<typename T>
+struct UninitializedAllocator : std::allocator<T> {
+    template<typename U> struct rebind { using other = UninitializedAllocator<U>; };
+    UninitializedAllocator() = default;
+    template<typename U> UninitializedAllocator(const UninitializedAllocator<U>&) noexcept {}
+
+    template<typename U> void construct(U* p) noexcept { ::new (static_cast<void*>(p)) U; }
+    template<typename U, typename... Args> void construct(U* p, Args&&... args) {
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+};
+
+template<typename T>
+using Channel = std::vector<T, UninitializedAllocator<T>>;
+
+
+/**
+ * @brief Results of a whole batch in structure-of-arrays layout
+ * - Every channel is one contiguous [runs x capacity] row-major block; run i owns row i.
+ * - Sized once from the configured durations and dt; nothing grows during the batch.
+ * - Rows shorter than `capacity` (runs that ended early) are padded with NaN / -1 phase.
+ * - Each row is written (and first touched) only by the worker that ran it.
+ * - A channel block can be handed out as a 2-D array view (row stride = capacity) without copying.
+ */
+struct BatchResults {
+    std::size_t runs = 0;
+    std::size_t capacity = 0;       // samples per row (row stride)
+
+    Channel<double> time, altitude, velocity, fuel, dragForce;
+    Channel<int32_t> phase;
+    std::vector<RunSummary> summary;
+
+    // Whole-batch figures
+    unsigned threads = 0;
+    double seconds = 0.0;           // wall time of the batch
+    std::size_t peakRssKb = 0;      // process peak RSS after the batch
+    uint64_t arenaOverflows = 0;    // arena requests that fell through to the heap
+
+    void allocate(std::size_t runCount, std::size_t samplesPerRun);
+};
+
+
+
+/**
+==========================================
+    Batch Runner (Monte Carlo / Parameter Sweeps)
+==========================================
+
+- Runs independent missions from PRE_LAUNCH to POST_FLIGHT (or the configured duration) in worker threads.
+- Same vertical dynamics, flight events and phase rules as the live loop's numerical stepping
+  (FlightDynamics::advance with the vehicle + phase events, CDH::evaluatePhase), without console I/O.
+  The live loop's analytic coast, reentry model, ascent profile and landing guidance are not flown here.
+- Each worker writes straight into its run's rows of the shared BatchResults; no locking, no per-sample allocation.
+- Per-run scratch (wind model, turbulence field) lives in a per-worker BumpArena that is reset between runs,
+  so steady-state runs make no heap allocations at all.
+- With pinning, worker k is bound to CPU k before it builds its arena (NUMA-local by first touch).
+*/
+class BumpArena;
+
+class BatchRunner {
+public:
+    static constexpr std::size_t WORKER_ARENA_BYTES = 4 * 1024 * 1024;   // a 100 km turbulence field is ~0.5 MB
+
+    /**
+     * @brief Runs every configuration
+     * @param threads Worker count (0 = hardware concurrency)
+     * @param pinThreads Bind worker k to CPU k (Linux)
+     */
+    static BatchResults run(const std::vector<MissionConfig>& configs, unsigned threads = 0, bool pinThreads = false);
+
+    /**
+     * @brief Runs one mission with its scratch in `arena` (the caller resets it afterwards)
+     * @param results When given, the trajectory is written into row `run` (padded to capacity) and the
+     *                summary stored there too; without it only the summary is produced (sweep workers)
+     */
+    static RunSummary simulate(const MissionConfig& config, BumpArena& arena,
+                               BatchResults* results = nullptr, std::size_t run = 0);
+
+    // Throughput at 1, 2, 4 ... hardware-concurrency workers for `runs` copies of `config`
+    static void benchmark(const MissionConfig& config, std::size_t runs);
+};
+
+#endif
@@ -0,0 +1,171 @@
+#include "branch_runner.h"
+#include "cdh.h"
+#include "adcs.h"
+#include "gnc.h"
+#include "sensor_suite.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+
+
+BranchRunner::BranchRunner(const SimulationCheckpoint& checkpoint, double dt)
+    : base(checkpoint), dt(dt) {
+    flight.loadConfiguration("program_configuration.json", "ascent_profile.json");
+    flight.restore(base.flight);
+    flight.setConsoleMessages(false);
+
+    wind.loadWeather("scripts/api_data/weather_conditions.json");
+    wind.generateTurbulence(base.windSeed);
+}
+
+
+
+/**
+==========================================
+    Run One Branch From The Shared Checkpoint
+==========================================
+
+Same order as Scheduler::run: step, sensors over the step, ADCS / GNC, ascent schedule, landing burn,
+then CDH's phase rule on the resulting state.
+*/
+BranchResult BranchRunner::runBranch(const Branch& branch, double duration) const {
+    BranchResult result;
+    result.name = branch.name;
+
+    // Clone the checkpointed state - the constructor values are overwritten immediately
+    FlightDynamics dynamics(0, 0, 0, 0, 0);
+    dynamics.setState(base.dynamics);
+    dynamics.setConsoleWarnings(false);
+    dynamics.setWindModel(&wind);
+    dynamics.addVehicleEvents();
+    CDH::registerPhaseEvents(dynamics);
+    dynamics.setArmedEvents(base.armedEvents);
+    FlightStepper stepper = flight;
+    MissionPhase phase = base.phase;
+
+    // Sample streams and solver matrices make these too large for a worker's stack
+    auto sensors = std::make_unique<SensorSuite>(base.sensors.seed);
+    auto gnc = std::make_unique<GNC>();
+    ADCS adcs;
+    sensors->restore(base.sensors);
+    adcs.restore(base.adcs);
+    gnc->configureLanding(stepper.getBooster());
+    gnc->restore(base.gnc);
+    gnc->setConsoleMessages(false);
+
+    if (branch.engineScale != 1.0) {
+        dynamics.setThrust(dynamics.getThrust() * branch.engineScale);
+        dynamics.setBurnRate(dynamics.getState().burnRate * branch.engineScale);
+        stepper.setEngineScale(branch.engineScale);
+    }
+    if (branch.perturb) {
+        branch.perturb(dynamics);
+    }
+
+    // Event stops shorten a cycle, so the branch runs to its end time rather than for a cycle count
+    result.trajectory.reserve(static_cast<std::size_t>(duration / dt + 0.5));
+    double time = base.elapsedTime;
+    const double end = base.elapsedTime + duration;
+
+    while (time < end - 1e-9 && phase != MissionPhase::POST_FLIGHT) {
+        const FlightDynamics::State stepStart = dynamics.getState();
+        const double stepStartTime = time;
+        const double stepStartCrossWind = dynamics.getCrossWindForce();
+        time += stepper.step(dynamics, phase, time, std::min(dt, end - time), nullptr);
+
+        sensors->generate(stepStartTime, time, dynamics, stepStart, dynamics.getState(),
+                          stepStartCrossWind, dynamics.getCrossWindForce());
+        adcs.update(sensors->imu());
+        gnc->update(sensors->gps(), sensors->baro());
+        stepper.flyAscent(dynamics, time);
+        stepper.flyLanding(dynamics, *gnc, time, dt);
+
+        TelemetryData data{};
+        data.time = time;
+        data.altitude = dynamics.getAltitude();
+        data.velocity = dynamics.getVelocity();
+        data.fuel = dynamics.getFuel();
+        data.thrust = dynamics.getThrust();
+        data.deltaV = dynamics.getDeltaV();
+        data.dragForce = dynamics.getDragForce();
+        phase = CDH::evaluatePhase(phase, data);
+
+        result.trajectory.push_back({time, data.altitude, data.velocity, data.fuel, phase});
+        result.maxAltitude = std::max(result.maxAltitude, data.altitude);
+        result.maxVelocity = std::max(result.maxVelocity, std::abs(data.velocity));
+        if (stepper.hasLanded()) {
+            result.touchdown = true;
+            result.impactVelocity = stepper.getImpactVelocity();
+            break;
+        }
+    }
+
+    result.finalPhase = phase;
+    return result;
+}
+
+
+
+/**
+==========================================
+    Run All Branches In Parallel
+==========================================
+*/
+std::vector<BranchResult> BranchRunner::run(const std::vector<Branch>& branches, double duration, unsigned threads) const {
+    std::vector<BranchResult> results(branches.size());
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min<unsigned>(threads, static_cast<unsigned>(branches.size()));
+
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        for (std::size_t i = next++; i < branches.size(); i = next++) {
+            results[i] = runBranch(branches[i], duration);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();  // the calling thread works too
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    return results;
+}
+
+
+
+void BranchRunner::printSummary(const std::vector<BranchResult>& results) {
+    Telemetry names;
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "        What-If Branch Results          " << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    for (const auto& result : results) {
+        const TrajectorySample* last = result.trajectory.empty() ? nullptr : &result.trajectory.back();
+        std::cout << std::fixed << std::setprecision(2)
+                  << "[BRANCH] " << result.name
+                  << " | Samples: " << result.trajectory.size()
+                  << " | Max Alt: " << result.maxAltitude << " m"
+                  << " | Max Vel: " << result.maxVelocity << " m/s"
+                  << " | Final Phase: " << names.phaseToString(result.finalPhase);
+        if (last) {
+            std::cout << " | End: t=" << last->time << "s alt=" << last->altitude << " m";
+        }
+        if (result.touchdown) {
+            std::cout << " | Touchdown at " << result.impactVelocity << " m/s";
+        }
+        std::cout << "\n";
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef BRANCH_RUNNER_H
+#define BRANCH_RUNNER_H
+
+#include "checkpoint.h"
+#include "flight_dynamics.h"
+#include "flight_stepper.h"
+#include "wind_model.h"
+#include "mission_phase.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+
+
+// One recorded point of a branch trajectory
+struct TrajectorySample {
+    double time;
+    double altitude;
+    double velocity;
+    double fuel;
+    MissionPhase phase;
+};
+
+
+/**
+ * @brief A "what-if" variant forked from a common checkpoint
+ * - perturb() is applied once to the cloned dynamics at the divergence point (e.g. drag area)
+ * - engineScale scales every engine command from the divergence point on (ascent schedule and landing burn
+ *   re-command the engine each cycle, so a one-off thrust change would not last): 0 = engine failure
+ */
+struct Branch {
+    std::string name;
+    std::function<void(FlightDynamics&)> perturb;
+    double engineScale = 1.0;
+};
+
+
+struct BranchResult {
+    std::string name;
+    std::vector<TrajectorySample> trajectory;   // post-divergence samples only
+    MissionPhase finalPhase = MissionPhase::PRE_LAUNCH;
+    double maxAltitude = 0.0;
+    double maxVelocity = 0.0;
+    bool touchdown = false;        // the branch ended on the ground
+    double impactVelocity = 0.0;   // m/s
+};
+
+
+
+/**
+==========================================
+    Branch Runner (What-If Analysis)
+==========================================
+
+- Restores a checkpoint once, then clones the in-process state into every branch (no rerun from PRE_LAUNCH).
+- Every branch flies the live loop's cycle: FlightStepper (vehicle / phase events, wind, coast, reentry,
+  ascent schedule and MECO separation), sensors -> ADCS / GNC, and the landing burn, with CDH's phase rule.
+  Configuration (program configuration, ascent profile, weather) is read from the same files as the live run.
+- Branches run in parallel worker threads; each owns its copies of the dynamics, stepper, sensors and GNC,
+  and the turbulence field (rebuilt from the checkpoint's seed) is shared read-only, so no locking is needed.
+- Only the segment after the divergence point is integrated and recorded; a branch ends at touchdown.
+*/
+class BranchRunner {
+private:
+    SimulationCheckpoint base;
+    double dt;
+    FlightStepper flight;   // configured once, copied into every branch
+    WindModel wind;
+
+    BranchResult runBranch(const Branch& branch, double duration) const;
+
+public:
+    BranchRunner(const SimulationCheckpoint& checkpoint, double dt);
+
+    /**
+     * @brief Runs every branch for `duration` seconds past the checkpoint
+     * @param threads Worker count (0 = hardware concurrency)
+     */
+    std::vector<BranchResult> run(const std::vector<Branch>& branches, double duration, unsigned threads = 0) const;
+
+    static void printSummary(const std::vector<BranchResult>& results);
+};
+
+#endif
@@ -0,0 +1,533 @@
+#include "checkpoint.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+
+
+namespace {
+
+const char CHECKPOINT_MAGIC[8] = {'O', 'S', 'F', 'S', 'C', 'K', 'P', 'T'};
+constexpr std::size_t HEADER_SIZE = sizeof(CHECKPOINT_MAGIC) + 2 * sizeof(uint32_t);
+
+
+// Append / read one trivially copyable field
+template <typename T>
+void put(std::vector<uint8_t>& out, const T& value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool get(const std::vector<uint8_t>& in, std::size_t& offset, T& value) {
+    if (offset + sizeof(T) > in.size()) return false;
+    std::memcpy(&value, in.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+// Flags are stored as one byte (0 / 1); anything else is a corrupt payload
+void putFlag(std::vector<uint8_t>& out, bool value) {
+    put(out, static_cast<uint8_t>(value ? 1 : 0));
+}
+
+bool getFlag(const std::vector<uint8_t>& in, std::size_t& offset, bool& value) {
+    uint8_t byte = 0;
+    if (!get(in, offset, byte) || byte > 1) return false;
+    value = byte != 0;
+    return true;
+}
+
+void putVector(std::vector<uint8_t>& out, const Vec3& v) {
+    put(out, v.x);
+    put(out, v.y);
+    put(out, v.z);
+}
+
+bool getVector(const std::vector<uint8_t>& in, std::size_t& offset, Vec3& v) {
+    return get(in, offset, v.x) && get(in, offset, v.y) && get(in, offset, v.z);
+}
+
+// Counters and enums are stored as int32
+void putInt(std::vector<uint8_t>& out, int value) {
+    put(out, static_cast<int32_t>(value));
+}
+
+bool getInt(const std::vector<uint8_t>& in, std::size_t& offset, int& value) {
+    int32_t stored = 0;
+    if (!get(in, offset, stored)) return false;
+    value = stored;
+    return true;
+}
+
+// Fixed-size arrays of plain values, element by element
+template <typename Array>
+void putEach(std::vector<uint8_t>& out, const Array& values) {
+    for (const auto& value : values) put(out, value);
+}
+
+template <typename Array>
+bool getEach(const std::vector<uint8_t>& in, std::size_t& offset, Array& values) {
+    for (auto& value : values) {
+        if (!get(in, offset, value)) return false;
+    }
+    return true;
+}
+
+
+
+// ==========================================
+// One block per subsystem snapshot
+// ==========================================
+// Telemetry's latest sample, channel by channel from the schema (enums as int32, range-checked)
+void putChannel(std::vector<uint8_t>& out, double value) {
+    put(out, value);
+}
+
+void putChannel(std::vector<uint8_t>& out, MissionPhase value) {
+    put(out, static_cast<int32_t>(value));
+}
+
+bool getChannel(const std::vector<uint8_t>& in, std::size_t& offset, double& value) {
+    return get(in, offset, value);
+}
+
+bool getChannel(const std::vector<uint8_t>& in, std::size_t& offset, MissionPhase& value) {
+    int32_t stored = 0;
+    if (!get(in, offset, stored) || stored < 0 || stored > static_cast<int32_t>(MissionPhase::POST_FLIGHT)) return false;
+    value = static_cast<MissionPhase>(stored);
+    return true;
+}
+
+void putTelemetry(std::vector<uint8_t>& out, const Telemetry::State& telemetry) {
+#define TELEMETRY_PUT(field, ...) putChannel(out, telemetry.field);
+    TELEMETRY_CHANNELS(TELEMETRY_PUT)
+#undef TELEMETRY_PUT
+}
+
+bool getTelemetry(const std::vector<uint8_t>& in, std::size_t& offset, Telemetry::State& telemetry) {
+    bool ok = true;
+#define TELEMETRY_GET(field, ...) ok = ok && getChannel(in, offset, telemetry.field);
+    TELEMETRY_CHANNELS(TELEMETRY_GET)
+#undef TELEMETRY_GET
+    return ok;
+}
+
+
+void putFlight(std::vector<uint8_t>& out, const FlightStepper::Snapshot& flight) {
+    putFlag(out, flight.coasting);
+    putFlag(out, flight.coastOrbitKnown);
+    putFlag(out, flight.coastPerturbed);
+    put(out, flight.coastEpoch);
+    putVector(out, flight.coastEpochState.r);
+    putVector(out, flight.coastEpochState.v);
+
+    const ReentryModel::Snapshot& reentry = flight.reentry;
+    putFlag(out, flight.reentering);
+    put(out, reentry.state.time);
+    put(out, reentry.state.altitude);
+    put(out, reentry.state.downrange);
+    put(out, reentry.state.velocity);
+    put(out, reentry.state.flightPathAngle);
+    put(out, reentry.state.heatLoad);
+    put(out, reentry.stepSize);
+    putFlag(out, reentry.landed);
+    put(out, reentry.peakHeatFlux);
+    put(out, reentry.peakDeceleration);
+    put(out, reentry.peakDynamicPressure);
+    put(out, reentry.steps);
+    put(out, reentry.rejected);
+    put(out, reentry.evaluations);
+    for (const auto& row : reentry.jacobian) putEach(out, row);
+    putInt(out, reentry.jacobianAge);
+
+    putFlag(out, flight.mecoCommanded);
+}
+
+bool getFlight(const std::vector<uint8_t>& in, std::size_t& offset, FlightStepper::Snapshot& flight) {
+    ReentryModel::Snapshot& reentry = flight.reentry;
+    bool ok =
+        getFlag(in, offset, flight.coasting) &&
+        getFlag(in, offset, flight.coastOrbitKnown) &&
+        getFlag(in, offset, flight.coastPerturbed) &&
+        get(in, offset, flight.coastEpoch) &&
+        getVector(in, offset, flight.coastEpochState.r) &&
+        getVector(in, offset, flight.coastEpochState.v) &&
+        getFlag(in, offset, flight.reentering) &&
+        get(in, offset, reentry.state.time) &&
+        get(in, offset, reentry.state.altitude) &&
+        get(in, offset, reentry.state.downrange) &&
+        get(in, offset, reentry.state.velocity) &&
+        get(in, offset, reentry.state.flightPathAngle) &&
+        get(in, offset, reentry.state.heatLoad) &&
+        get(in, offset, reentry.stepSize) &&
+        getFlag(in, offset, reentry.landed) &&
+        get(in, offset, reentry.peakHeatFlux) &&
+        get(in, offset, reentry.peakDeceleration) &&
+        get(in, offset, reentry.peakDynamicPressure) &&
+        get(in, offset, reentry.steps) &&
+        get(in, offset, reentry.rejected) &&
+        get(in, offset, reentry.evaluations);
+
+    for (auto& row : reentry.jacobian) ok = ok && getEach(in, offset, row);
+    return ok && getInt(in, offset, reentry.jacobianAge) && getFlag(in, offset, flight.mecoCommanded);
+}
+
+
+void putSensors(std::vector<uint8_t>& out, const SensorSuite::Snapshot& sensors) {
+    put(out, sensors.seed);
+    put(out, sensors.counter);
+    put(out, sensors.imuTick);
+    put(out, sensors.gpsTick);
+    put(out, sensors.baroTick);
+    putEach(out, sensors.imuBias);
+    put(out, static_cast<uint32_t>(sensors.pendingCount));
+    for (std::size_t i = 0; i < sensors.pendingCount; ++i) {
+        const GpsFix& fix = sensors.pendingFixes[i];
+        put(out, fix.time);
+        put(out, fix.available);
+        put(out, fix.altitude);
+        put(out, fix.verticalVelocity);
+    }
+}
+
+bool getSensors(const std::vector<uint8_t>& in, std::size_t& offset, SensorSuite::Snapshot& sensors) {
+    uint32_t pending = 0;
+    bool ok =
+        get(in, offset, sensors.seed) &&
+        get(in, offset, sensors.counter) &&
+        get(in, offset, sensors.imuTick) &&
+        get(in, offset, sensors.gpsTick) &&
+        get(in, offset, sensors.baroTick) &&
+        getEach(in, offset, sensors.imuBias) &&
+        get(in, offset, pending);
+    if (!ok || pending > sensors.pendingFixes.size()) return false;
+
+    sensors.pendingCount = pending;
+    for (std::size_t i = 0; i < sensors.pendingCount; ++i) {
+        GpsFix& fix = sensors.pendingFixes[i];
+        ok = ok && get(in, offset, fix.time) && get(in, offset, fix.available) &&
+             get(in, offset, fix.altitude) && get(in, offset, fix.verticalVelocity);
+    }
+    return ok;
+}
+
+
+void putAdcs(std::vector<uint8_t>& out, const ADCS::Snapshot& adcs) {
+    putEach(out, adcs.attitude);
+    putEach(out, adcs.specificForce);
+    put(out, adcs.lastSampleTime);
+    put(out, adcs.samplesConsumed);
+    put(out, adcs.lastBatch);
+}
+
+bool getAdcs(const std::vector<uint8_t>& in, std::size_t& offset, ADCS::Snapshot& adcs) {
+    return getEach(in, offset, adcs.attitude) &&
+           getEach(in, offset, adcs.specificForce) &&
+           get(in, offset, adcs.lastSampleTime) &&
+           get(in, offset, adcs.samplesConsumed) &&
+           get(in, offset, adcs.lastBatch);
+}
+
+
+void putLandingState(std::vector<uint8_t>& out, const LandingState& state) {
+    put(out, state.time);
+    putEach(out, state.position);
+    putEach(out, state.velocity);
+    put(out, state.mass);
+    put(out, state.gravity);
+}
+
+bool getLandingState(const std::vector<uint8_t>& in, std::size_t& offset, LandingState& state) {
+    return get(in, offset, state.time) &&
+           getEach(in, offset, state.position) &&
+           getEach(in, offset, state.velocity) &&
+           get(in, offset, state.mass) &&
+           get(in, offset, state.gravity);
+}
+
+
+void putLanding(std::vector<uint8_t>& out, const LandingGuidance::Snapshot& landing) {
+    putFlag(out, landing.engaged);
+    putInt(out, static_cast<int>(landing.status));
+    put(out, landing.ignitionTime);
+    put(out, landing.lastSolveTime);
+    putInt(out, landing.nextStretch);
+
+    const LandingGuidance::Search& search = landing.search;
+    putFlag(out, search.active);
+    putInt(out, static_cast<int>(search.stage));
+    putLandingState(out, search.start);
+    put(out, search.tMin);
+    put(out, search.tMax);
+    putInt(out, search.point);
+    putInt(out, search.step);
+    put(out, search.lo);
+    put(out, search.hi);
+    put(out, search.a);
+    put(out, search.b);
+    put(out, search.fuelA);
+    put(out, search.fuelB);
+    putFlag(out, search.okA);
+    putFlag(out, search.okB);
+    putFlag(out, search.haveA);
+    putFlag(out, search.haveB);
+    putFlag(out, search.found);
+    put(out, search.bestFuel);
+    put(out, search.bestTime);
+    putEach(out, search.bestControls);
+    putInt(out, search.solves);
+    putInt(out, search.cycles);
+    put(out, search.milliseconds);
+
+    put(out, landing.planStart);
+    put(out, landing.planDuration);
+    put(out, landing.plannedFuel);
+    putEach(out, landing.planControls);
+    putEach(out, landing.x);
+    putEach(out, landing.z);
+    putEach(out, landing.y);
+    put(out, landing.rho);
+}
+
+bool getLanding(const std::vector<uint8_t>& in, std::size_t& offset, LandingGuidance::Snapshot& landing) {
+    LandingGuidance::Search& search = landing.search;
+    int status = 0, stage = 0;
+    bool ok =
+        getFlag(in, offset, landing.engaged) &&
+        getInt(in, offset, status) &&
+        get(in, offset, landing.ignitionTime) &&
+        get(in, offset, landing.lastSolveTime) &&
+        getInt(in, offset, landing.nextStretch) &&
+        getFlag(in, offset, search.active) &&
+        getInt(in, offset, stage) &&
+        getLandingState(in, offset, search.start) &&
+        get(in, offset, search.tMin) &&
+        get(in, offset, search.tMax) &&
+        getInt(in, offset, search.point) &&
+        getInt(in, offset, search.step) &&
+        get(in, offset, search.lo) &&
+        get(in, offset, search.hi) &&
+        get(in, offset, search.a) &&
+        get(in, offset, search.b) &&
+        get(in, offset, search.fuelA) &&
+        get(in, offset, search.fuelB) &&
+        getFlag(in, offset, search.okA) &&
+        getFlag(in, offset, search.okB) &&
+        getFlag(in, offset, search.haveA) &&
+        getFlag(in, offset, search.haveB) &&
+        getFlag(in, offset, search.found) &&
+        get(in, offset, search.bestFuel) &&
+        get(in, offset, search.bestTime) &&
+        getEach(in, offset, search.bestControls) &&
+        getInt(in, offset, search.solves) &&
+        getInt(in, offset, search.cycles) &&
+        get(in, offset, search.milliseconds) &&
+        get(in, offset, landing.planStart) &&
+        get(in, offset, landing.planDuration) &&
+        get(in, offset, landing.plannedFuel) &&
+        getEach(in, offset, landing.planControls) &&
+        getEach(in, offset, landing.x) &&
+        getEach(in, offset, landing.z) &&
+        getEach(in, offset, landing.y) &&
+        get(in, offset, landing.rho);
+
+    const int lastStatus = static_cast<int>(LandingStatus::NO_PROPELLANT);
+    const int lastStage = static_cast<int>(LandingGuidance::SearchStage::DONE);
+    if (!ok || status < 0 || status > lastStatus || stage < 0 || stage > lastStage) return false;
+    landing.status = static_cast<LandingStatus>(status);
+    search.stage = static_cast<LandingGuidance::SearchStage>(stage);
+    return true;
+}
+
+
+void putGnc(std::vector<uint8_t>& out, const GNC::Snapshot& gnc) {
+    put(out, gnc.navAltitude);
+    put(out, gnc.navVelocity);
+    put(out, gnc.baroOffset);
+    put(out, gnc.lastBaroAltitude);
+    put(out, gnc.lastBaroTime);
+    put(out, gnc.lastFixTime);
+    putFlag(out, gnc.navValid);
+    put(out, gnc.gpsFixes);
+    put(out, gnc.baroSamples);
+    putInt(out, static_cast<int>(gnc.reportedLandingStatus));
+    putLanding(out, gnc.landing);
+}
+
+bool getGnc(const std::vector<uint8_t>& in, std::size_t& offset, GNC::Snapshot& gnc) {
+    int reported = 0;
+    bool ok =
+        get(in, offset, gnc.navAltitude) &&
+        get(in, offset, gnc.navVelocity) &&
+        get(in, offset, gnc.baroOffset) &&
+        get(in, offset, gnc.lastBaroAltitude) &&
+        get(in, offset, gnc.lastBaroTime) &&
+        get(in, offset, gnc.lastFixTime) &&
+        getFlag(in, offset, gnc.navValid) &&
+        get(in, offset, gnc.gpsFixes) &&
+        get(in, offset, gnc.baroSamples) &&
+        getInt(in, offset, reported) &&
+        getLanding(in, offset, gnc.landing);
+
+    if (!ok || reported < 0 || reported > static_cast<int>(LandingStatus::NO_PROPELLANT)) return false;
+    gnc.reportedLandingStatus = static_cast<LandingStatus>(reported);
+    return true;
+}
+
+
+void putWatchdog(std::vector<uint8_t>& out, const CycleWatchdog::Snapshot& watchdog) {
+    putInt(out, watchdog.level);
+    putInt(out, watchdog.overrunStreak);
+    putInt(out, watchdog.slackStreak);
+}
+
+bool getWatchdog(const std::vector<uint8_t>& in, std::size_t& offset, CycleWatchdog::Snapshot& watchdog) {
+    return getInt(in, offset, watchdog.level) &&
+           getInt(in, offset, watchdog.overrunStreak) &&
+           getInt(in, offset, watchdog.slackStreak);
+}
+
+}  // namespace
+
+
+
+/**
+==========================================
+    Serialize - Header + Field-by-Field Payload
+==========================================
+
+Fields are written one at a time (not as whole structs) so padding never leaks into the file
+and a version bump is enough to detect layout changes.
+*/
+std::vector<uint8_t> SimulationCheckpoint::serialize() const {
+    std::vector<uint8_t> out;
+    out.reserve(8192);
+
+    out.insert(out.end(), CHECKPOINT_MAGIC, CHECKPOINT_MAGIC + sizeof(CHECKPOINT_MAGIC));
+    put(out, CHECKPOINT_VERSION);
+    put(out, uint32_t{0});  // payload size, patched below
+
+    // FlightDynamics
+    put(out, dynamics.mass);
+    put(out, dynamics.thrust);
+    put(out, dynamics.burnRate);
+    put(out, dynamics.isp);
+    put(out, dynamics.velocity);
+    put(out, dynamics.altitude);
+    put(out, dynamics.fuel);
+    put(out, dynamics.deltaV);
+    put(out, dynamics.dragForce);
+    put(out, dynamics.dragArea);
+    put(out, dynamics.gravity);
+    put(out, armedEvents);
+
+    // Telemetry
+    putTelemetry(out, telemetry);
+
+    // CDH + Scheduler
+    put(out, static_cast<int32_t>(phase));
+    put(out, cycle);
+    put(out, elapsedTime);
+
+    // Flight stepper, wind, sensors, ADCS, GNC, watchdog
+    putFlight(out, flight);
+    put(out, windSeed);
+    putSensors(out, sensors);
+    putAdcs(out, adcs);
+    putGnc(out, gnc);
+    putWatchdog(out, watchdog);
+
+    uint32_t payload = static_cast<uint32_t>(out.size() - HEADER_SIZE);
+    std::memcpy(out.data() + sizeof(CHECKPOINT_MAGIC) + sizeof(uint32_t), &payload, sizeof(payload));
+    return out;
+}
+
+
+
+bool SimulationCheckpoint::deserialize(const std::vector<uint8_t>& bytes) {
+    if (bytes.size() < HEADER_SIZE || std::memcmp(bytes.data(), CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0) {
+        std::cerr << "[CHECKPOINT ERROR] Not a checkpoint file.\n";
+        return false;
+    }
+
+    std::size_t offset = sizeof(CHECKPOINT_MAGIC);
+    uint32_t version = 0, payload = 0;
+    get(bytes, offset, version);
+    get(bytes, offset, payload);
+
+    if (version != CHECKPOINT_VERSION) {
+        std::cerr << "[CHECKPOINT ERROR] Unsupported checkpoint version " << version
+                  << " (expected " << CHECKPOINT_VERSION << ").\n";
+        return false;
+    }
+    if (HEADER_SIZE + payload != bytes.size()) {
+        std::cerr << "[CHECKPOINT ERROR] Truncated or corrupted checkpoint.\n";
+        return false;
+    }
+
+    SimulationCheckpoint restored;
+    int32_t cdhPhase = 0;
+
+    bool ok =
+        get(bytes, offset, restored.dynamics.mass) &&
+        get(bytes, offset, restored.dynamics.thrust) &&
+        get(bytes, offset, restored.dynamics.burnRate) &&
+        get(bytes, offset, restored.dynamics.isp) &&
+        get(bytes, offset, restored.dynamics.velocity) &&
+        get(bytes, offset, restored.dynamics.altitude) &&
+        get(bytes, offset, restored.dynamics.fuel) &&
+        get(bytes, offset, restored.dynamics.deltaV) &&
+        get(bytes, offset, restored.dynamics.dragForce) &&
+        get(bytes, offset, restored.dynamics.dragArea) &&
+        get(bytes, offset, restored.dynamics.gravity) &&
+        get(bytes, offset, restored.armedEvents) &&
+        getTelemetry(bytes, offset, restored.telemetry) &&
+        get(bytes, offset, cdhPhase) &&
+        get(bytes, offset, restored.cycle) &&
+        get(bytes, offset, restored.elapsedTime) &&
+        getFlight(bytes, offset, restored.flight) &&
+        get(bytes, offset, restored.windSeed) &&
+        getSensors(bytes, offset, restored.sensors) &&
+        getAdcs(bytes, offset, restored.adcs) &&
+        getGnc(bytes, offset, restored.gnc) &&
+        getWatchdog(bytes, offset, restored.watchdog);
+
+    const int32_t lastPhase = static_cast<int32_t>(MissionPhase::POST_FLIGHT);
+    if (!ok || cdhPhase < 0 || cdhPhase > lastPhase) {
+        std::cerr << "[CHECKPOINT ERROR] Invalid checkpoint payload.\n";
+        return false;
+    }
+
+    restored.phase = static_cast<MissionPhase>(cdhPhase);
+    *this = restored;
+    return true;
+}
+
+
+
+bool SimulationCheckpoint::saveToFile(const std::string& path) const {
+    std::vector<uint8_t> bytes = serialize();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open()) {
+        std::cerr << "[CHECKPOINT ERROR] Could not open " << path << " for writing.\n";
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return file.good();
+}
+
+
+
+bool SimulationCheckpoint::loadFromFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file.is_open()) {
+        std::cerr << "[CHECKPOINT ERROR] Could not open " << path << " for reading.\n";
+        return false;
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return deserialize(bytes);
+}
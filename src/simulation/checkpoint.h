@@ -0,0 +1,62 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "flight_dynamics.h"
+#include "telemetry/telemetry.h"
+#include "mission_phase.h"
+#include "flight_stepper.h"
+#include "sensor_suite.h"
+#include "adcs.h"
+#include "gnc.h"
+#include "watchdog.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+
+/**
+==========================================
+    Simulation Checkpoint
+==========================================
+
+- The simulation state the loop carries from one cycle to the next: FlightDynamics and its event table's
+  armed flags, CDH phase, Telemetry's latest sample (every schema channel), the Scheduler cycle/time, the flight stepper (analytic coast, reentry model, MECO), the wind seed, the
+  sensor suite (RNG seed and counter, sample clocks, IMU biases, GPS fixes in latency), ADCS, GNC navigation
+  and landing guidance (plan, ignition search, solver warm start) and the watchdog's degradation level.
+- A restored run continues from the same state and is reproducible except for wall-clock-dependent effects:
+  the landing guidance's per-cycle solve budgets and the watchdog's measured costs.
+- Statistics (solve logs, sensor and watchdog counters) stay with the process that gathered them.
+- Everything is plain data, so capture/restore is a handful of copies (microseconds).
+- Serialized as a versioned binary snapshot:
+
+    "OSFSCKPT" | uint32 version | uint32 payload bytes | payload (little-endian fields)
+
+  Bump CHECKPOINT_VERSION whenever a field is added, removed or reordered.
+*/
+constexpr uint32_t CHECKPOINT_VERSION = 5;
+
+
+struct SimulationCheckpoint {
+    FlightDynamics::State dynamics{};
+    uint32_t armedEvents = 0xFFFFFFFFu;               // event table armed flags: one-shots (fuel depletion, max-Q) fired = 0
+    Telemetry::State telemetry{};
+    MissionPhase phase = MissionPhase::PRE_LAUNCH;   // CDH's view of the phase
+    int64_t cycle = 0;
+    double elapsedTime = 0.0;
+
+    FlightStepper::Snapshot flight{};                // coast, reentry, MECO
+    uint64_t windSeed = 0;                           // turbulence field (the mean profile is reloaded from the weather file)
+    SensorSuite::Snapshot sensors{};
+    ADCS::Snapshot adcs{};
+    GNC::Snapshot gnc{};
+    CycleWatchdog::Snapshot watchdog{};
+
+    std::vector<uint8_t> serialize() const;
+    bool deserialize(const std::vector<uint8_t>& bytes);
+
+    bool saveToFile(const std::string& path) const;
+    bool loadFromFile(const std::string& path);
+};
+
+#endif
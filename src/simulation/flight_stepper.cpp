@@ -0,0 +1,350 @@
+#include "flight_stepper.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <json/json.h>
+
+
+namespace {
+constexpr double STANDARD_GRAVITY = 9.80665;   // m/s², Isp -> exhaust velocity
+}
+
+
+
+void FlightStepper::loadConfiguration(const std::string& configPath, const std::string& profilePath) {
+    // Launch site latitude sets the inclination used when handing off to the orbit propagator
+    std::ifstream configFile(configPath);
+    Json::Value config;
+    if (configFile.is_open() && Json::parseFromStream(Json::CharReaderBuilder(), configFile, &config, nullptr)) {
+        launchLatitude = config.get("latitude", launchLatitude).asDouble();
+    }
+
+    // Entry vehicle aero tables for the reentry hand-off
+    reentryReady = capsule.loadConfig(configPath);
+    if (reentryReady) reentry.setVehicle(capsule);
+
+    // Optimized ascent: the booster limits come from the profile's first stage
+    ascentLoaded = ascent.load(profilePath);
+    if (ascentLoaded) {
+        booster.dryMass = ascent.stage1Dry;
+        booster.maxThrust = ascent.thrust;
+        booster.isp = ascent.isp;
+    }
+}
+
+
+
+/**
+==========================================
+    One Step - Integrator, Coast Or Reentry
+==========================================
+*/
+double FlightStepper::step(FlightDynamics& dynamics, MissionPhase phase, double time, double dt,
+                           FlightDynamics::EventRecord* event) {
+    bool coast = !reentering && shouldCoast(dynamics, phase);
+    if (coast && !coasting) {
+        enterCoast(dynamics, time);
+    } else if (!coast && coasting) {
+        if (shouldReenter(dynamics, phase)) {
+            enterReentry(time);
+        } else if (consoleMessages) {
+            std::cout << "[SCHEDULER] Leaving analytic coast - numerical integration resumed.\n";
+        }
+        coasting = false;
+    }
+
+    if (reentering) {
+        stepReentry(dynamics, dt);
+        return dt;
+    }
+    if (coasting) {
+        stepCoast(dynamics, time, dt);
+        return dt;
+    }
+
+    // A registered event ends the step early, exactly on its threshold; the next cycle continues from there
+    dynamics.setActivePhase(static_cast<int>(phase));
+    double advanced = dynamics.advance(dt, event);
+    if (dynamics.getThrust() != 0.0) coastPerturbed = true;
+    groundContact(dynamics, phase);
+    return advanced;
+}
+
+
+
+/**
+ * The integrator has no ground: a vehicle on the pad with thrust below its weight, or one whose descent
+ * reaches 0 m (the Touchdown event stops and reports the step there), would keep falling. At or below 0 m, unless it is
+ * climbing away, the vehicle is held at rest on the ground. After liftoff that contact is the touchdown:
+ * the engine is cut and neither the ascent schedule nor landing guidance commands it again. `landed` is
+ * re-derived here each cycle (on the ground, past PRE_LAUNCH), so checkpoints need not carry it.
+ */
+void FlightStepper::groundContact(FlightDynamics& dynamics, MissionPhase phase) {
+    FlightDynamics::State s = dynamics.getState();
+    bool climbing = s.velocity > 0.0 || (s.velocity == 0.0 && dynamics.accelerationOf(s) > 0.0);
+    if (s.altitude > 0.0 || climbing) {
+        landed = false;
+        return;
+    }
+
+    bool touchdown = phase != MissionPhase::PRE_LAUNCH && !landed;
+    double impact = -s.velocity;
+    s.altitude = 0.0;
+    s.velocity = 0.0;
+    if (touchdown) {
+        s.thrust = 0.0;
+        s.burnRate = 0.0;
+    }
+    dynamics.setState(s);
+    landed = phase != MissionPhase::PRE_LAUNCH;
+
+    if (touchdown && impact > 0.0) {   // a reentry touchdown arrives at rest with its own impact velocity
+        impactVelocity = impact;
+    }
+}
+
+
+
+// Optimized ascent: stage-1 throttle schedule up to MECO (the pitch program needs more than the vertical axis)
+void FlightStepper::flyAscent(FlightDynamics& dynamics, double time) {
+    if (!ascentLoaded || mecoCommanded || coasting || landed) return;
+
+    if (time < ascent.meco) {
+        double throttle = engineScale * ascent.throttleAt(time);
+        dynamics.setThrust(ascent.thrust * throttle);
+        dynamics.setBurnRate(ascent.burnRate * throttle);
+        return;
+    }
+
+    dynamics.setThrust(0.0);
+    dynamics.setBurnRate(0.0);
+    mecoCommanded = true;
+    // Stage separation: from here the loop flies the booster back (the upper stage is the optimizer's)
+    FlightDynamics::State separated = dynamics.getState();
+    separated.mass = std::min(separated.mass, booster.dryMass + separated.fuel);
+    dynamics.setState(separated);
+    if (consoleMessages) {
+        std::cout << "[SCHEDULER] MECO at T+" << time << "s per ascent profile | Fuel: " << dynamics.getFuel() << " kg\n";
+    }
+}
+
+
+
+// Landing guidance flies the engine once it engages (not while the profile owns it, nor in orbit / capsule entry)
+void FlightStepper::flyLanding(FlightDynamics& dynamics, GNC& gnc, double time, double dt) {
+    LandingCommand landing;
+    bool ascentPowered = ascentLoaded && !mecoCommanded;
+    bool analytic = coasting || reentering;
+    if (ascentPowered || analytic || landed || !gnc.updateLanding(time, dynamics.getFuel(), dynamics.getState().gravity, dt, landing)) {
+        return;
+    }
+
+    double mass = dynamics.getState().mass;   // the plant's mass, so the commanded acceleration is the one flown
+    dynamics.setThrust(landing.active ? engineScale * landing.acceleration[0] * mass : 0.0);
+    dynamics.setBurnRate(landing.active ? engineScale * landing.throttleAcceleration * mass / (booster.isp * STANDARD_GRAVITY) : 0.0);
+}
+
+
+
+
+
+/**
+==========================================
+    Orbital Coast Hand-Off
+==========================================
+
+The vertical model carries only altitude and the radial (vertical) rate. On the first hand-off the vehicle
+is placed over the launch latitude with its speed horizontal and due east (flight path angle 0,
+inclination = latitude). While coasting, the propagator owns the trajectory and writes altitude and the
+radial rate r.v/|r| back into FlightDynamics, so CDH and telemetry keep reading the same getters and a
+hand-back to the integrator starts from a physical vertical state.
+
+A later coast resumes the earlier orbit: unchanged if the engine has not fired since (the integrator
+cannot hold an orbit, so its unpowered gap is discarded), otherwise rebuilt at the current altitude and
+radial rate with the old orbit's plane, along-track position and angular momentum (a vertical burn does
+not change it).
+*/
+bool FlightStepper::shouldCoast(const FlightDynamics& dynamics, MissionPhase phase) const {
+    bool orbitalPhase = phase == MissionPhase::MISSION_OPS ||
+                        phase == MissionPhase::ORBITAL_ADJUSTMENTS ||
+                        phase == MissionPhase::DEORBIT;
+
+    return orbitalPhase && dynamics.getThrust() == 0.0 && dynamics.getAltitude() > COAST_MIN_ALTITUDE;
+}
+
+
+void FlightStepper::enterCoast(const FlightDynamics& dynamics, double time) {
+    if (coastOrbitKnown && !coastPerturbed) {
+        coasting = true;
+        if (consoleMessages) std::cout << "[SCHEDULER] Resuming analytic coast on the previous orbit.\n";
+        return;
+    }
+
+    double radius = R_EARTH + dynamics.getAltitude();
+    StateVector state;
+
+    if (coastOrbitKnown) {
+        StateVector previous = coastPropagator.stateAt(time);
+        Vec3 radial = previous.r * (1.0 / previous.r.norm());
+        Vec3 momentum = previous.r.cross(previous.v);
+        Vec3 along = momentum.cross(radial) * (1.0 / momentum.norm());
+
+        state.r = radial * radius;
+        state.v = radial * dynamics.getVelocity() + along * (momentum.norm() / radius);
+    } else {
+        double lat = launchLatitude * M_PI / 180.0;
+        state.r = Vec3{radius * std::cos(lat), 0.0, radius * std::sin(lat)};
+        state.v = Vec3{0.0, dynamics.getVelocity(), 0.0};  // local east at longitude 0
+    }
+
+    coastPropagator.initialize(state, time);
+    if (!coastPropagator.isValid()) {
+        if (consoleMessages) std::cerr << "[SCHEDULER WARNING] Trajectory is not a closed orbit - staying on numerical integration.\n";
+        coastOrbitKnown = false;
+        return;
+    }
+    coasting = true;
+    coastOrbitKnown = true;
+    coastPerturbed = false;
+    if (!consoleMessages) return;
+
+    OrbitalElements el = coastPropagator.elementsAt(time);
+    DeorbitWindow deorbit = coastPropagator.nextDeorbitWindow(time, 50000.0);
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "[SCHEDULER] Entering analytic coast (Kepler + J2)"
+              << " | Periapsis: " << (el.periapsisRadius() - R_EARTH) / 1000.0 << " km"
+              << " | Apoapsis: " << (el.apoapsisRadius() - R_EARTH) / 1000.0 << " km"
+              << " | Period: " << el.period() / 60.0 << " min\n"
+              << "[SCHEDULER] Next apoapsis T+" << coastPropagator.nextApoapsis(time) << "s"
+              << " | Next periapsis T+" << coastPropagator.nextPeriapsis(time) << "s"
+              << " | Ascending node T+" << coastPropagator.nextAscendingNode(time) << "s"
+              << " | Descending node T+" << coastPropagator.nextDescendingNode(time) << "s\n";
+    if (deorbit.valid) {
+        std::cout << "[SCHEDULER] Deorbit window (50 km periapsis) T+" << deorbit.time
+                  << "s, retrograde " << deorbit.deltaV << " m/s\n";
+    }
+    std::cout << std::defaultfloat;
+}
+
+
+void FlightStepper::stepCoast(FlightDynamics& dynamics, double time, double dt) {
+    StateVector state = coastPropagator.stateAt(time + dt);
+    double radius = state.r.norm();
+
+    FlightDynamics::State s = dynamics.getState();
+    s.altitude = radius - R_EARTH;
+    s.velocity = state.r.dot(state.v) / radius;   // radial rate: the vertical model's velocity
+    s.dragForce = 0.0;
+    dynamics.setState(s);
+}
+
+
+
+
+/**
+==========================================
+    Reentry Hand-Off
+==========================================
+
+When an unpowered DEORBIT / REENTRY coast drops below COAST_MIN_ALTITUDE, the reentry model starts
+from the propagator's state (speed and flight-path angle from r and v) and flies the vehicle to
+touchdown with its own adaptive steps; altitude, vertical rate (speed x sin flight-path angle) and drag
+are written back into FlightDynamics each cycle as the coast does.
+*/
+bool FlightStepper::shouldReenter(const FlightDynamics& dynamics, MissionPhase phase) const {
+    bool entryPhase = phase == MissionPhase::DEORBIT || phase == MissionPhase::REENTRY;
+
+    return reentryReady && entryPhase && dynamics.getThrust() == 0.0 && dynamics.getAltitude() <= COAST_MIN_ALTITUDE;
+}
+
+
+void FlightStepper::enterReentry(double time) {
+    StateVector orbit = coastPropagator.stateAt(time);
+    double radius = orbit.r.norm();
+    double speed = orbit.v.norm();
+
+    ReentryState start;
+    start.time = time;
+    start.altitude = radius - R_EARTH;
+    start.velocity = speed;
+    start.flightPathAngle = speed > 0.0 ? std::asin(std::clamp(orbit.r.dot(orbit.v) / (radius * speed), -1.0, 1.0)) : 0.0;
+    reentry.reset(start);
+    reentering = true;
+    coastOrbitKnown = false;   // the orbit ends here
+    if (!consoleMessages) return;
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "[SCHEDULER] Entering atmosphere - reentry model engaged at T+" << time << "s"
+              << " | Altitude: " << start.altitude / 1000.0 << " km"
+              << " | Velocity: " << speed << " m/s"
+              << " | Flight path: " << start.flightPathAngle * 180.0 / M_PI << " deg\n" << std::defaultfloat;
+}
+
+
+void FlightStepper::stepReentry(FlightDynamics& dynamics, double dt) {
+    reentry.advance(dt);
+    const ReentryState& entry = reentry.getState();
+
+    FlightDynamics::State s = dynamics.getState();
+    s.altitude = entry.altitude;
+    s.velocity = entry.velocity * std::sin(entry.flightPathAngle);   // vertical rate, as the coast writes
+    s.dragForce = reentry.conditions().dragForce;
+    if (reentry.hasLanded()) {
+        s.altitude = 0.0;
+        s.velocity = 0.0;
+        s.dragForce = 0.0;
+        reentering = false;
+        impactVelocity = entry.velocity;
+
+        if (consoleMessages) {
+            std::cout << std::fixed << std::setprecision(2)
+                      << "[EVENT] Touchdown at T+" << entry.time << "s | Downrange: " << entry.downrange / 1000.0 << " km"
+                      << " | Impact velocity: " << entry.velocity << " m/s\n"
+                      << "[SCHEDULER] Entry summary | Peak heat flux: " << reentry.getPeakHeatFlux() / 1e4 << " W/cm²"
+                      << " | Heat load: " << entry.heatLoad / 1e7 << " kJ/cm²"
+                      << " | Peak deceleration: " << reentry.getPeakDeceleration() << " g"
+                      << " | Steps: " << reentry.getSteps() << " (" << reentry.getRejectedSteps() << " rejected)\n"
+                      << std::defaultfloat;
+        }
+    }
+    dynamics.setState(s);
+}
+
+
+
+
+/**
+==========================================
+    Checkpoint / Restore
+==========================================
+*/
+FlightStepper::Snapshot FlightStepper::snapshot() const {
+    Snapshot snapshot;
+    snapshot.coasting = coasting;
+    snapshot.coastOrbitKnown = coastOrbitKnown;
+    snapshot.coastPerturbed = coastPerturbed;
+    if (coastOrbitKnown) {
+        snapshot.coastEpoch = coastPropagator.getEpoch();
+        snapshot.coastEpochState = coastPropagator.getEpochState();
+    }
+    snapshot.reentering = reentering;
+    snapshot.reentry = reentry.snapshot();   // also after touchdown: telemetry keeps reporting the heat load
+    snapshot.mecoCommanded = mecoCommanded;
+    return snapshot;
+}
+
+
+void FlightStepper::restore(const Snapshot& snapshot) {
+    coasting = snapshot.coasting;
+    coastOrbitKnown = snapshot.coastOrbitKnown;
+    coastPerturbed = snapshot.coastPerturbed;
+    if (coastOrbitKnown) {
+        coastPropagator.initialize(snapshot.coastEpochState, snapshot.coastEpoch);   // the same orbit, not a rebuilt one
+    }
+    reentering = snapshot.reentering;
+    reentry.restore(snapshot.reentry);
+    mecoCommanded = snapshot.mecoCommanded;
+}
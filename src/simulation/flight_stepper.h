@@ -0,0 +1,122 @@
+#ifndef FLIGHT_STEPPER_H
+#define FLIGHT_STEPPER_H
+
+#include "flight_dynamics.h"
+#include "mission_phase.h"
+#include "orbital_mechanics.h"
+#include "reentry.h"
+#include "ascent_optimizer.h"
+#include "landing_guidance.h"
+#include "gnc.h"
+#include <string>
+
+
+
+/**
+==========================================
+    Flight Stepper (Vehicle Side Of One Cycle)
+==========================================
+
+- The vehicle motion of a Scheduler cycle, shared with the what-if branches so both fly the same path:
+    step()        numerical integration (stops on the vehicle / phase events, held at rest on the ground),
+                  the analytic coast in orbit, or the reentry model below COAST_MIN_ALTITUDE
+    flyAscent()   the optimized ascent's throttle schedule, MECO and stage separation
+    flyLanding()  the landing-guidance command once GNC engages
+- Holds no FlightDynamics of its own: every call takes the one it flies, so one configured stepper can be
+  copied into any number of branches.
+- Snapshot holds everything that changes in flight (checkpoints); the rest is configuration.
+*/
+class FlightStepper {
+public:
+    static constexpr double COAST_MIN_ALTITUDE = 100000.0;  // Below the Karman line drag matters - keep integrating (m)
+
+    struct Snapshot {
+        // Analytic coast (the propagator is re-initialized from its epoch state, which reproduces it exactly)
+        bool coasting = false;
+        bool coastOrbitKnown = false;
+        bool coastPerturbed = false;
+        double coastEpoch = 0.0;                     // s
+        StateVector coastEpochState{};
+
+        // Atmospheric entry
+        bool reentering = false;
+        ReentryModel::Snapshot reentry{};
+
+        bool mecoCommanded = false;
+    };
+
+    /**
+     * @brief Launch latitude and entry vehicle from the program configuration, the ascent profile
+     * (and the booster limits it carries) if one has been optimized
+     */
+    void loadConfiguration(const std::string& configPath, const std::string& profilePath);
+
+    /**
+     * @brief Advances the vehicle from `time` by up to dt
+     * @param phase CDH's phase, which decides coast and reentry hand-offs
+     * @param event Filled when a registered event ends the step early (integration only)
+     * @return The time actually advanced
+     */
+    double step(FlightDynamics& dynamics, MissionPhase phase, double time, double dt, FlightDynamics::EventRecord* event);
+    void flyAscent(FlightDynamics& dynamics, double time);
+    void flyLanding(FlightDynamics& dynamics, GNC& gnc, double time, double dt);
+
+    // Commanded engine cutoff (ABORT): ends the ascent schedule where it is, without stage separation;
+    // landing guidance may still fly the recovery
+    void cutEngine() { mecoCommanded = true; }
+
+    Snapshot snapshot() const;
+    void restore(const Snapshot& snapshot);
+
+    // Every engine command issued here (ascent schedule, landing burn) is scaled by this (what-if engine faults)
+    void setEngineScale(double scale) { engineScale = scale; }
+    void setConsoleMessages(bool enabled) { consoleMessages = enabled; }   // off for parallel branches
+
+    bool isCoasting() const { return coasting; }
+    bool isReentering() const { return reentering; }
+    bool hasLanded() const { return landed; }                 // on the ground after liftoff (engine cut)
+    double getImpactVelocity() const { return impactVelocity; }   // speed at the last touchdown (m/s)
+    const ReentryModel& getReentry() const { return reentry; }
+    bool hasAscent() const { return ascentLoaded; }
+    const AscentProfile& getAscent() const { return ascent; }
+    const LandingVehicle& getBooster() const { return booster; }
+
+private:
+    // Analytic coast: replaces numerical stepping during unpowered orbital flight
+    KeplerPropagator coastPropagator;
+    bool coasting = false;
+    bool coastOrbitKnown = false;    // coastPropagator holds the orbit of an earlier coast
+    bool coastPerturbed = false;     // engine fired since that coast ended
+    double launchLatitude = 28.5721;  // deg, from program_configuration.json (orbit inclination for a due-east launch)
+
+    // Landing burn: booster limits handed to GNC's landing guidance (the same engines as ascent, throttling down to 40 %)
+    LandingVehicle booster{499000.0, 7600000.0, 0.4, 311.0};
+
+    // Optimized ascent from --optimize-ascent (ascent_profile.json); the 1-D loop flies its throttle schedule to MECO
+    AscentProfile ascent;
+    bool ascentLoaded = false;
+    bool mecoCommanded = false;
+
+    // Atmospheric entry: the aerothermal model takes over from the coast below COAST_MIN_ALTITUDE
+    ReentryVehicle capsule;
+    ReentryModel reentry{ReentryVehicle{}};
+    bool reentryReady = false;   // "reentry" block loaded
+    bool reentering = false;
+
+    // Ground contact (derived from the state each step, not checkpointed)
+    bool landed = false;
+    double impactVelocity = 0.0;
+
+    double engineScale = 1.0;
+    bool consoleMessages = true;
+
+    bool shouldCoast(const FlightDynamics& dynamics, MissionPhase phase) const;
+    void enterCoast(const FlightDynamics& dynamics, double time);
+    void stepCoast(FlightDynamics& dynamics, double time, double dt);
+    bool shouldReenter(const FlightDynamics& dynamics, MissionPhase phase) const;
+    void enterReentry(double time);
+    void stepReentry(FlightDynamics& dynamics, double dt);
+    void groundContact(FlightDynamics& dynamics, MissionPhase phase);
+};
+
+#endif
@@ -0,0 +1,293 @@
+/*
+Simulated flight sensors derived from the FlightDynamics truth state.
+
+Research:
+
+1. IEEE Std 952-1997, IEEE Standard Specification Format Guide and Test Procedure for Single-Axis
+Interferometric Fiber Optic Gyros - Allan variance terms (angle/velocity random walk, bias instability)
+
+2. U.S. Standard Atmosphere, 1976 (NOAA-S/T 76-1562)
+https://ntrs.nasa.gov/citations/19770009539
+*/
+
+#include "sensor_suite.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+
+namespace {
+
+constexpr double SEA_LEVEL_PRESSURE = 101325.0;     // Pa
+constexpr double TROPOPAUSE = 11000.0;               // m
+constexpr double TROPOPAUSE_PRESSURE = 22632.1;      // Pa
+constexpr double LAPSE_FACTOR = 2.25577e-5;          // 1/m  (L / T0)
+constexpr double PRESSURE_EXPONENT = 5.25588;        // g M / (R L)
+constexpr double STRATOSPHERE_SCALE = 6341.62;       // m  (R T / g M at 216.65 K)
+constexpr double EPSILON = 1e-9;
+
+inline double quantize(double value, double lsb) {
+    return lsb * std::nearbyint(value / lsb);
+}
+
+// First tick index on a clock of `rate` Hz at or after time t
+inline int64_t firstTick(double t, double rate) {
+    return static_cast<int64_t>(std::ceil(t * rate - EPSILON));
+}
+
+}  // namespace
+
+
+
+SensorSuite::SensorSuite(uint64_t seed) : seed(seed), rng(seed) {
+    // Turn-on biases: drawn once per power cycle
+    double draw[6];
+    rng.fillNormal(draw, 6, counter);
+    counter += 3;
+
+    for (int a = 0; a < 3; ++a) {
+        imuBias[a] = GYRO_TURN_ON_BIAS * draw[a];
+        imuBias[a + 3] = ACCEL_TURN_ON_BIAS * draw[a + 3];
+    }
+}
+
+
+
+/**
+==========================================
+    Generate One Step's Worth Of Samples
+==========================================
+*/
+void SensorSuite::generate(double t0, double t1, const FlightDynamics& dynamics,
+                           const FlightDynamics::State& start, const FlightDynamics::State& end,
+                           double crossWind0, double crossWind1) {
+    if (t1 <= t0) return;
+    auto wallStart = std::chrono::steady_clock::now();
+
+    // Specific force along the body axis is what an accelerometer sees: a + g (1 g sitting on the pad)
+    double accel0 = dynamics.accelerationOf(start) + start.gravity;
+    double accel1 = dynamics.accelerationOf(end) + end.gravity;
+    double lateral0 = start.mass > 0.0 ? crossWind0 / start.mass : 0.0;
+    double lateral1 = end.mass > 0.0 ? crossWind1 / end.mass : 0.0;
+
+    stats.imuSamples += generateImu(t0, t1, lateral0, lateral1, accel0, accel1);
+    generateGps(t0, t1, start, end);
+    generateBaro(t0, t1, start, end);
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+    stats.blocks++;
+    stats.generationSeconds += ms / 1000.0;
+    stats.simulatedSeconds += t1 - t0;
+    stats.worstBlockMs = std::max(stats.worstBlockMs, ms);
+}
+
+
+
+/**
+==========================================
+    IMU - 1 kHz Blocks
+==========================================
+
+Per block of n samples: one bulk fill of 6n white-noise normals and one of 6n walk increments
+(axis-major), a running sum for the bias walk, then straight per-axis loops for truth + errors.
+*/
+std::size_t SensorSuite::generateImu(double t0, double t1, double lateral0, double lateral1, double accel0, double accel1) {
+    if (imuTick < 0) imuTick = firstTick(t0, IMU_RATE);
+
+    const double period = 1.0 / IMU_RATE;
+    const double span = t1 - t0;
+    const int64_t endTick = firstTick(t1, IMU_RATE);   // first tick not in this step
+    const double gyroSigma = GYRO_NOISE_DENSITY * std::sqrt(IMU_RATE);
+    const double accelSigma = ACCEL_NOISE_DENSITY * std::sqrt(IMU_RATE);
+    const double gyroWalk = GYRO_BIAS_WALK * std::sqrt(period);
+    const double accelWalk = ACCEL_BIAS_WALK * std::sqrt(period);
+
+    std::size_t generated = 0;
+
+    while (imuTick < endTick) {
+        const std::size_t n = static_cast<std::size_t>(std::min<int64_t>(endTick - imuTick, MAX_BLOCK));
+
+        rng.fillNormal(normals, 6 * n, counter);
+        counter += 3 * n;
+        rng.fillNormal(walk, 6 * n, counter);
+        counter += 3 * n;
+
+        // Bias random walk -> walk[] now holds the bias at every sample
+        for (std::size_t a = 0; a < 6; ++a) {
+            double sigma = (a < 3) ? gyroWalk : accelWalk;
+            double bias = imuBias[a];
+            double* series = walk + a * n;
+            for (std::size_t i = 0; i < n; ++i) {
+                bias += sigma * series[i];
+                series[i] = bias;
+            }
+            imuBias[a] = bias;
+        }
+
+        // Gyros: no attitude dynamics in the truth model, so they measure bias + noise only
+        for (std::size_t a = 0; a < 3; ++a) {
+            double* out = normals + a * n;
+            const double* bias = walk + a * n;
+            for (std::size_t i = 0; i < n; ++i) {
+                out[i] = quantize(bias[i] + gyroSigma * out[i], GYRO_LSB);
+            }
+        }
+
+        // Accelerometers: truth interpolated across the step
+        const double truth0[3] = {accel0, lateral0, 0.0};
+        const double truth1[3] = {accel1, lateral1, 0.0};
+        for (std::size_t a = 0; a < 3; ++a) {
+            double* out = normals + (a + 3) * n;
+            const double* bias = walk + (a + 3) * n;
+            const double slope = (truth1[a] - truth0[a]) / span;
+            for (std::size_t i = 0; i < n; ++i) {
+                double t = static_cast<double>(imuTick + static_cast<int64_t>(i)) * period;
+                double truth = truth0[a] + slope * (t - t0);
+                double measured = std::clamp(truth + bias[i] + accelSigma * out[i], -ACCEL_RANGE, ACCEL_RANGE);
+                out[i] = quantize(measured, ACCEL_LSB);
+            }
+        }
+
+        // Publish
+        for (std::size_t i = 0; i < n; ++i) {
+            ImuSample sample;
+            sample.time = static_cast<double>(imuTick + static_cast<int64_t>(i)) * period;
+            for (std::size_t a = 0; a < 3; ++a) {
+                sample.gyro[a] = normals[a * n + i];
+                sample.accel[a] = normals[(a + 3) * n + i];
+            }
+            if (!imuStream.push(sample)) stats.dropped++;
+        }
+
+        imuTick += static_cast<int64_t>(n);
+        generated += n;
+    }
+    return generated;
+}
+
+
+
+/**
+==========================================
+    GPS - 10 Hz, Held Back For The Receiver Latency
+==========================================
+*/
+void SensorSuite::generateGps(double t0, double t1, const FlightDynamics::State& start, const FlightDynamics::State& end) {
+    if (gpsTick < 0) gpsTick = firstTick(t0, GPS_RATE);
+    const int64_t endTick = firstTick(t1, GPS_RATE);
+    const double span = t1 - t0;
+
+    for (; gpsTick < endTick; ++gpsTick) {
+        double t = static_cast<double>(gpsTick) / GPS_RATE;
+        double f = (t - t0) / span;
+        double noise[2];
+        rng.fillNormal(noise, 2, counter++);
+
+        GpsFix fix;
+        fix.time = t;
+        fix.available = t + GPS_LATENCY;
+        fix.altitude = start.altitude + f * (end.altitude - start.altitude) + GPS_ALTITUDE_SIGMA * noise[0];
+        fix.verticalVelocity = start.velocity + f * (end.velocity - start.velocity) + GPS_VELOCITY_SIGMA * noise[1];
+
+        if (pendingCount < pendingFixes.size()) {
+            pendingFixes[pendingCount++] = fix;
+        } else {
+            stats.dropped++;
+        }
+        stats.gpsFixes++;
+    }
+
+    // Release everything whose latency has elapsed by the end of this step (oldest first)
+    std::size_t released = 0;
+    while (released < pendingCount && pendingFixes[released].available <= t1 + EPSILON) {
+        if (!gpsStream.push(pendingFixes[released])) stats.dropped++;
+        released++;
+    }
+    std::move(pendingFixes.begin() + released, pendingFixes.begin() + pendingCount, pendingFixes.begin());
+    pendingCount -= released;
+}
+
+
+
+/**
+==========================================
+    Barometer - 50 Hz
+==========================================
+*/
+void SensorSuite::generateBaro(double t0, double t1, const FlightDynamics::State& start, const FlightDynamics::State& end) {
+    if (baroTick < 0) baroTick = firstTick(t0, BARO_RATE);
+    const int64_t endTick = firstTick(t1, BARO_RATE);
+    const double span = t1 - t0;
+
+    for (; baroTick < endTick; ++baroTick) {
+        double t = static_cast<double>(baroTick) / BARO_RATE;
+        double altitude = start.altitude + (t - t0) / span * (end.altitude - start.altitude);
+        double noise[2];
+        rng.fillNormal(noise, 2, counter++);
+
+        BaroSample sample;
+        sample.time = t;
+        sample.pressure = quantize(std::max(pressureAt(altitude) + BARO_SIGMA * noise[0], 0.0), BARO_LSB);
+        sample.altitude = altitudeAt(sample.pressure);
+
+        if (!baroStream.push(sample)) stats.dropped++;
+        stats.baroSamples++;
+    }
+}
+
+
+
+SensorSuite::Snapshot SensorSuite::snapshot() const {
+    return Snapshot{seed, counter, imuTick, gpsTick, baroTick, imuBias, pendingFixes, pendingCount};
+}
+
+
+// The same seed rebuilds the same noise: every draw is a function of (seed, counter) only
+void SensorSuite::restore(const Snapshot& snapshot) {
+    seed = snapshot.seed;
+    rng = CounterRng(seed);
+    counter = snapshot.counter;
+    imuTick = snapshot.imuTick;
+    gpsTick = snapshot.gpsTick;
+    baroTick = snapshot.baroTick;
+    imuBias = snapshot.imuBias;
+    pendingFixes = snapshot.pendingFixes;
+    pendingCount = std::min(snapshot.pendingCount, pendingFixes.size());
+}
+
+
+
+// ==========================================
+// ISA pressure <-> altitude
+// ==========================================
+double SensorSuite::pressureAt(double altitude) {
+    if (altitude <= TROPOPAUSE) {
+        return SEA_LEVEL_PRESSURE * std::pow(std::max(1.0 - LAPSE_FACTOR * altitude, 0.0), PRESSURE_EXPONENT);
+    }
+    return TROPOPAUSE_PRESSURE * std::exp(-(altitude - TROPOPAUSE) / STRATOSPHERE_SCALE);
+}
+
+double SensorSuite::altitudeAt(double pressure) {
+    if (pressure <= 0.0) return std::numeric_limits<double>::infinity();
+    if (pressure >= TROPOPAUSE_PRESSURE) {
+        return (1.0 - std::pow(pressure / SEA_LEVEL_PRESSURE, 1.0 / PRESSURE_EXPONENT)) / LAPSE_FACTOR;
+    }
+    return TROPOPAUSE - STRATOSPHERE_SCALE * std::log(pressure / TROPOPAUSE_PRESSURE);
+}
+
+
+
+void SensorSuite::report() const {
+    double realTime = stats.generationSeconds > 0.0 ? stats.simulatedSeconds / stats.generationSeconds : 0.0;
+    double avgUs = stats.blocks ? stats.generationSeconds * 1e6 / stats.blocks : 0.0;
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "[SENSORS] IMU: " << stats.imuSamples << " | GPS: " << stats.gpsFixes << " | Baro: " << stats.baroSamples
+              << " | Dropped: " << stats.dropped << "\n"
+              << "[SENSORS] Generation: " << avgUs << " us/step avg, " << stats.worstBlockMs << " ms worst"
+              << " | " << realTime << "x real time" << (realTime >= 1.0 || stats.blocks == 0 ? " (keeping up)" : " (FALLING BEHIND)")
+              << "\n" << std::defaultfloat;
+}
@@ -0,0 +1,124 @@
+#ifndef SENSOR_SUITE_H
+#define SENSOR_SUITE_H
+
+#include "flight_dynamics.h"
+#include "sensor_data.h"
+#include "counter_rng.h"
+#include <array>
+#include <cstdint>
+
+
+
+/**
+==========================================
+    Simulated Sensor Suite (IMU 1 kHz, GPS 10 Hz, Barometer 50 Hz)
+==========================================
+
+- Derived from the FlightDynamics truth: each Scheduler cycle hands over the state at the start and the end
+  of the step, and every sample time in between is generated as one block (truth interpolated across it).
+- Error models:
+    IMU   white noise + constant turn-on bias + bias random walk, quantization to the LSB, ±16 g saturation
+    GPS   white noise on altitude / vertical velocity, fixed receiver latency (fixes are held until available)
+    Baro  ISA pressure, white noise, quantization
+- All noise for a block comes from bulk CounterRng fills (no loop-carried state, vectorizes); only the
+  bias random walk is a running sum.
+- Samples are published to SPSC streams; full streams drop (and count) samples rather than block.
+*/
+class SensorSuite {
+public:
+    static constexpr double IMU_RATE = 1000.0;          // Hz
+    static constexpr double GPS_RATE = 10.0;
+    static constexpr double BARO_RATE = 50.0;
+    static constexpr double GPS_LATENCY = 0.1;          // s
+
+    // Tactical-grade MEMS IMU (per axis)
+    static constexpr double GYRO_NOISE_DENSITY = 5.8e-5;        // rad/s/√Hz
+    static constexpr double GYRO_BIAS_WALK = 1.0e-5;            // rad/s/√s
+    static constexpr double GYRO_TURN_ON_BIAS = 2.0e-3;         // rad/s (1σ)
+    static constexpr double GYRO_LSB = 2.66e-4;                 // rad/s (16 bit, ±500 °/s)
+    static constexpr double ACCEL_NOISE_DENSITY = 6.0e-4;       // m/s²/√Hz
+    static constexpr double ACCEL_BIAS_WALK = 3.0e-4;           // m/s²/√s
+    static constexpr double ACCEL_TURN_ON_BIAS = 2.0e-2;        // m/s² (1σ)
+    static constexpr double ACCEL_LSB = 4.79e-3;                // m/s² (16 bit, ±16 g)
+    static constexpr double ACCEL_RANGE = 16.0 * 9.80665;       // m/s²
+
+    static constexpr double GPS_ALTITUDE_SIGMA = 3.0;           // m
+    static constexpr double GPS_VELOCITY_SIGMA = 0.1;           // m/s
+    static constexpr double BARO_SIGMA = 1.5;                   // Pa
+    static constexpr double BARO_LSB = 1.0;                     // Pa
+
+    static constexpr std::size_t MAX_BLOCK = 1024;              // IMU samples generated per call at most
+
+    // Pipeline health: can generation keep up with the sample rates?
+    struct Stats {
+        uint64_t blocks = 0;
+        uint64_t imuSamples = 0, gpsFixes = 0, baroSamples = 0;
+        uint64_t dropped = 0;           // stream full
+        double generationSeconds = 0.0; // wall time spent generating
+        double simulatedSeconds = 0.0;  // sensor time covered
+        double worstBlockMs = 0.0;
+    };
+
+    // Everything the sample streams depend on besides the truth (checkpoints). The streams themselves are
+    // drained by ADCS / GNC every cycle, so they are empty between cycles and not part of it.
+    struct Snapshot {
+        uint64_t seed = 0;
+        uint64_t counter = 0;
+        int64_t imuTick = -1, gpsTick = -1, baroTick = -1;
+        std::array<double, 6> imuBias{};
+        std::array<GpsFix, 8> pendingFixes{};
+        std::size_t pendingCount = 0;
+    };
+
+private:
+    uint64_t seed;
+    CounterRng rng;
+    uint64_t counter = 0;              // next RNG counter (every block draws from a fresh range)
+
+    int64_t imuTick = -1, gpsTick = -1, baroTick = -1;   // index of the next sample on each sensor's clock
+    std::array<double, 6> imuBias{};   // gyro xyz, accel xyz (turn-on + accumulated walk)
+
+    std::array<GpsFix, 8> pendingFixes{};   // held back for the receiver latency
+    std::size_t pendingCount = 0;
+
+    ImuStream imuStream;
+    GpsStream gpsStream;
+    BaroStream baroStream;
+    Stats stats;
+
+    // Block scratch (members, so nothing is allocated per cycle)
+    double normals[6 * MAX_BLOCK];
+    double walk[6 * MAX_BLOCK];
+
+    std::size_t generateImu(double t0, double t1, double lateral0, double lateral1, double accel0, double accel1);
+    void generateGps(double t0, double t1, const FlightDynamics::State& start, const FlightDynamics::State& end);
+    void generateBaro(double t0, double t1, const FlightDynamics::State& start, const FlightDynamics::State& end);
+
+public:
+    explicit SensorSuite(uint64_t seed);
+
+    /**
+     * @brief Generates every sample due in [t0, t1) from the truth at both ends of the step
+     * @param dynamics Used for the truth accelerations (any wind model attached is honoured)
+     * @param crossWind0/crossWind1 Lateral force at the start / end (N)
+     */
+    void generate(double t0, double t1, const FlightDynamics& dynamics,
+                  const FlightDynamics::State& start, const FlightDynamics::State& end,
+                  double crossWind0, double crossWind1);
+
+    ImuStream& imu() { return imuStream; }
+    GpsStream& gps() { return gpsStream; }
+    BaroStream& baro() { return baroStream; }
+
+    Snapshot snapshot() const;
+    void restore(const Snapshot& snapshot);
+
+    const Stats& getStats() const { return stats; }
+    void report() const;
+
+    // ISA pressure model (troposphere + isothermal stratosphere)
+    static double pressureAt(double altitude);
+    static double altitudeAt(double pressure);
+};
+
+#endif
@@ -0,0 +1,190 @@
+/*
+Mergeable aggregates for distributed parameter sweeps.
+
+Research:
+
+1. Masson, Rim, Lee, "DDSketch: A Fast and Fully-Mergeable Quantile Sketch with Relative-Error Guarantees",
+Proceedings of the VLDB Endowment 12(12), 2019
+https://arxiv.org/abs/1908.10693
+*/
+
+#include "sweep_aggregate.h"
+#include "batch_runner.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+namespace {
+
+const double GAMMA = (1.0 + QuantileSketch::RELATIVE_ACCURACY) / (1.0 - QuantileSketch::RELATIVE_ACCURACY);
+const double LOG_GAMMA = std::log(GAMMA);
+const double MIN_INDEX = std::ceil(std::log(QuantileSketch::MIN_VALUE) / LOG_GAMMA);   // bucket 0
+
+}  // namespace
+
+
+
+// ==========================================
+// QuantileSketch
+// ==========================================
+void QuantileSketch::add(double value) {
+    total++;
+    if (!(value > MIN_VALUE)) {     // also catches NaN
+        zeros++;
+        return;
+    }
+    double index = std::ceil(std::log(value) / LOG_GAMMA) - MIN_INDEX;
+    std::size_t bucket = static_cast<std::size_t>(std::clamp(index, 0.0, static_cast<double>(BUCKETS - 1)));
+    buckets[bucket]++;
+}
+
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    for (std::size_t i = 0; i < BUCKETS; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    zeros += other.zeros;
+    total += other.total;
+}
+
+
+// Bucket i holds (γ^(k-1), γ^k]; its representative 2γ^k / (γ + 1) is within α of every value in it
+double QuantileSketch::quantile(double q) const {
+    if (total == 0) return std::numeric_limits<double>::quiet_NaN();
+
+    uint64_t rank = static_cast<uint64_t>(std::clamp(q, 0.0, 1.0) * static_cast<double>(total - 1));
+    if (rank < zeros) return 0.0;
+
+    uint64_t seen = zeros;
+    for (std::size_t i = 0; i < BUCKETS; ++i) {
+        seen += buckets[i];
+        if (seen > rank) {
+            return 2.0 * std::exp((static_cast<double>(i) + MIN_INDEX) * LOG_GAMMA) / (GAMMA + 1.0);
+        }
+    }
+    return std::exp((BUCKETS - 1 + MIN_INDEX) * LOG_GAMMA);
+}
+
+
+
+// ==========================================
+// LogHistogram
+// ==========================================
+void LogHistogram::add(double value) {
+    if (!(value > 0.0)) {
+        underflow++;
+        return;
+    }
+    double position = (std::log10(value) - MIN_DECADE) * BINS_PER_DECADE;
+    if (position < 0.0) {
+        underflow++;
+    } else if (position >= static_cast<double>(BINS)) {
+        overflow++;
+    } else {
+        bins[static_cast<std::size_t>(position)]++;
+    }
+}
+
+
+void LogHistogram::merge(const LogHistogram& other) {
+    for (std::size_t i = 0; i < BINS; ++i) {
+        bins[i] += other.bins[i];
+    }
+    underflow += other.underflow;
+    overflow += other.overflow;
+}
+
+
+double LogHistogram::lowerEdge(std::size_t bin) {
+    return std::pow(10.0, MIN_DECADE + static_cast<double>(bin) / BINS_PER_DECADE);
+}
+
+
+
+// ==========================================
+// MetricAggregate
+// ==========================================
+void MetricAggregate::add(double value, uint64_t run) {
+    if (count == 0 || value < min) min = value;
+    if (count == 0 || value > max) {
+        max = value;
+        maxRun = run;
+    }
+    count++;
+    if (std::isfinite(value)) {
+        // Rounded once here; from then on sums only add integers (|value| is clamped to fit an int64)
+        sum += std::llround(std::clamp(value * SUM_SCALE, -9.0e18, 9.0e18));
+    }
+    sketch.add(value);
+    histogram.add(value);
+}
+
+
+void MetricAggregate::merge(const MetricAggregate& other) {
+    if (other.count == 0) return;
+    if (count == 0 || other.min < min) min = other.min;
+    if (count == 0 || other.max > max || (other.max == max && other.maxRun < maxRun)) {
+        max = other.max;
+        maxRun = other.maxRun;   // ties go to the lowest run index, so the result is order-independent
+    }
+    count += other.count;
+    sum += other.sum;
+    sketch.merge(other.sketch);
+    histogram.merge(other.histogram);
+}
+
+
+double MetricAggregate::quantile(double q) const {
+    return count ? std::clamp(sketch.quantile(q), min, max) : std::numeric_limits<double>::quiet_NaN();
+}
+
+
+const char* metricName(int metric) {
+    switch (metric) {
+        case MAX_ALTITUDE:   return "Max Altitude";
+        case MAX_VELOCITY:   return "Max Velocity";
+        case MAX_DRAG_FORCE: return "Max Drag";
+        case APOGEE_TIME:    return "Apogee Time";
+        case BURNOUT_TIME:   return "Burnout Time";
+        default:             return "Unknown";
+    }
+}
+
+const char* metricUnit(int metric) {
+    switch (metric) {
+        case MAX_ALTITUDE:   return "m";
+        case MAX_VELOCITY:   return "m/s";
+        case MAX_DRAG_FORCE: return "N";
+        default:             return "s";
+    }
+}
+
+
+
+// ==========================================
+// SweepAggregate
+// ==========================================
+void SweepAggregate::add(uint64_t run, const RunSummary& summary) {
+    runs++;
+    finalPhase[std::min<std::size_t>(static_cast<std::size_t>(summary.finalPhase), PHASES - 1)]++;
+
+    metrics[MAX_ALTITUDE].add(summary.maxAltitude, run);
+    metrics[MAX_VELOCITY].add(summary.maxVelocity, run);
+    metrics[MAX_DRAG_FORCE].add(summary.maxDragForce, run);
+    if (summary.apogeeTime >= 0.0) metrics[APOGEE_TIME].add(summary.apogeeTime, run);
+    if (summary.burnoutTime >= 0.0) metrics[BURNOUT_TIME].add(summary.burnoutTime, run);
+}
+
+
+void SweepAggregate::merge(const SweepAggregate& other) {
+    runs += other.runs;
+    failed += other.failed;
+    cpuSeconds += other.cpuSeconds;
+    for (std::size_t i = 0; i < PHASES; ++i) {
+        finalPhase[i] += other.finalPhase[i];
+    }
+    for (std::size_t m = 0; m < METRIC_COUNT; ++m) {
+        metrics[m].merge(other.metrics[m]);
+    }
+}
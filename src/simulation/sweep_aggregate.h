@@ -0,0 +1,109 @@
+#ifndef SWEEP_AGGREGATE_H
+#define SWEEP_AGGREGATE_H
+
+#include "mission_phase.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+struct RunSummary;
+
+
+
+/**
+==========================================
+    Mergeable Sweep Aggregates
+==========================================
+
+- Workers reduce every run to these fixed-size, trivially copyable structures and stream partial
+  aggregates to the coordinator; merging is element-wise integer addition (metric sums are kept in
+  fixed point), so the merged result does not depend on how runs were split into shards or which
+  worker ran them. Only the worker-time total is a plain double.
+- QuantileSketch: DDSketch-style log buckets (relative-error guarantee on every quantile)
+- LogHistogram: fixed decade bins for plotting - same layout everywhere, so no range negotiation
+- Nothing allocates: the whole SweepAggregate is one POD that goes over the socket as-is.
+*/
+
+/**
+ * @brief Relative-error quantile sketch (DDSketch)
+ * - Value x > 0 lands in bucket ceil(log_γ x), γ = (1 + α) / (1 - α); any quantile is then
+ *   returned within relative error α. Counts merge by addition.
+ * - Fixed bucket range [MIN_VALUE, MIN_VALUE·γ^BUCKETS); values outside clamp to the end buckets.
+ */
+class QuantileSketch {
+public:
+    static constexpr double RELATIVE_ACCURACY = 0.01;  // α
+    static constexpr double MIN_VALUE = 1e-3;
+    static constexpr std::size_t BUCKETS = 2048;        // covers 1e-3 .. ~1e15 at α = 1 %
+
+    void add(double value);
+    void merge(const QuantileSketch& other);
+    double quantile(double q) const;                     // q in [0, 1]; NaN when empty
+    uint64_t count() const { return total; }
+
+private:
+    std::array<uint32_t, BUCKETS> buckets{};
+    uint64_t zeros = 0;              // values <= MIN_VALUE
+    uint64_t total = 0;
+};
+
+
+// Log-spaced histogram: BINS_PER_DECADE bins per decade from 10^MIN_DECADE, with under/overflow
+struct LogHistogram {
+    static constexpr int MIN_DECADE = -1;
+    static constexpr int DECADES = 8;                   // 0.1 .. 1e7
+    static constexpr int BINS_PER_DECADE = 4;
+    static constexpr std::size_t BINS = DECADES * BINS_PER_DECADE;
+
+    std::array<uint32_t, BINS> bins{};
+    uint32_t underflow = 0, overflow = 0;
+
+    void add(double value);
+    void merge(const LogHistogram& other);
+    static double lowerEdge(std::size_t bin);
+};
+
+
+// One metric: exact count / sum / extrema (with the run index that set the maximum) + sketch + histogram
+struct MetricAggregate {
+    static constexpr double SUM_SCALE = 1048576.0;      // 2^20: sum resolution ~1e-6 of the metric's unit
+
+    uint64_t count = 0;
+    __int128 sum = 0;                                   // fixed point (value x SUM_SCALE): exact under any merge order
+    double min = 0.0, max = 0.0;
+    uint64_t maxRun = 0;
+    QuantileSketch sketch;
+    LogHistogram histogram;
+
+    void add(double value, uint64_t run);
+    void merge(const MetricAggregate& other);
+    double mean() const { return count ? static_cast<double>(sum) / SUM_SCALE / static_cast<double>(count) : 0.0; }
+    double quantile(double q) const;    // sketch estimate, clamped to the exact extrema
+};
+
+
+enum SweepMetric { MAX_ALTITUDE, MAX_VELOCITY, MAX_DRAG_FORCE, APOGEE_TIME, BURNOUT_TIME, METRIC_COUNT };
+const char* metricName(int metric);
+const char* metricUnit(int metric);
+
+
+// Everything a worker reports for a set of runs
+struct SweepAggregate {
+    static constexpr std::size_t PHASES = static_cast<std::size_t>(MissionPhase::POST_FLIGHT) + 1;
+
+    uint64_t runs = 0;
+    uint64_t failed = 0;                                // runs that crashed their worker twice (skipped)
+    double cpuSeconds = 0.0;                            // worker time spent simulating
+    std::array<uint64_t, PHASES> finalPhase{};
+    std::array<MetricAggregate, METRIC_COUNT> metrics;
+
+    // Apogee / burnout are only recorded for runs that reached them
+    void add(uint64_t run, const RunSummary& summary);
+    void merge(const SweepAggregate& other);
+    void clear() { *this = SweepAggregate{}; }
+};
+
+static_assert(std::is_trivially_copyable<SweepAggregate>::value, "SweepAggregate is sent over the socket byte-for-byte");
+
+#endif
@@ -0,0 +1,734 @@
+#include "sweep_coordinator.h"
+#include "arena.h"
+#include "telemetry.h"
+#include <json/json.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr double STANDARD_GRAVITY = 9.80665;   // m/s², Isp -> exhaust velocity
+constexpr uint32_t FRAME_MAGIC = 0x53574550;   // "SWEP"
+constexpr uint32_t PROTOCOL_VERSION = 1;
+constexpr int SEND_TIMEOUT_MS = 1000;          // coordinator: longest wait for a worker to drain its socket
+
+
+// ===== Wire protocol: [FrameHeader][fixed-size body], both ends are the same build =====
+enum class MessageType : uint32_t { HELLO = 1, SPEC, SHARD, PROGRESS, SHUTDOWN };
+
+struct FrameHeader {
+    uint32_t magic;
+    MessageType type;
+    uint64_t length;
+};
+
+// Worker -> coordinator on connect; the sizes catch a worker built from different sources
+struct HelloMessage {
+    uint32_t worker;
+    uint32_t protocol;
+    uint64_t specBytes;
+    uint64_t progressBytes;
+};
+
+struct ShardMessage {
+    uint64_t shard;
+    uint64_t begin, end;        // runs [begin, end)
+    uint32_t reportEveryRun;    // set after the shard has crashed a worker once: pins down the bad run
+};
+
+// Partial aggregate for runs [previous covered, covered) of a shard
+struct ProgressMessage {
+    uint64_t shard;
+    uint64_t covered;
+    SweepAggregate partial;
+};
+
+
+bool writeAll(int fd, const void* data, std::size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t sent = ::send(fd, bytes, size, 0);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            // Non-blocking (coordinator) socket with a full buffer: give the worker a bounded time to drain it
+            pollfd writable{fd, POLLOUT, 0};
+            if (::poll(&writable, 1, SEND_TIMEOUT_MS) > 0) continue;
+            return false;
+        }
+        if (sent <= 0) return false;
+        bytes += sent;
+        size -= static_cast<std::size_t>(sent);
+    }
+    return true;
+}
+
+bool readAll(int fd, void* data, std::size_t size) {
+    char* bytes = static_cast<char*>(data);
+    while (size > 0) {
+        ssize_t got = ::recv(fd, bytes, size, 0);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;   // peer gone
+        bytes += got;
+        size -= static_cast<std::size_t>(got);
+    }
+    return true;
+}
+
+bool sendMessage(int fd, MessageType type, const void* body = nullptr, std::size_t length = 0) {
+    FrameHeader header{FRAME_MAGIC, type, length};
+    return writeAll(fd, &header, sizeof(header)) && (length == 0 || writeAll(fd, body, length));
+}
+
+template<typename T>
+bool sendMessage(int fd, MessageType type, const T& body) {
+    return sendMessage(fd, type, &body, sizeof(T));
+}
+
+bool receiveHeader(int fd, FrameHeader& header) {
+    return readAll(fd, &header, sizeof(header)) && header.magic == FRAME_MAGIC;
+}
+
+template<typename T>
+bool receiveBody(int fd, const FrameHeader& header, T& body) {
+    return header.length == sizeof(T) && readAll(fd, &body, sizeof(T));
+}
+
+
+/**
+ * @brief Non-blocking receive of one frame at a time (coordinator side)
+ * - read() takes whatever the socket has and keeps a partial frame in its own buffer, so a worker that
+ *   stalls mid-message never blocks the event loop; the buffer fits the largest message once.
+ */
+class FrameReader {
+public:
+    enum class Status { PARTIAL, FRAME, CLOSED };
+
+    FrameReader() : buffer(new char[sizeof(FrameHeader) + MAX_BODY]) {}
+
+    Status read(int fd) {
+        while (true) {
+            std::size_t frame = sizeof(FrameHeader) + (received >= sizeof(FrameHeader) ? header().length : 0);
+            if (received == frame && received >= sizeof(FrameHeader)) return Status::FRAME;
+
+            ssize_t got = ::recv(fd, buffer.get() + received, frame - received, 0);
+            if (got < 0 && errno == EINTR) continue;
+            if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return Status::PARTIAL;
+            if (got <= 0) return Status::CLOSED;   // peer gone
+            received += static_cast<std::size_t>(got);
+
+            if (received == sizeof(FrameHeader) && (header().magic != FRAME_MAGIC || header().length > MAX_BODY)) {
+                return Status::CLOSED;   // not our protocol - drop the connection
+            }
+        }
+    }
+
+    FrameHeader header() const {
+        FrameHeader h;
+        std::memcpy(&h, buffer.get(), sizeof(h));
+        return h;
+    }
+
+    template<typename T>
+    bool body(T& out) const {
+        if (header().length != sizeof(T)) return false;
+        std::memcpy(static_cast<void*>(&out), buffer.get() + sizeof(FrameHeader), sizeof(T));
+        return true;
+    }
+
+    void reset() { received = 0; }
+
+private:
+    static constexpr std::size_t MAX_BODY = std::max(sizeof(HelloMessage), sizeof(ProgressMessage));
+    std::unique_ptr<char[]> buffer;
+    std::size_t received = 0;
+};
+
+
+void closeOnExec(int fd) {
+    // Workers must not inherit the listener or each other's connections, or a dead worker's socket never reports EOF
+    ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+}
+
+void setNonBlocking(int fd) {
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+bool readJson(const std::string& path, Json::Value& root) {
+    std::ifstream file(path);
+    if (!file.is_open() || !Json::parseFromStream(Json::CharReaderBuilder(), file, &root, nullptr)) {
+        std::cerr << "[SWEEP ERROR] Could not read " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+std::string describeExit(int status) {
+    if (WIFEXITED(status)) return "exit status " + std::to_string(WEXITSTATUS(status));
+    if (WIFSIGNALED(status)) return "signal " + std::to_string(WTERMSIG(status));
+    return "unknown status";
+}
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+}  // namespace
+
+
+
+/**
+==========================================
+    Parameter Space
+==========================================
+*/
+bool SweepSpec::load(const std::string& configPath, const std::string& rocketSpecsPath, const std::string& weatherPath) {
+    if (!base.loadRocketSpecs(rocketSpecsPath)) return false;
+    base.loadWeather(weatherPath);   // optional: still air without it
+
+    Json::Value config;
+    if (!readJson(configPath, config)) return false;
+    const Json::Value& sweep = config["sweep"];
+
+    // [low, high, count] from the sweep block, otherwise a band around the base vehicle
+    auto axis = [&sweep](const char* key, double low, double high, uint32_t count) {
+        SweepAxis result{low, high, count};
+        const Json::Value& value = sweep[key];
+        if (value.isArray() && value.size() == 3) {
+            result.low = value[0].asDouble();
+            result.high = value[1].asDouble();
+            result.count = static_cast<uint32_t>(std::max(value[2].asInt(), 1));
+        }
+        return result;
+    };
+    mass = axis("mass_kg", base.mass * 0.9, base.mass * 1.1, 5);
+    thrust = axis("thrust_N", base.thrust * 0.9, base.thrust * 1.1, 5);
+    isp = axis("isp_s", base.isp * 0.95, base.isp * 1.05, 3);
+    wind = axis("wind_mps", 0.0, std::max(2.0 * base.windSpeed, 10.0), 4);
+    base.duration = sweep.get("duration_s", base.duration).asDouble();
+
+    auto addSite = [this](const std::string& name, double latitude) {
+        if (siteCount == MAX_SITES) {
+            std::cerr << "[SWEEP WARNING] More than " << MAX_SITES << " launch sites - ignoring " << name << "\n";
+            return;
+        }
+        LaunchSite& site = sites[siteCount++];
+        std::strncpy(site.name, name.c_str(), sizeof(site.name) - 1);
+        site.latitude = latitude;
+    };
+    siteCount = 0;
+    addSite("Configured Site", config.get("latitude", 28.5721).asDouble());
+    for (const Json::Value& site : sweep["launch_sites"]) {
+        addSite(site.get("name", "Unnamed").asString(), site.get("latitude", 0.0).asDouble());
+    }
+    return true;
+}
+
+
+uint64_t SweepSpec::totalRuns() const {
+    return static_cast<uint64_t>(mass.count) * thrust.count * isp.count * wind.count * siteCount;
+}
+
+
+// Mixed-radix decode of the run index: mass, thrust, Isp, wind, site
+MissionConfig SweepSpec::configAt(uint64_t run) const {
+    uint64_t rest = run;
+    auto next = [&rest](uint32_t count) {
+        uint32_t index = static_cast<uint32_t>(rest % count);
+        rest /= count;
+        return index;
+    };
+
+    MissionConfig config = base;
+    config.mass = mass.at(next(mass.count));
+    config.thrust = thrust.at(next(thrust.count));
+    config.isp = isp.at(next(isp.count));
+    config.windSpeed = wind.at(next(wind.count));
+    config.setLaunchLatitude(sites[next(siteCount)].latitude);
+
+    config.burnRate = config.thrust / (config.isp * STANDARD_GRAVITY);   // mass flow for the thrust at this Isp
+    config.turbulenceSeed = config.windSpeed > 0.0 ? run + 1 : 0;     // tied to the run, not the worker
+    return config;
+}
+
+
+const LaunchSite& SweepSpec::siteOf(uint64_t run) const {
+    return sites[(run / (static_cast<uint64_t>(mass.count) * thrust.count * isp.count * wind.count)) % siteCount];
+}
+
+
+
+SweepCoordinator::SweepCoordinator(const SweepSpec& spec, std::string executable)
+: spec(spec), executable(std::move(executable)) {}
+
+
+
+/**
+==========================================
+    Coordinator
+==========================================
+*/
+SweepCoordinator::Result SweepCoordinator::run(unsigned workers, uint64_t shardRuns) {
+    struct Shard {
+        uint64_t id, begin, end;
+        uint64_t next;              // first run not yet merged
+        bool careful = false;       // crashed a worker before: report after every run
+    };
+    struct WorkerSlot {
+        pid_t pid = -1;
+        int fd = -1;
+        bool busy = false;
+        bool retired = false;
+        Shard shard{};
+        int restarts = 0;
+        Clock::time_point lastHeard;
+        FrameReader inbox;          // partial PROGRESS frame
+    };
+    struct Connection {             // accepted, HELLO not complete yet
+        int fd;
+        Clock::time_point accepted;
+        FrameReader inbox;
+    };
+
+    Result result;
+    const uint64_t total = spec.totalRuns();
+    if (total == 0) {
+        std::cerr << "[SWEEP ERROR] Empty parameter space.\n";
+        return result;
+    }
+
+    if (workers == 0) workers = std::max(1u, std::thread::hardware_concurrency());
+    workers = static_cast<unsigned>(std::min<uint64_t>(workers, total));
+    if (shardRuns == 0) shardRuns = std::max<uint64_t>(1, total / (workers * 8ull));
+    result.workers = workers;
+
+    std::deque<Shard> queue;
+    for (uint64_t begin = 0; begin < total; begin += shardRuns) {
+        queue.push_back(Shard{result.shards++, begin, std::min(begin + shardRuns, total), begin});
+    }
+
+
+    // ===== Listener =====
+    std::signal(SIGPIPE, SIG_IGN);   // a worker dying mid-send is handled as a crash, not a signal
+    const std::string socketPath = "/tmp/openspace_sweep_" + std::to_string(::getpid()) + ".sock";
+    int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+    ::unlink(socketPath.c_str());
+    if (listener < 0 || ::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0
+        || ::listen(listener, static_cast<int>(workers)) < 0) {
+        std::cerr << "[SWEEP ERROR] Could not listen on " << socketPath << "\n";
+        if (listener >= 0) ::close(listener);
+        return result;
+    }
+    closeOnExec(listener);
+    setNonBlocking(listener);
+
+
+    std::vector<WorkerSlot> slots(workers);
+    std::vector<Connection> connecting;
+    std::vector<uint64_t> failedRuns;
+    auto progress = std::make_unique<ProgressMessage>();   // ~40 KB, reused for every message
+    const auto start = Clock::now();
+
+    auto spawn = [&](uint32_t id) {
+        WorkerSlot& slot = slots[id];
+        pid_t pid = ::fork();
+        if (pid == 0) {
+            std::string idText = std::to_string(id);
+            ::execl(executable.c_str(), executable.c_str(), "--sweep-worker", socketPath.c_str(), idText.c_str(), nullptr);
+            ::_exit(127);   // exec failed
+        }
+        if (pid < 0) {
+            std::cerr << "[SWEEP ERROR] fork failed for worker " << id << "\n";
+            slot.retired = true;
+            return;
+        }
+        slot.pid = pid;
+        slot.fd = -1;
+        slot.busy = false;
+        slot.inbox.reset();
+        slot.lastHeard = Clock::now();   // also the connect deadline
+    };
+
+    auto assign = [&](WorkerSlot& slot) {
+        if (queue.empty() || slot.fd < 0) return;
+        slot.shard = queue.front();
+        queue.pop_front();
+        ShardMessage message{slot.shard.id, slot.shard.next, slot.shard.end, slot.shard.careful ? 1u : 0u};
+        slot.busy = true;
+        slot.lastHeard = Clock::now();
+        sendMessage(slot.fd, MessageType::SHARD, message);   // a failed send shows up as EOF on the next poll
+    };
+
+    // Reap the worker, requeue the unmerged tail of its shard and restart it
+    // killedFor: why a live worker is killed first (nullptr = it already closed its end, waitpid will not block)
+    auto crashed = [&](uint32_t id, const char* killedFor) {
+        WorkerSlot& slot = slots[id];
+        if (killedFor) ::kill(slot.pid, SIGKILL);
+        if (slot.fd >= 0) ::close(slot.fd);
+        int status = 0;
+        ::waitpid(slot.pid, &status, 0);
+
+        std::cerr << "[SWEEP WARNING] Worker " << id << " (pid " << slot.pid << ") "
+                  << (killedFor ? std::string(killedFor) : "died with " + describeExit(status));
+        if (slot.busy) {
+            Shard shard = slot.shard;
+            std::cerr << " in shard " << shard.id << " after run " << shard.next;
+            if (shard.careful) {
+                // Every earlier run of this attempt was reported, so `next` is the run that crashed
+                std::cerr << " - run " << shard.next << " recorded as failed";
+                failedRuns.push_back(shard.next);
+                result.aggregate.failed++;
+                shard.next++;
+            }
+            shard.careful = true;
+            if (shard.next < shard.end) queue.push_front(shard);
+        }
+        std::cerr << "\n";
+
+        slot.pid = -1;
+        slot.fd = -1;
+        slot.busy = false;
+        if (slot.restarts++ < MAX_RESTARTS) {
+            result.restarts++;
+            spawn(id);
+        } else {
+            std::cerr << "[SWEEP ERROR] Worker " << id << " exceeded " << MAX_RESTARTS << " restarts - retired\n";
+            slot.retired = true;
+        }
+    };
+
+    for (uint32_t id = 0; id < workers; ++id) {
+        spawn(id);
+    }
+
+
+    // ===== Event loop =====
+    std::vector<pollfd> fds;
+    std::vector<uint32_t> owners;   // worker slot of fds[1 .. workers connected]; connecting sockets follow
+    while (true) {
+        bool working = !queue.empty();
+        bool alive = false;
+        for (const WorkerSlot& slot : slots) {
+            working |= slot.busy;
+            alive |= !slot.retired;
+        }
+        if (!working) {
+            result.complete = true;
+            break;
+        }
+        if (!alive) {
+            std::cerr << "[SWEEP ERROR] No workers left - sweep incomplete.\n";
+            break;
+        }
+
+        fds.assign(1, pollfd{listener, POLLIN, 0});
+        owners.assign(1, 0);
+        for (uint32_t id = 0; id < workers; ++id) {
+            if (slots[id].fd >= 0) {
+                fds.push_back(pollfd{slots[id].fd, POLLIN, 0});
+                owners.push_back(id);
+            }
+        }
+        const std::size_t firstConnecting = fds.size();
+        for (const Connection& connection : connecting) {
+            fds.push_back(pollfd{connection.fd, POLLIN, 0});
+        }
+        if (::poll(fds.data(), fds.size(), 200) < 0 && errno != EINTR) {
+            std::cerr << "[SWEEP ERROR] poll failed.\n";
+            break;
+        }
+
+        // Partial aggregates (or EOF from a dead worker); a frame still in flight just waits for the next poll
+        for (std::size_t i = 1; i < firstConnecting; ++i) {
+            if (!fds[i].revents) continue;
+            uint32_t id = owners[i];
+            WorkerSlot& slot = slots[id];
+
+            FrameReader::Status status = slot.inbox.read(slot.fd);
+            if (status == FrameReader::Status::PARTIAL) continue;
+            slot.inbox.reset();
+            if (status == FrameReader::Status::CLOSED || slot.inbox.header().type != MessageType::PROGRESS
+                || !slot.inbox.body(*progress) || !slot.busy
+                || progress->shard != slot.shard.id || progress->covered <= slot.shard.next
+                || progress->covered > slot.shard.end) {
+                crashed(id, status == FrameReader::Status::CLOSED ? nullptr : "broke the protocol");
+                continue;
+            }
+
+            result.aggregate.merge(progress->partial);
+            slot.shard.next = progress->covered;
+            slot.lastHeard = Clock::now();
+            if (slot.shard.next == slot.shard.end) {
+                slot.busy = false;
+                assign(slot);
+            }
+        }
+
+        // Handshakes in progress: HELLO -> SPEC -> first shard
+        for (std::size_t i = firstConnecting; i < fds.size(); ++i) {
+            Connection& connection = connecting[i - firstConnecting];
+            FrameReader::Status status = FrameReader::Status::PARTIAL;
+            if (fds[i].revents) status = connection.inbox.read(connection.fd);
+
+            if (status == FrameReader::Status::PARTIAL) {
+                if (secondsSince(connection.accepted) > HEARTBEAT_TIMEOUT) {
+                    std::cerr << "[SWEEP WARNING] Dropped a worker connection (handshake timed out).\n";
+                    ::close(connection.fd);
+                    connection.fd = -1;
+                }
+                continue;
+            }
+
+            HelloMessage hello{};
+            if (status == FrameReader::Status::CLOSED || connection.inbox.header().type != MessageType::HELLO
+                || !connection.inbox.body(hello)
+                || hello.protocol != PROTOCOL_VERSION || hello.specBytes != sizeof(SweepSpec)
+                || hello.progressBytes != sizeof(ProgressMessage) || hello.worker >= workers
+                || slots[hello.worker].pid < 0 || slots[hello.worker].fd >= 0) {
+                std::cerr << "[SWEEP WARNING] Rejected a worker connection (bad handshake).\n";
+                ::close(connection.fd);
+            } else {
+                WorkerSlot& slot = slots[hello.worker];
+                slot.fd = connection.fd;
+                slot.inbox.reset();
+                slot.lastHeard = Clock::now();
+                sendMessage(slot.fd, MessageType::SPEC, spec);
+                assign(slot);
+            }
+            connection.fd = -1;
+        }
+        connecting.erase(std::remove_if(connecting.begin(), connecting.end(),
+                                        [](const Connection& connection) { return connection.fd < 0; }),
+                         connecting.end());
+
+        // New worker connections (handshake read by the loop above from the next poll on)
+        if (fds[0].revents & POLLIN) {
+            int fd = ::accept(listener, nullptr, nullptr);
+            if (fd >= 0) {
+                closeOnExec(fd);
+                setNonBlocking(fd);
+                connecting.push_back(Connection{fd, Clock::now(), FrameReader{}});
+            }
+        }
+
+        // Workers that exited before connecting, or went silent
+        for (uint32_t id = 0; id < workers; ++id) {
+            WorkerSlot& slot = slots[id];
+            if (slot.pid < 0) continue;
+            int status = 0;
+            if (slot.fd < 0 && ::waitpid(slot.pid, &status, WNOHANG) == slot.pid) {
+                std::cerr << "[SWEEP WARNING] Worker " << id << " exited before connecting (" << describeExit(status) << ")\n";
+                slot.pid = -1;
+                if (slot.restarts++ < MAX_RESTARTS) {
+                    result.restarts++;
+                    spawn(id);
+                } else {
+                    slot.retired = true;
+                }
+            } else if ((slot.busy || slot.fd < 0) && secondsSince(slot.lastHeard) > HEARTBEAT_TIMEOUT) {
+                crashed(id, "stopped responding");
+            }
+        }
+    }
+
+
+    // ===== Shutdown =====
+    for (const Connection& connection : connecting) {
+        ::close(connection.fd);
+    }
+    for (WorkerSlot& slot : slots) {
+        if (slot.fd >= 0) {
+            sendMessage(slot.fd, MessageType::SHUTDOWN);
+            ::close(slot.fd);
+        }
+        if (slot.pid > 0) {
+            if (!result.complete) ::kill(slot.pid, SIGKILL);
+            ::waitpid(slot.pid, nullptr, 0);
+        }
+    }
+    ::close(listener);
+    ::unlink(socketPath.c_str());
+
+    std::sort(failedRuns.begin(), failedRuns.end());
+    for (uint64_t run : failedRuns) {
+        std::cerr << "[SWEEP WARNING] Failed run " << run << " (site " << spec.siteOf(run).name << ")\n";
+    }
+    result.seconds = secondsSince(start);
+    return result;
+}
+
+
+
+/**
+==========================================
+    Worker Process (--sweep-worker)
+==========================================
+*/
+int SweepCoordinator::workerMain(const std::string& socketPath, uint32_t workerId) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        std::cerr << "[SWEEP WORKER ERROR] Could not connect to " << socketPath << "\n";
+        return 1;
+    }
+
+    HelloMessage hello{workerId, PROTOCOL_VERSION, sizeof(SweepSpec), sizeof(ProgressMessage)};
+    FrameHeader header;
+    SweepSpec spec;
+    if (!sendMessage(fd, MessageType::HELLO, hello) || !receiveHeader(fd, header)
+        || header.type != MessageType::SPEC || !receiveBody(fd, header, spec)) {
+        std::cerr << "[SWEEP WORKER ERROR] Handshake with the coordinator failed.\n";
+        ::close(fd);
+        return 1;
+    }
+
+    BumpArena arena(BatchRunner::WORKER_ARENA_BYTES);
+    auto progress = std::make_unique<ProgressMessage>();
+    ShardMessage shard;
+
+    while (receiveHeader(fd, header) && header.type == MessageType::SHARD && receiveBody(fd, header, shard)) {
+        progress->shard = shard.shard;
+        progress->partial.clear();
+        auto chunkStart = Clock::now();
+
+        for (uint64_t run = shard.begin; run < shard.end; ++run) {
+            if (static_cast<int64_t>(run) == spec.faultRun) {
+                std::cerr << "[SWEEP WORKER] Injected fault at run " << run << "\n";
+                std::exit(1);
+            }
+
+            progress->partial.add(run, BatchRunner::simulate(spec.configAt(run), arena));
+            arena.reset();
+
+            if (run + 1 == shard.end || shard.reportEveryRun || secondsSince(chunkStart) >= PROGRESS_INTERVAL) {
+                progress->covered = run + 1;
+                progress->partial.cpuSeconds = secondsSince(chunkStart);
+                if (!sendMessage(fd, MessageType::PROGRESS, *progress)) {
+                    ::close(fd);
+                    return 1;   // coordinator gone
+                }
+                progress->partial.clear();
+                chunkStart = Clock::now();
+            }
+        }
+    }
+
+    ::close(fd);
+    return 0;
+}
+
+
+
+/**
+==========================================
+    Report
+==========================================
+*/
+void SweepCoordinator::printReport(const Result& result) const {
+    const SweepAggregate& aggregate = result.aggregate;
+    Telemetry names;
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "        Parameter Sweep Results         " << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::fixed << std::setprecision(2)
+              << "[SWEEP] Runs: " << aggregate.runs << " / " << spec.totalRuns()
+              << " | Failed: " << aggregate.failed
+              << " | Workers: " << result.workers << " | Shards: " << result.shards
+              << " | Restarts: " << result.restarts << "\n"
+              << "[SWEEP] Wall: " << result.seconds << " s | " << aggregate.runs / std::max(result.seconds, 1e-9)
+              << " runs/s | Worker time: " << aggregate.cpuSeconds << " s"
+              << (result.complete ? "" : " | INCOMPLETE") << "\n";
+
+    std::cout << "[SWEEP] " << std::left << std::setw(14) << "Metric" << std::right
+              << std::setw(12) << "Mean" << std::setw(12) << "Min" << std::setw(12) << "p50"
+              << std::setw(12) << "p90" << std::setw(12) << "p99" << std::setw(12) << "Max" << "   Runs\n";
+    for (int m = 0; m < METRIC_COUNT; ++m) {
+        const MetricAggregate& metric = aggregate.metrics[m];
+        std::cout << "[SWEEP] " << std::left << std::setw(14) << metricName(m) << std::right
+                  << std::setw(12) << metric.mean() << std::setw(12) << metric.min
+                  << std::setw(12) << metric.quantile(0.5) << std::setw(12) << metric.quantile(0.9)
+                  << std::setw(12) << metric.quantile(0.99) << std::setw(12) << metric.max
+                  << "   " << metric.count << " (" << metricUnit(m) << ")\n";
+    }
+
+    std::cout << "[SWEEP] Final phase:";
+    for (std::size_t p = 0; p < SweepAggregate::PHASES; ++p) {
+        if (aggregate.finalPhase[p]) {
+            std::cout << " " << names.phaseToString(static_cast<MissionPhase>(p)) << " " << aggregate.finalPhase[p];
+        }
+    }
+    std::cout << "\n";
+
+    const MetricAggregate& altitude = aggregate.metrics[MAX_ALTITUDE];
+    if (altitude.count) {
+        MissionConfig best = spec.configAt(altitude.maxRun);
+        std::cout << "[SWEEP] Highest altitude: run " << altitude.maxRun
+                  << " | Mass: " << best.mass << " kg | Thrust: " << best.thrust << " N | Isp: " << best.isp
+                  << " s | Wind: " << best.windSpeed << " m/s | Site: " << spec.siteOf(altitude.maxRun).name << "\n";
+
+        std::cout << "[SWEEP] Max altitude histogram (log bins):\n";
+        const LogHistogram& histogram = altitude.histogram;
+        uint32_t peak = *std::max_element(histogram.bins.begin(), histogram.bins.end());
+        for (std::size_t b = 0; b < LogHistogram::BINS; ++b) {
+            if (!histogram.bins[b]) continue;
+            std::cout << "[SWEEP]   >= " << std::setw(12) << LogHistogram::lowerEdge(b) << " m  "
+                      << std::string(1 + 40 * histogram.bins[b] / std::max(peak, 1u), '#') << " " << histogram.bins[b] << "\n";
+        }
+    }
+    std::cout << std::defaultfloat;
+}
+
+
+
+/**
+==========================================
+    Worker Scaling Benchmark (--bench-sweep)
+==========================================
+*/
+void SweepCoordinator::benchmark() {
+    const unsigned maxWorkers = std::max(1u, std::thread::hardware_concurrency());
+    double baseline = 0.0;
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "      Sweep Worker Process Scaling      " << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "[BENCH] " << spec.totalRuns() << " runs x " << spec.base.duration << " s per sweep\n";
+
+    for (unsigned workers = 1;; workers = std::min(workers * 2, maxWorkers)) {
+        Result result = run(workers);
+        double rate = result.aggregate.runs / std::max(result.seconds, 1e-9);
+        if (workers == 1) baseline = rate;
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << "[BENCH] Workers: " << std::setw(3) << workers
+                  << " | " << std::setw(9) << rate << " runs/s"
+                  << " | Speedup: " << std::setw(5) << rate / baseline << "x"
+                  << " | Efficiency: " << std::setw(6) << 100.0 * rate / (baseline * workers) << " %"
+                  << " | Restarts: " << result.restarts << "\n" << std::defaultfloat;
+
+        if (workers == maxWorkers) break;
+    }
+}
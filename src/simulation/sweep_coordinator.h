@@ -0,0 +1,112 @@
+#ifndef SWEEP_COORDINATOR_H
+#define SWEEP_COORDINATOR_H
+
+#include "batch_runner.h"
+#include "sweep_aggregate.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+
+
+// One swept parameter: `count` evenly spaced values from low to high (count 1 = low only)
+struct SweepAxis {
+    double low = 0.0;
+    double high = 0.0;
+    uint32_t count = 1;
+
+    double at(uint32_t index) const {
+        return count > 1 ? low + (high - low) * index / (count - 1) : low;
+    }
+};
+
+struct LaunchSite {
+    char name[32] = {};
+    double latitude = 0.0;      // deg (sets surface gravity)
+};
+
+
+/**
+ * @brief The whole parameter space; run i maps to one point of the grid (mass varies fastest)
+ * - Base vehicle from rocket_specs.json, base wind from weather_conditions.json.
+ * - Axes and extra launch sites from the "sweep" block of program_configuration.json; the configured
+ *   site ("latitude") is always the first site. Missing axes default to a band around the base vehicle.
+ * - Trivially copyable: the coordinator sends it to every worker as-is.
+ */
+struct SweepSpec {
+    static constexpr std::size_t MAX_SITES = 8;
+
+    MissionConfig base;
+    SweepAxis mass, thrust, isp, wind;
+    std::array<LaunchSite, MAX_SITES> sites{};
+    uint32_t siteCount = 0;
+    int64_t faultRun = -1;      // test hook: the worker handling this run exits (as a CDH exit(1) would)
+
+    bool load(const std::string& configPath, const std::string& rocketSpecsPath, const std::string& weatherPath);
+    uint64_t totalRuns() const;
+    MissionConfig configAt(uint64_t run) const;
+    const LaunchSite& siteOf(uint64_t run) const;
+};
+
+static_assert(std::is_trivially_copyable<SweepSpec>::value, "SweepSpec is sent over the socket byte-for-byte");
+
+
+
+/**
+==========================================
+    Multi-Process Sweep Coordinator
+==========================================
+
+- Splits the sweep into shards (contiguous run ranges) and hands them to worker processes over a
+  Unix domain socket; each worker is this executable re-run with --sweep-worker.
+- Workers stream partial aggregates as they go (every PROGRESS_INTERVAL or at the end of a shard);
+  each message says how far into the shard it covers, so the coordinator always knows exactly which
+  runs are merged. Results never depend on which worker ran what.
+- The coordinator never blocks on a worker: its sockets are non-blocking and every connection keeps its
+  own partial-frame buffer, so a worker that stalls mid-message only delays itself.
+- A worker that dies (exit, signal) or goes silent for HEARTBEAT_TIMEOUT is reaped and restarted; the
+  unmerged tail of its shard goes back to the front of the queue. A run that takes down a worker twice
+  is recorded as failed and skipped, so one poisoned configuration cannot stall the sweep.
+- Remote hosts: the worker is given everything (spec, shards) over its connection and returns
+  everything over it, with nothing shared through the file system. Forking locally and connecting
+  over AF_UNIX is the stand-in; a remote launcher only swaps the spawn step and the socket family.
+*/
+class SweepCoordinator {
+public:
+    static constexpr double PROGRESS_INTERVAL = 0.25;     // s between partial aggregates from a worker
+    static constexpr double HEARTBEAT_TIMEOUT = 30.0;     // s of silence before a busy worker is killed
+    static constexpr int MAX_RESTARTS = 5;                // per worker slot
+
+    struct Result {
+        SweepAggregate aggregate;
+        unsigned workers = 0;
+        uint64_t shards = 0;
+        int restarts = 0;
+        double seconds = 0.0;
+        bool complete = false;      // every run merged or recorded as failed
+    };
+
+    SweepCoordinator(const SweepSpec& spec, std::string executable);
+
+    /**
+     * @brief Runs the whole sweep
+     * @param workers Worker processes (0 = hardware concurrency)
+     * @param shardRuns Runs per shard (0 = about 8 shards per worker)
+     */
+    Result run(unsigned workers = 0, uint64_t shardRuns = 0);
+
+    void printReport(const Result& result) const;
+
+    // Throughput at 1, 2, 4 ... hardware-concurrency worker processes
+    void benchmark();
+
+    // Worker process entry point (--sweep-worker <socket> <id>); returns the process exit code
+    static int workerMain(const std::string& socketPath, uint32_t workerId);
+
+private:
+    SweepSpec spec;
+    std::string executable;     // re-executed for every worker
+};
+
+#endif
@@ -0,0 +1,180 @@
+#include "downsampler.h"
+#include <algorithm>
+#include <cmath>
+
+
+
+DownsamplePyramid::DownsamplePyramid() {
+    for (auto& level : levels) {
+        level.ring.reserve(64);  // rings grow on demand up to LEVEL_CAPACITY
+    }
+}
+
+
+
+/**
+==========================================
+    Incremental Update
+==========================================
+
+A raw sample lands on level 0 and is folded into level 1's pending bucket; whenever a pending
+bucket has FACTOR children it is committed and folded one level up, and so on.
+*/
+void DownsamplePyramid::append(double time, double value) {
+    push(0, SeriesBucket{time, time, value, value, value, 1});
+}
+
+
+void DownsamplePyramid::push(std::size_t index, const SeriesBucket& bucket) {
+    Level& level = levels[index];
+
+    if (level.size < LEVEL_CAPACITY) {
+        if (level.ring.size() < LEVEL_CAPACITY) {
+            level.ring.push_back(bucket);
+        } else {
+            level.ring[(level.head + level.size) % LEVEL_CAPACITY] = bucket;
+        }
+        level.size++;
+    } else {
+        level.ring[level.head] = bucket;   // overwrite the oldest
+        level.head = (level.head + 1) % LEVEL_CAPACITY;
+    }
+
+    if (index + 1 >= LEVELS) return;
+
+    Level& parent = levels[index + 1];
+    if (parent.pendingChildren == 0) {
+        parent.pending = bucket;
+    } else {
+        parent.pending.t1 = bucket.t1;
+        parent.pending.min = std::min(parent.pending.min, bucket.min);
+        parent.pending.max = std::max(parent.pending.max, bucket.max);
+        parent.pending.sum += bucket.sum;
+        parent.pending.count += bucket.count;
+    }
+
+    if (++parent.pendingChildren == FACTOR) {
+        parent.pendingChildren = 0;
+        push(index + 1, parent.pending);
+    }
+}
+
+
+const SeriesBucket& DownsamplePyramid::at(const Level& level, std::size_t i) const {
+    return level.ring[(level.head + i) % level.ring.size()];
+}
+
+
+
+/**
+==========================================
+    Range Query - Finest Level That Fits
+==========================================
+
+A level qualifies if it still holds data back to `from` (or never dropped any) and has at most
+maxPoints buckets in the range. The still-filling pending bucket is appended so the newest
+samples show up on every level.
+*/
+std::vector<SeriesBucket> DownsamplePyramid::query(double from, double to, std::size_t maxPoints, std::size_t* levelUsed) const {
+    std::vector<SeriesBucket> result;
+    if (maxPoints == 0) return result;
+
+    for (std::size_t k = 0; k < LEVELS; ++k) {
+        const Level& level = levels[k];
+        bool last = (k + 1 == LEVELS);
+
+        bool covers = level.size < LEVEL_CAPACITY || (level.size > 0 && at(level, 0).t0 <= from);
+
+        // Binary search for the first bucket ending at or after `from` (ring is time-ordered)
+        std::size_t lo = 0, hi = level.size;
+        while (lo < hi) {
+            std::size_t mid = (lo + hi) / 2;
+            if (at(level, mid).t1 < from) lo = mid + 1; else hi = mid;
+        }
+        std::size_t first = lo;
+
+        lo = first; hi = level.size;
+        while (lo < hi) {
+            std::size_t mid = (lo + hi) / 2;
+            if (at(level, mid).t0 <= to) lo = mid + 1; else hi = mid;
+        }
+        std::size_t end = lo;
+
+        bool withPending = k > 0 && level.pendingChildren > 0 && level.pending.t0 <= to && level.pending.t1 >= from;
+        std::size_t count = (end - first) + (withPending ? 1 : 0);
+
+        if ((covers && count <= maxPoints) || last) {
+            // Coarsest level as a last resort: keep only the newest maxPoints buckets
+            if (count > maxPoints) first = end - std::min(end - first, maxPoints - (withPending ? 1 : 0));
+
+            result.reserve(end - first + 1);
+            for (std::size_t i = first; i < end; ++i) {
+                result.push_back(at(level, i));
+            }
+            if (withPending) result.push_back(level.pending);
+            if (levelUsed) *levelUsed = k;
+            return result;
+        }
+    }
+    return result;
+}
+
+
+
+/**
+==========================================
+    Largest-Triangle-Three-Buckets (LTTB)
+==========================================
+
+Works on a level roughly FACTOR times finer than maxPoints so visually important extremes survive.
+Always keeps the first and last point; from every inner bucket keeps the point forming the largest
+triangle with the previously kept point and the average of the next bucket.
+*/
+std::vector<SeriesBucket> DownsamplePyramid::queryLttb(double from, double to, std::size_t maxPoints) const {
+    std::vector<SeriesBucket> source = query(from, to, maxPoints * FACTOR);
+    if (maxPoints < 3 || source.size() <= maxPoints) {
+        return source;
+    }
+
+    std::vector<SeriesBucket> sampled;
+    sampled.reserve(maxPoints);
+    sampled.push_back(source.front());
+
+    const double every = static_cast<double>(source.size() - 2) / (maxPoints - 2);
+    std::size_t kept = 0;
+
+    for (std::size_t i = 0; i < maxPoints - 2; ++i) {
+        // Average of the next bucket
+        std::size_t nextStart = static_cast<std::size_t>((i + 1) * every) + 1;
+        std::size_t nextEnd = std::min(static_cast<std::size_t>((i + 2) * every) + 1, source.size());
+        double avgT = 0.0, avgV = 0.0;
+        for (std::size_t j = nextStart; j < nextEnd; ++j) {
+            avgT += source[j].t0;
+            avgV += source[j].mean();
+        }
+        std::size_t n = std::max<std::size_t>(nextEnd - nextStart, 1);
+        avgT /= n;
+        avgV /= n;
+
+        // Pick the point in this bucket with the largest triangle area
+        std::size_t start = static_cast<std::size_t>(i * every) + 1;
+        std::size_t end = static_cast<std::size_t>((i + 1) * every) + 1;
+        double pt = source[kept].t0, pv = source[kept].mean();
+        double bestArea = -1.0;
+        std::size_t best = start;
+
+        for (std::size_t j = start; j < end; ++j) {
+            double area = std::fabs((pt - avgT) * (source[j].mean() - pv) - (pt - source[j].t0) * (avgV - pv));
+            if (area > bestArea) {
+                bestArea = area;
+                best = j;
+            }
+        }
+
+        sampled.push_back(source[best]);
+        kept = best;
+    }
+
+    sampled.push_back(source.back());
+    return sampled;
+}
@@ -0,0 +1,64 @@
+#ifndef DOWNSAMPLER_H
+#define DOWNSAMPLER_H
+
+#include <cstddef>
+#include <vector>
+
+
+// One aggregated bucket (level 0 buckets hold a single raw sample)
+struct SeriesBucket {
+    double t0, t1;      // time span covered (s)
+    double min, max;
+    double sum;
+    std::size_t count;
+
+    double mean() const { return count ? sum / count : 0.0; }
+};
+
+
+/**
+==========================================
+    Multi-Resolution Downsampling Pyramid (one channel)
+==========================================
+
+- Level 0 holds raw samples; every bucket on level k+1 aggregates FACTOR buckets of level k.
+- Updated incrementally on append(): O(1) amortized, no rescans of history.
+- Each level is a fixed-capacity ring, so memory is bounded while coarse levels still span the whole mission.
+- query() picks the finest level that answers the requested range in at most `maxPoints` buckets;
+  queryLttb() reduces a finer level with Largest-Triangle-Three-Buckets for shape-preserving plots.
+*/
+class DownsamplePyramid {
+public:
+    static constexpr std::size_t FACTOR = 4;
+    static constexpr std::size_t LEVELS = 8;            // level 7 bucket = 4^7 = 16384 raw samples
+    static constexpr std::size_t LEVEL_CAPACITY = 4096;    // buckets retained per level
+
+private:
+    struct Level {
+        std::vector<SeriesBucket> ring;
+        std::size_t head = 0;       // index of the oldest bucket
+        std::size_t size = 0;
+        SeriesBucket pending{};     // bucket still being filled from the level below
+        std::size_t pendingChildren = 0;
+    };
+    Level levels[LEVELS];
+
+    void push(std::size_t level, const SeriesBucket& bucket);
+    const SeriesBucket& at(const Level& level, std::size_t i) const;
+
+public:
+    DownsamplePyramid();
+
+    void append(double time, double value);
+
+    /**
+     * @brief Buckets covering [from, to] at the finest level that fits in maxPoints
+     * @param levelUsed Receives the chosen level (may be nullptr)
+     */
+    std::vector<SeriesBucket> query(double from, double to, std::size_t maxPoints, std::size_t* levelUsed = nullptr) const;
+
+    // Largest-Triangle-Three-Buckets reduction to at most maxPoints points (bucket means)
+    std::vector<SeriesBucket> queryLttb(double from, double to, std::size_t maxPoints) const;
+};
+
+#endif
@@ -1,51 +1,106 @@
 #include "telemetry.h"
 #include "mission_phase.h"
+#include "telemetry_server.h"
 #include <iomanip> // for precision formatting
 #include <sstream> // for string streams
+#include <iterator>
 
 
 // Constructor that initializes the telemetry system
 Telemetry::Telemetry() noexcept {
-	currentPhase = MissionPhase::PRE_LAUNCH;
-	altitude_m = 0; // meters
-	velocity_mps = 0; // m/s
-	thrust_N = 0;
-	fuel_kg = 0; // for fuel tracking
+	latest.phase = MissionPhase::PRE_LAUNCH;
 }
 
 
 // closes the log file
 Telemetry::~Telemetry() {
-	if (logFile.is_open()) {
-		logFile.close();
+	if (frameLog.is_open()) {
+		frameLog.close();
 	}
 }
 
 
 // Update telemetry from the live flight dynamics
-void Telemetry::update(double altitude, double velocity, double fuel) {
-	altitude_m = altitude;
-    velocity_mps = velocity; // store the velocity in m/s
-	fuel_kg = fuel;
+void Telemetry::update(const TelemetryData& data) {
+	MissionPhase phase = latest.phase;
+	latest = data;
+	latest.phase = phase;
+}
+
+
+// Appends the newest sample to the frame log (packed, each channel at its schema rate unless fullFrame)
+void Telemetry::logData(bool fullFrame) {
+	if (!frameLog.is_open()) {
+		frameLog.open(FRAME_LOG_PATH, std::ios::out | std::ios::app | std::ios::binary);
+		frameEncoder.reset();   // a new file section starts with a full frame
+	}
+
+	if (frameLog.is_open()) {
+		uint8_t frame[TelemetryFrame::MAX_BYTES];
+		std::size_t size = frameEncoder.encode(latest, frame, fullFrame);
+		frameLog.write(reinterpret_cast<const char*>(frame), static_cast<std::streamsize>(size));
+		frameLog.flush();
+		framesLogged++;
+		bytesLogged += size;
+	} else {
+		std::cerr << "Error: Could not open telemetry frame log for writing\n";
+	}
 }
 
 
-// Logs telemetry data to file and console
-void Telemetry::logData() {
-    std::ofstream logFile("telemetry.log", std::ios::out | std::ios::app);
-    
+// Logs a discrete event (mode changes etc.) to the telemetry log
+void Telemetry::logEvent(const std::string& event) {
+    std::ofstream logFile(LOG_PATH, std::ios::out | std::ios::app);
+
 	if (logFile.is_open()) {
-        logFile << "Phase: " << phaseToString(currentPhase)
-                << " | Altitude: " << altitude_m << " m"
-                << " | Velocity: " << velocity_mps << " m/s"
-                << " | Fuel: " << fuel_kg << " kg"
-                << " | Thrust: " << thrust_N << " N\n";
-        logFile.close();
-		
+        logFile << "Event: " << event << " | Phase: " << phaseToString(latest.phase) << "\n";
     } else {
         std::cerr << "Error: Could not open telemetry log file for writing\n";
     }
+}
+
 
+// Hands the sample to the dashboard server (lock-free queue push, no I/O on the flight thread)
+void Telemetry::publish(double time, const TelemetryData& data) {
+	if (!server) return;
+	server->publish(DashboardSample::from(time, data));
+}
+
+
+// Frame log volume against the same samples written as raw doubles
+void Telemetry::reportLog() const {
+	if (framesLogged == 0) return;
+	const double raw = static_cast<double>(framesLogged) * TELEMETRY_CHANNEL_COUNT * sizeof(double);
+	std::cout << "[TELEMETRY] " << framesLogged << " frames, " << bytesLogged << " bytes in " << FRAME_LOG_PATH
+	          << " (" << std::fixed << std::setprecision(1) << static_cast<double>(bytesLogged) / framesLogged
+	          << " B/frame, " << raw / bytesLogged << "x smaller than raw doubles)\n" << std::defaultfloat;
+}
+
+
+// Replays a frame log: every frame updates the channels it carries, the others hold their last value
+bool Telemetry::decodeLog(const std::string& path, std::ostream& out) {
+	std::ifstream in(path, std::ios::binary);
+	if (!in.is_open()) {
+		std::cerr << "[TELEMETRY ERROR] Could not open " << path << "\n";
+		return false;
+	}
+	std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+	out << telemetryCsvHeader() << "\n";
+	TelemetryData sample{};
+	std::size_t offset = 0, frames = 0;
+	while (offset < bytes.size()) {
+		std::size_t used = TelemetryFrame::decode(reinterpret_cast<const uint8_t*>(bytes.data()) + offset, bytes.size() - offset, sample);
+		if (used == 0) {
+			std::cerr << "[TELEMETRY ERROR] Corrupt or truncated frame at byte " << offset << " of " << path << "\n";
+			return false;
+		}
+		out << formatTelemetryCsv(sample) << "\n";
+		offset += used;
+		frames++;
+	}
+	std::cerr << "[TELEMETRY] " << frames << " frames decoded from " << bytes.size() << " bytes\n";
+	return true;
 }
 
 
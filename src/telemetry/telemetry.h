@@ -2,40 +2,54 @@
 #define TELEMETRY_H
 
 #include "mission_phase.h"
+#include "telemetry_schema.h"
+#include <cstdint>
 #include <iostream>
 #include <fstream>
 #include <string>
 
 
-struct TelemetryData {
-    double altitude;
-    double velocity;
-    double fuel;
-    double thrust;
-    double deltaV;
-    double dragForce;
-};
+class TelemetryServer;
 
 
 
 class Telemetry {
+public:
+    // Plain-data copy of the telemetry state for checkpoints: the newest sample, every schema channel
+    using State = TelemetryData;
+
+    static constexpr const char* LOG_PATH = "telemetry.log";         // events (text)
+    static constexpr const char* FRAME_LOG_PATH = "telemetry.bin";   // samples (packed frames, see telemetry_schema.h)
+
 private:
-    double altitude_m;
-    double velocity_mps;
-    double thrust_N;
-    double fuel_kg;
-    MissionPhase currentPhase;
-    std::ofstream logFile;
+    TelemetryData latest{};     // newest sample; its phase is the current mission phase
+    std::ofstream frameLog;
+    TelemetryFrameEncoder frameEncoder;
+    uint64_t framesLogged = 0, bytesLogged = 0;
+    TelemetryServer* server = nullptr;   // Optional dashboard feed (not owned)
 
 public:
     Telemetry() noexcept; 
     ~Telemetry();  
 
-    void update(double altitude, double velocity, double fuel);
-    void logData();
-    void setPhase(MissionPhase phase) { currentPhase = phase; }
-    MissionPhase getPhase() const { return currentPhase; }
-    std::string phaseToString(MissionPhase phase);
+    // Stores the newest sample (the phase stays whatever setPhase() last set)
+    void update(const TelemetryData& data);
+    const TelemetryData& getLatest() const { return latest; }
+    void logData(bool fullFrame = false);   // fullFrame: every channel, regardless of its rate
+    void logEvent(const std::string& event);
+    void attachServer(TelemetryServer* dashboard) { server = dashboard; }
+    void publish(double time, const TelemetryData& data);   // Non-blocking hand-off to the dashboard
+    void setPhase(MissionPhase phase) { latest.phase = phase; }
+    MissionPhase getPhase() const { return latest.phase; }
+    static std::string phaseToString(MissionPhase phase);
+
+    // Frames logged this run and their size against the same samples as raw doubles
+    void reportLog() const;
+    // Prints a packed frame log as CSV (one row per frame, channels held between updates)
+    static bool decodeLog(const std::string& path, std::ostream& out);
+
+    State getState() const { return latest; }
+    void setState(const State& state) { latest = state; }
 };
 
 #endif
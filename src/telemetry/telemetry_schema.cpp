@@ -0,0 +1,214 @@
+#include "telemetry_schema.h"
+#include "telemetry.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+
+
+namespace {
+
+// LSB-first bit writer / reader over a byte buffer (at most 56 bits per call)
+class BitWriter {
+private:
+    uint8_t* out;
+    uint64_t pending = 0;
+    unsigned pendingBits = 0;
+    std::size_t bytes = 0;
+
+public:
+    explicit BitWriter(uint8_t* buffer) : out(buffer) {}
+
+    void write(uint64_t value, unsigned bits) {
+        pending |= (value & ((uint64_t{1} << bits) - 1)) << pendingBits;
+        pendingBits += bits;
+        while (pendingBits >= 8) {
+            out[bytes++] = static_cast<uint8_t>(pending);
+            pending >>= 8;
+            pendingBits -= 8;
+        }
+    }
+
+    std::size_t finish() {
+        if (pendingBits > 0) out[bytes++] = static_cast<uint8_t>(pending);
+        pending = 0;
+        pendingBits = 0;
+        return bytes;
+    }
+};
+
+class BitReader {
+private:
+    const uint8_t* in;
+    uint64_t pending = 0;
+    unsigned pendingBits = 0;
+    std::size_t bytes = 0;
+
+public:
+    explicit BitReader(const uint8_t* buffer) : in(buffer) {}
+
+    uint64_t read(unsigned bits) {
+        while (pendingBits < bits) {
+            pending |= uint64_t{in[bytes++]} << pendingBits;
+            pendingBits += 8;
+        }
+        uint64_t value = pending & ((uint64_t{1} << bits) - 1);
+        pending >>= bits;
+        pendingBits -= bits;
+        return value;
+    }
+};
+
+
+// Value -> fixed-point count, saturated to the channel's range
+template<typename T>
+uint64_t toCount(const TelemetryChannel& channel, const T& value) {
+    const int64_t lowest = channel.isSigned ? -(int64_t{1} << (channel.bits - 1)) : 0;
+    const int64_t highest = channel.isSigned ? (int64_t{1} << (channel.bits - 1)) - 1 : (int64_t{1} << channel.bits) - 1;
+    int64_t count;
+    if constexpr (std::is_enum_v<T>) {
+        count = static_cast<int64_t>(value);
+    } else {
+        double scaled = static_cast<double>(value) / channel.scale;
+        if (!(scaled == scaled)) scaled = 0.0;   // NaN
+        count = scaled <= static_cast<double>(lowest) ? lowest
+              : scaled >= static_cast<double>(highest) ? highest
+              : std::llround(scaled);
+    }
+    return static_cast<uint64_t>(std::clamp(count, lowest, highest));
+}
+
+template<typename T>
+T fromCount(const TelemetryChannel& channel, uint64_t raw) {
+    int64_t count = static_cast<int64_t>(raw);
+    if (channel.isSigned && (raw >> (channel.bits - 1)) & 1u) count -= int64_t{1} << channel.bits;   // sign-extend
+    if constexpr (std::is_enum_v<T>) {
+        return static_cast<T>(count);
+    } else {
+        return static_cast<T>(static_cast<double>(count) * channel.scale);
+    }
+}
+
+template<typename T>
+std::string valueText(const T& value, int precision) {
+    if constexpr (std::is_same_v<T, MissionPhase>) {
+        return Telemetry::phaseToString(value);
+    } else if constexpr (std::is_enum_v<T>) {
+        return std::to_string(static_cast<long long>(value));
+    } else {
+        std::ostringstream text;
+        text.precision(precision);
+        text << value;
+        return text.str();
+    }
+}
+
+} // namespace
+
+
+
+/**
+==========================================
+    Packed Frames
+==========================================
+*/
+std::size_t TelemetryFrame::sizeFor(uint32_t mask) {
+    std::size_t bits = 0;
+    for (std::size_t i = 0; i < TELEMETRY_CHANNEL_COUNT; ++i) {
+        if (mask & (1u << i)) bits += TELEMETRY_SCHEMA[i].bits;
+    }
+    return MASK_BYTES + (bits + 7) / 8;
+}
+
+
+std::size_t TelemetryFrame::encode(const TelemetryData& data, uint32_t mask, uint8_t* out) {
+    mask &= ALL_CHANNELS;
+    for (std::size_t i = 0; i < MASK_BYTES; ++i) out[i] = static_cast<uint8_t>(mask >> (8 * i));
+
+    BitWriter writer(out + MASK_BYTES);
+    forEachChannel(data, [&](const TelemetryChannel& channel, std::size_t index, const auto& value) {
+        if (mask & (1u << index)) writer.write(toCount(channel, value), channel.bits);
+    });
+    return MASK_BYTES + writer.finish();
+}
+
+
+std::size_t TelemetryFrame::decode(const uint8_t* in, std::size_t size, TelemetryData& data) {
+    if (size < MASK_BYTES) return 0;
+    uint32_t mask = 0;
+    for (std::size_t i = 0; i < MASK_BYTES; ++i) mask |= uint32_t{in[i]} << (8 * i);
+    if (mask & ~ALL_CHANNELS) return 0;   // not a frame of this schema
+
+    const std::size_t frameSize = sizeFor(mask);
+    if (size < frameSize) return 0;
+
+    BitReader reader(in + MASK_BYTES);
+    forEachChannel(data, [&](const TelemetryChannel& channel, std::size_t index, auto& value) {
+        using T = std::remove_reference_t<decltype(value)>;
+        if (mask & (1u << index)) value = fromCount<T>(channel, reader.read(channel.bits));
+    });
+    return frameSize;
+}
+
+
+std::size_t TelemetryFrameEncoder::encode(const TelemetryData& data, uint8_t* out, bool force) {
+    uint32_t mask = force ? TelemetryFrame::ALL_CHANNELS : 1u << static_cast<std::size_t>(TelemetryChannelId::time);
+    for (std::size_t i = 0; i < TELEMETRY_CHANNEL_COUNT; ++i) {
+        const double period = 1.0 / TELEMETRY_SCHEMA[i].rate;
+        if (!started || data.time >= nextDue[i] - 1e-6) {
+            mask |= 1u << i;
+            // Keep the cadence when samples arrive on time, restart it after a gap
+            nextDue[i] = (started && data.time < nextDue[i] + period) ? nextDue[i] + period : data.time + period;
+        }
+    }
+    started = true;
+    return TelemetryFrame::encode(data, mask, out);
+}
+
+
+
+/**
+==========================================
+    Text / CSV Formatting
+==========================================
+*/
+std::string formatTelemetryText(const TelemetryData& data, uint32_t mask) {
+    std::string text;
+    forEachChannel(data, [&](const TelemetryChannel& channel, std::size_t index, const auto& value) {
+        if (!(mask & (1u << index))) return;
+        if (!text.empty()) text += " | ";
+        text += channel.label;
+        text += ": ";
+        text += valueText(value, 6);
+        if (channel.unit[0]) {
+            text += ' ';
+            text += channel.unit;
+        }
+    });
+    return text;
+}
+
+
+std::string telemetryCsvHeader() {
+    std::string header;
+    for (const TelemetryChannel& channel : TELEMETRY_SCHEMA) {
+        if (!header.empty()) header += ',';
+        header += channel.name;
+        if (channel.unit[0]) {
+            header += '_';
+            // "m/s" -> "mps" keeps the column names identifier-safe
+            for (const char* c = channel.unit; *c; ++c) header += *c == '/' ? 'p' : *c;
+        }
+    }
+    return header;
+}
+
+
+std::string formatTelemetryCsv(const TelemetryData& data) {
+    std::string row;
+    forEachChannel(data, [&](const TelemetryChannel&, std::size_t index, const auto& value) {
+        if (index) row += ',';
+        row += valueText(value, 12);   // enough digits for the finest fixed-point step
+    });
+    return row;
+}
@@ -0,0 +1,158 @@
+#ifndef TELEMETRY_SCHEMA_H
+#define TELEMETRY_SCHEMA_H
+
+#include "mission_phase.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <type_traits>
+
+
+
+/**
+==========================================
+    Telemetry Channel Schema
+==========================================
+
+- One row per channel; everything else (TelemetryData, the channel table, packed frames, text / CSV
+  formatting) is generated from this list at compile time, so a new channel is one line here.
+- Columns: field, C++ type, label (console / text log), unit, fixed-point scale (value per count),
+  packed width in bits, signed, downlink rate (Hz).
+- Packed values are round(value / scale) in `bits` bits (two's complement when signed), saturated at
+  the ends of the range. Enum channels pack their underlying value.
+*/
+#define TELEMETRY_CHANNELS(X) \
+    /* field        type          label        unit    scale   bits  signed  rate */ \
+    X(time,         double,       "Time",      "s",    1e-3,   40,   false,  10.0) \
+    X(altitude,     double,       "Altitude",  "m",    1e-2,   32,   true,   10.0) \
+    X(velocity,     double,       "Velocity",  "m/s",  1e-3,   26,   true,   10.0) \
+    X(fuel,         double,       "Fuel",      "kg",   1e-2,   28,   false,  2.0)  \
+    X(thrust,       double,       "Thrust",    "N",    1.0,    26,   true,   10.0) \
+    X(deltaV,       double,       "Delta-V",   "m/s",  1e-3,   28,   true,   1.0)  \
+    X(dragForce,    double,       "Drag",      "N",    1.0,    28,   true,   5.0)  \
+    X(heatFlux,     double,       "Heat Flux", "W/m2", 10.0,   24,   false,  10.0) \
+    X(heatLoad,     double,       "Heat Load", "J/m2", 1e3,    24,   false,  1.0)  \
+    X(phase,        MissionPhase, "Phase",     "",     1.0,    4,    false,  10.0)
+
+
+// One telemetry sample (generated from the schema)
+struct TelemetryData {
+#define TELEMETRY_FIELD(field, type, ...) type field{};
+    TELEMETRY_CHANNELS(TELEMETRY_FIELD)
+#undef TELEMETRY_FIELD
+};
+
+
+enum class TelemetryChannelId : std::size_t {
+#define TELEMETRY_ID(field, ...) field,
+    TELEMETRY_CHANNELS(TELEMETRY_ID)
+#undef TELEMETRY_ID
+};
+
+struct TelemetryChannel {
+    const char* name;
+    const char* label;
+    const char* unit;
+    double scale;
+    unsigned bits;
+    bool isSigned;
+    double rate;        // Hz
+};
+
+inline constexpr TelemetryChannel TELEMETRY_SCHEMA[] = {
+#define TELEMETRY_ROW(field, type, label, unit, scale, bits, isSigned, rate) {#field, label, unit, scale, bits, isSigned, rate},
+    TELEMETRY_CHANNELS(TELEMETRY_ROW)
+#undef TELEMETRY_ROW
+};
+
+inline constexpr std::size_t TELEMETRY_CHANNEL_COUNT = sizeof(TELEMETRY_SCHEMA) / sizeof(TELEMETRY_SCHEMA[0]);
+
+// Bits of one frame with every channel present (presence mask excluded)
+inline constexpr std::size_t TELEMETRY_FULL_BITS = 0
+#define TELEMETRY_BITS(field, type, label, unit, scale, bits, ...) + bits
+    TELEMETRY_CHANNELS(TELEMETRY_BITS)
+#undef TELEMETRY_BITS
+    ;
+
+static_assert(TELEMETRY_CHANNEL_COUNT <= 32, "presence mask is a uint32_t");
+#define TELEMETRY_CHECK(field, type, label, unit, scale, bits, ...) \
+    static_assert(bits >= 1 && bits <= 56, "channel " #field ": packed width must fit the 64-bit bit writer"); \
+    static_assert(std::is_arithmetic_v<type> || std::is_enum_v<type>, "channel " #field ": arithmetic or enum type");
+TELEMETRY_CHANNELS(TELEMETRY_CHECK)
+#undef TELEMETRY_CHECK
+
+
+/**
+ * @brief Calls f(channel, index, field) for every channel in schema order
+ * - Unrolled at compile time; `field` is a reference to the member itself (const if `data` is const).
+ */
+template<typename Data, typename F>
+inline void forEachChannel(Data& data, F&& f) {
+    static_assert(std::is_same_v<std::remove_const_t<Data>, TelemetryData>, "forEachChannel takes TelemetryData");
+#define TELEMETRY_VISIT(field, ...) \
+    f(TELEMETRY_SCHEMA[static_cast<std::size_t>(TelemetryChannelId::field)], static_cast<std::size_t>(TelemetryChannelId::field), data.field);
+    TELEMETRY_CHANNELS(TELEMETRY_VISIT)
+#undef TELEMETRY_VISIT
+}
+
+
+
+/**
+==========================================
+    Packed Telemetry Frames
+==========================================
+
+Frame = presence mask (one bit per channel, MASK_BYTES) + the present channels' fixed-point values,
+bit-packed LSB first in schema order and padded to a byte. The size follows from the mask, so frames
+need no length prefix. A full frame is TELEMETRY_FULL_BITS / 8 + MASK_BYTES bytes against 8 bytes per
+channel as raw doubles.
+*/
+namespace TelemetryFrame {
+    constexpr std::size_t MASK_BYTES = (TELEMETRY_CHANNEL_COUNT + 7) / 8;
+    constexpr std::size_t MAX_BYTES = MASK_BYTES + (TELEMETRY_FULL_BITS + 7) / 8;
+    constexpr uint32_t ALL_CHANNELS = TELEMETRY_CHANNEL_COUNT == 32 ? 0xFFFFFFFFu : (1u << TELEMETRY_CHANNEL_COUNT) - 1u;
+
+    // Packs the channels in `mask` into out[0, MAX_BYTES); returns the frame size in bytes
+    std::size_t encode(const TelemetryData& data, uint32_t mask, uint8_t* out);
+
+    // Unpacks one frame into `data` (channels absent from the frame keep their value); returns the bytes
+    // consumed, 0 if `size` is shorter than the frame
+    std::size_t decode(const uint8_t* in, std::size_t size, TelemetryData& data);
+
+    std::size_t sizeFor(uint32_t mask);
+}
+
+
+/**
+ * @brief Rate-limited frame source for the telemetry log / downlink
+ * - Each channel goes out when its 1 / rate period has elapsed in sample time (time is always sent);
+ *   the first frame carries every channel.
+ * - `force` sends every channel (event stops and phase changes fall between the rate slots) without
+ *   moving the channels' cadence.
+ */
+class TelemetryFrameEncoder {
+private:
+    std::array<double, TELEMETRY_CHANNEL_COUNT> nextDue{};
+    bool started = false;
+
+public:
+    std::size_t encode(const TelemetryData& data, uint8_t* out, bool force = false);
+    void reset() { started = false; }
+};
+
+
+// "Time: 1.2 s | Altitude: 3.4 m | ... | Phase: Liftoff" for the channels in `mask`, schema order
+std::string formatTelemetryText(const TelemetryData& data, uint32_t mask = TelemetryFrame::ALL_CHANNELS);
+// "time_s,altitude_m,..." and the matching row (phase by name)
+std::string telemetryCsvHeader();
+std::string formatTelemetryCsv(const TelemetryData& data);
+
+constexpr uint32_t telemetryMask(std::initializer_list<TelemetryChannelId> channels) {
+    uint32_t mask = 0;
+    for (TelemetryChannelId id : channels) mask |= 1u << static_cast<std::size_t>(id);
+    return mask;
+}
+
+#endif
@@ -0,0 +1,393 @@
+#include "telemetry_server.h"
+#include <openssl/evp.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+
+namespace {
+
+const char* WEBSOCKET_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+const char* INDEX_PAGE =
+    "<!DOCTYPE html><html><head><title>OpenSpaceFSW Telemetry</title></head>"
+    "<body style=\"font-family:monospace\"><h3>OpenSpaceFSW Live Telemetry</h3><pre id=\"out\"></pre>"
+    "<script>const ws=new WebSocket('ws://'+location.host+'/live');"
+    "ws.onmessage=e=>{const d=JSON.parse(e.data);const n=d.t.length-1;if(n<0)return;"
+    "let s='T+'+d.t[n].toFixed(1)+'s\\n';for(const k in d)if(k!=='t')s+=k+': '+d[k][n].toFixed(2)+'\\n';"
+    "document.getElementById('out').textContent=s;};</script></body></html>";
+
+
+// Value of `key` in a "a=1&b=2" query string ("" if absent)
+std::string queryParam(const std::string& query, const std::string& key) {
+    std::size_t pos = 0;
+    while (pos < query.size()) {
+        std::size_t amp = query.find('&', pos);
+        std::string pair = query.substr(pos, amp == std::string::npos ? std::string::npos : amp - pos);
+        std::size_t eq = pair.find('=');
+        if (eq != std::string::npos && pair.compare(0, eq, key) == 0) {
+            return pair.substr(eq + 1);
+        }
+        if (amp == std::string::npos) break;
+        pos = amp + 1;
+    }
+    return "";
+}
+
+
+// Value of an HTTP header (case-insensitive name match)
+std::string headerValue(const std::string& request, const std::string& name) {
+    std::string lowerRequest = request, lowerName = name;
+    std::transform(lowerRequest.begin(), lowerRequest.end(), lowerRequest.begin(), ::tolower);
+    std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+
+    std::size_t pos = lowerRequest.find("\r\n" + lowerName + ":");
+    if (pos == std::string::npos) return "";
+    pos += lowerName.size() + 3;
+    std::size_t end = request.find("\r\n", pos);
+    std::string value = request.substr(pos, end - pos);
+    value.erase(0, value.find_first_not_of(' '));
+    value.erase(value.find_last_not_of(' ') + 1);
+    return value;
+}
+
+
+std::string httpResponse(const std::string& status, const std::string& type, const std::string& body) {
+    std::ostringstream response;
+    response << "HTTP/1.1 " << status << "\r\n"
+             << "Content-Type: " << type << "\r\n"
+             << "Content-Length: " << body.size() << "\r\n"
+             << "Connection: close\r\n\r\n"
+             << body;
+    return response.str();
+}
+
+}  // namespace
+
+
+
+TelemetryServer::~TelemetryServer() {
+    stop();
+}
+
+
+
+/**
+==========================================
+    Start / Stop
+==========================================
+*/
+bool TelemetryServer::start(uint16_t listenPort) {
+    if (running) return true;
+
+    listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        std::cerr << "[TELEMETRY SERVER ERROR] Could not create socket.\n";
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(listenPort);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);  // localhost only
+
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listenFd, 8) != 0) {
+        std::cerr << "[TELEMETRY SERVER ERROR] Could not listen on 127.0.0.1:" << listenPort << "\n";
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+
+    port = listenPort;
+    running = true;
+    worker = std::thread(&TelemetryServer::serve, this);
+    std::cout << "[TELEMETRY SERVER] Dashboard at http://127.0.0.1:" << port << "/\n";
+    return true;
+}
+
+
+void TelemetryServer::stop() {
+    if (!running.exchange(false)) return;
+
+    if (worker.joinable()) worker.join();
+    for (int fd : liveClients) close(fd);
+    liveClients.clear();
+    if (listenFd >= 0) close(listenFd);
+    listenFd = -1;
+}
+
+
+
+/**
+==========================================
+    Server Thread
+==========================================
+
+Everything below runs on the server thread only - the pyramids and client list need no locks.
+*/
+void TelemetryServer::serve() {
+    std::vector<pollfd> fds;
+
+    while (running) {
+        fds.clear();
+        fds.push_back({listenFd, POLLIN, 0});
+        for (int fd : liveClients) fds.push_back({fd, POLLIN, 0});
+
+        ::poll(fds.data(), fds.size(), 20);
+
+        if (fds[0].revents & POLLIN) {
+            int client = accept(listenFd, nullptr, nullptr);
+            if (client >= 0) handleConnection(client);
+        }
+
+        // Live clients only send control frames; any data, close or error drops the connection
+        for (std::size_t i = 1; i < fds.size(); ++i) {
+            if (!fds[i].revents) continue;
+
+            uint8_t frame[128];
+            ssize_t n = recv(fds[i].fd, frame, sizeof(frame), MSG_DONTWAIT);
+            bool closeFrame = n > 0 && (frame[0] & 0x0F) == 0x8;
+            if (n <= 0 || closeFrame) {
+                close(fds[i].fd);
+                liveClients.erase(std::remove(liveClients.begin(), liveClients.end(), fds[i].fd), liveClients.end());
+            }
+        }
+
+        drainQueue();
+    }
+}
+
+
+
+/**
+ * Moves every queued sample into the pyramids and pushes the batch to WebSocket clients
+ * as one column-oriented JSON frame: {"t":[...],"altitude":[...],...}
+ */
+void TelemetryServer::drainQueue() {
+    DashboardSample sample;
+    std::vector<DashboardSample> batch;
+
+    while (queue.pop(sample)) {
+        for (std::size_t c = 0; c < DASHBOARD_CHANNEL_COUNT; ++c) {
+            pyramids[c].append(sample.time, sample.values[c]);
+        }
+        if (!liveClients.empty()) batch.push_back(sample);
+    }
+
+    if (batch.empty()) return;
+
+    std::ostringstream json;
+    json << "{\"t\":[";
+    for (std::size_t i = 0; i < batch.size(); ++i) json << (i ? "," : "") << batch[i].time;
+    json << "]";
+    for (std::size_t c = 0; c < DASHBOARD_CHANNEL_COUNT; ++c) {
+        json << ",\"" << DASHBOARD_CHANNELS[c] << "\":[";
+        for (std::size_t i = 0; i < batch.size(); ++i) json << (i ? "," : "") << batch[i].values[c];
+        json << "]";
+    }
+    json << "}";
+
+    std::string frame = webSocketFrame(json.str());
+    for (auto it = liveClients.begin(); it != liveClients.end();) {
+        if (sendAll(*it, frame)) {
+            ++it;
+        } else {
+            close(*it);  // slow or gone - never let a client back up the server
+            it = liveClients.erase(it);
+        }
+    }
+}
+
+
+
+// Reads one request (bounded wait so a stalled client cannot hold the server thread)
+void TelemetryServer::handleConnection(int fd) {
+    timeval timeout{0, 200000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    std::string request;
+    char buffer[2048];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < 16384) {
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) break;
+        request.append(buffer, static_cast<std::size_t>(n));
+    }
+
+    if (request.find("\r\n\r\n") == std::string::npos) {
+        close(fd);
+        return;
+    }
+    handleRequest(fd, request);
+}
+
+
+
+void TelemetryServer::handleRequest(int fd, const std::string& request) {
+    std::istringstream line(request.substr(0, request.find("\r\n")));
+    std::string method, target;
+    line >> method >> target;
+
+    std::size_t question = target.find('?');
+    std::string path = target.substr(0, question);
+    std::string query = (question == std::string::npos) ? "" : target.substr(question + 1);
+
+    if (!isLocalHost(headerValue(request, "Host"))) {
+        sendAll(fd, httpResponse("403 Forbidden", "text/plain", "Unexpected Host\n"));
+    } else if (method != "GET") {
+        sendAll(fd, httpResponse("405 Method Not Allowed", "text/plain", "GET only\n"));
+    } else if (path == "/live") {
+        std::string origin = headerValue(request, "Origin");
+        if (!origin.empty() && !isLocalOrigin(origin)) {
+            sendAll(fd, httpResponse("403 Forbidden", "text/plain", "Cross-origin WebSocket refused\n"));
+        } else if (upgradeToWebSocket(fd, request)) {
+            liveClients.push_back(fd);
+            return;  // keep the connection open
+        }
+        sendAll(fd, httpResponse("400 Bad Request", "text/plain", "WebSocket upgrade required\n"));
+    } else if (path == "/api/channels") {
+        std::string body = "[";
+        for (std::size_t c = 0; c < DASHBOARD_CHANNEL_COUNT; ++c) {
+            body += std::string(c ? "," : "") + "\"" + DASHBOARD_CHANNELS[c] + "\"";
+        }
+        sendAll(fd, httpResponse("200 OK", "application/json", body + "]"));
+    } else if (path == "/api/series") {
+        std::string body = seriesJson(query);
+        if (body.empty()) {
+            sendAll(fd, httpResponse("404 Not Found", "text/plain", "Unknown channel\n"));
+        } else {
+            sendAll(fd, httpResponse("200 OK", "application/json", body));
+        }
+    } else if (path == "/") {
+        sendAll(fd, httpResponse("200 OK", "text/html", INDEX_PAGE));
+    } else {
+        sendAll(fd, httpResponse("404 Not Found", "text/plain", "Not found\n"));
+    }
+
+    close(fd);
+}
+
+
+
+/**
+ * Only the dashboard's own pages may read the telemetry: responses carry no CORS header, so browsers keep
+ * other origins from reading them, and the checks below close the two ways around that. A page served under
+ * another name that resolves to 127.0.0.1 (DNS rebinding) sends its own Host; a cross-origin WebSocket
+ * (not covered by CORS) sends its page's Origin. Clients outside a browser send no Origin and are accepted.
+ */
+bool TelemetryServer::isLocalHost(const std::string& host) const {
+    const std::string suffix = ":" + std::to_string(port);
+    return host == "127.0.0.1" + suffix || host == "localhost" + suffix;
+}
+
+bool TelemetryServer::isLocalOrigin(const std::string& origin) const {
+    const std::string prefix = "http://";
+    return origin.compare(0, prefix.size(), prefix) == 0 && isLocalHost(origin.substr(prefix.size()));
+}
+
+
+
+/**
+ * {"channel":"altitude","level":3,"points":[[t0,t1,min,max,mean],...]}
+ * `points` is the client's horizontal resolution; the pyramid picks the matching level.
+ */
+std::string TelemetryServer::seriesJson(const std::string& query) const {
+    std::string channel = queryParam(query, "channel");
+    auto it = std::find_if(std::begin(DASHBOARD_CHANNELS), std::end(DASHBOARD_CHANNELS),
+                           [&](const char* name) { return channel == name; });
+    if (it == std::end(DASHBOARD_CHANNELS)) return "";
+
+    const DownsamplePyramid& pyramid = pyramids[it - std::begin(DASHBOARD_CHANNELS)];
+
+    std::string fromText = queryParam(query, "from"), toText = queryParam(query, "to"), pointsText = queryParam(query, "points");
+    double from = fromText.empty() ? 0.0 : std::atof(fromText.c_str());
+    double to = toText.empty() ? 1e18 : std::atof(toText.c_str());
+    std::size_t points = pointsText.empty() ? 500 : std::clamp<std::size_t>(std::strtoul(pointsText.c_str(), nullptr, 10), 1, 10000);
+
+    std::size_t level = 0;
+    std::vector<SeriesBucket> buckets = (queryParam(query, "mode") == "lttb")
+        ? pyramid.queryLttb(from, to, points)
+        : pyramid.query(from, to, points, &level);
+
+    std::ostringstream json;
+    json << "{\"channel\":\"" << channel << "\",\"level\":" << level << ",\"points\":[";
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        const SeriesBucket& b = buckets[i];
+        json << (i ? "," : "") << "[" << b.t0 << "," << b.t1 << "," << b.min << "," << b.max << "," << b.mean() << "]";
+    }
+    json << "]}";
+    return json.str();
+}
+
+
+
+/**
+==========================================
+    WebSocket (RFC 6455) - Handshake & Server Frames
+==========================================
+*/
+bool TelemetryServer::upgradeToWebSocket(int fd, const std::string& request) {
+    std::string key = headerValue(request, "Sec-WebSocket-Key");
+    if (key.empty()) return false;
+
+    std::string accept = key + WEBSOCKET_GUID;
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int digestLength = 0;
+    if (EVP_Digest(accept.data(), accept.size(), digest, &digestLength, EVP_sha1(), nullptr) != 1) {
+        return false;
+    }
+
+    unsigned char encoded[64];
+    int encodedLength = EVP_EncodeBlock(encoded, digest, static_cast<int>(digestLength));
+
+    std::string response =
+        "HTTP/1.1 101 Switching Protocols\r\n"
+        "Upgrade: websocket\r\n"
+        "Connection: Upgrade\r\n"
+        "Sec-WebSocket-Accept: " + std::string(reinterpret_cast<char*>(encoded), encodedLength) + "\r\n\r\n";
+    return sendAll(fd, response);
+}
+
+
+// Unmasked text frame (server -> client)
+std::string TelemetryServer::webSocketFrame(const std::string& payload) {
+    std::string frame;
+    frame.push_back(static_cast<char>(0x81));  // FIN + text
+
+    std::size_t length = payload.size();
+    if (length < 126) {
+        frame.push_back(static_cast<char>(length));
+    } else if (length <= 0xFFFF) {
+        frame.push_back(static_cast<char>(126));
+        frame.push_back(static_cast<char>((length >> 8) & 0xFF));
+        frame.push_back(static_cast<char>(length & 0xFF));
+    } else {
+        frame.push_back(static_cast<char>(127));
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            frame.push_back(static_cast<char>((static_cast<uint64_t>(length) >> shift) & 0xFF));
+        }
+    }
+    return frame + payload;
+}
+
+
+bool TelemetryServer::sendAll(int fd, const std::string& data) {
+    std::size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        sent += static_cast<std::size_t>(n);
+    }
+    return true;
+}
@@ -0,0 +1,122 @@
+#ifndef TELEMETRY_SERVER_H
+#define TELEMETRY_SERVER_H
+
+#include "downsampler.h"
+#include "spsc_queue.h"
+#include "telemetry_schema.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+// Channels served to the dashboard, generated from the telemetry schema: every floating-point channel
+// except time (which every sample carries anyway). Index = position in every sample.
+inline constexpr bool DASHBOARD_SERVED[] = {
+#define DASHBOARD_ROW(field, type, ...) std::is_floating_point_v<type> && TelemetryChannelId::field != TelemetryChannelId::time,
+    TELEMETRY_CHANNELS(DASHBOARD_ROW)
+#undef DASHBOARD_ROW
+};
+
+inline constexpr std::size_t DASHBOARD_CHANNEL_COUNT = [] {
+    std::size_t count = 0;
+    for (bool served : DASHBOARD_SERVED) count += served;
+    return count;
+}();
+
+inline constexpr std::array<const char*, DASHBOARD_CHANNEL_COUNT> DASHBOARD_CHANNELS = [] {
+    std::array<const char*, DASHBOARD_CHANNEL_COUNT> names{};
+    std::size_t c = 0;
+    for (std::size_t i = 0; i < TELEMETRY_CHANNEL_COUNT; ++i) {
+        if (DASHBOARD_SERVED[i]) names[c++] = TELEMETRY_SCHEMA[i].name;
+    }
+    return names;
+}();
+
+
+// One telemetry sample as handed over by the flight thread
+struct DashboardSample {
+    double time;
+    std::array<double, DASHBOARD_CHANNEL_COUNT> values;
+
+    // The served channels of `data`, in DASHBOARD_CHANNELS order
+    static DashboardSample from(double time, const TelemetryData& data) {
+        DashboardSample sample{time, {}};
+        std::size_t c = 0;
+        forEachChannel(data, [&sample, &c](const TelemetryChannel&, std::size_t index, const auto& value) {
+            if constexpr (std::is_floating_point_v<std::decay_t<decltype(value)>>) {
+                if (DASHBOARD_SERVED[index]) sample.values[c++] = value;
+            }
+        });
+        return sample;
+    }
+};
+
+
+
+/**
+==========================================
+    Telemetry Dashboard Server (localhost HTTP + WebSocket)
+==========================================
+
+- The flight thread only calls publish(): one push into a lock-free queue, never blocks, never does I/O.
+- A single server thread drains the queue, maintains a DownsamplePyramid per channel, answers HTTP
+  range queries at a zoom-appropriate resolution and pushes live deltas to WebSocket clients.
+- Binds to 127.0.0.1 only; no CORS, and requests for another Host or WebSocket upgrades from another
+  Origin are refused, so a page from elsewhere open in the operator's browser cannot read the telemetry.
+
+Endpoints:
+    GET /                                                   minimal live view
+    GET /api/channels                                       channel list
+    GET /api/series?channel=altitude&from=0&to=600&points=500[&mode=lttb]
+    GET /live                                               WebSocket, one JSON frame per batch of new samples
+*/
+class TelemetryServer {
+public:
+    static constexpr std::size_t QUEUE_CAPACITY = 1024;
+
+private:
+    SpscQueue<DashboardSample, QUEUE_CAPACITY> queue;
+    std::atomic<uint64_t> dropped{0};
+
+    std::thread worker;
+    std::atomic<bool> running{false};
+    int listenFd = -1;
+    uint16_t port = 0;
+
+    // Server-thread state
+    std::array<DownsamplePyramid, DASHBOARD_CHANNEL_COUNT> pyramids;
+    std::vector<int> liveClients;      // upgraded WebSocket connections
+
+    void serve();
+    void drainQueue();
+    void handleConnection(int fd);
+    void handleRequest(int fd, const std::string& request);
+    std::string seriesJson(const std::string& query) const;
+    bool upgradeToWebSocket(int fd, const std::string& request);
+    bool isLocalHost(const std::string& host) const;       // Host header names this server
+    bool isLocalOrigin(const std::string& origin) const;   // a page served by this server
+    static bool sendAll(int fd, const std::string& data);
+    static std::string webSocketFrame(const std::string& payload);
+
+public:
+    TelemetryServer() = default;
+    ~TelemetryServer();
+    TelemetryServer(const TelemetryServer&) = delete;
+    TelemetryServer& operator=(const TelemetryServer&) = delete;
+
+    bool start(uint16_t listenPort);
+    void stop();
+
+    // Flight thread: O(1), lock-free; samples are dropped (and counted) if the server falls behind
+    void publish(const DashboardSample& sample) {
+        if (!queue.push(sample)) dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+};
+
+#endif